@@ -32,6 +32,7 @@
 #include "yb/util/enums.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
+#include "yb/util/strongly_typed_bool.h"
 #include "yb/master/master_replication.pb.h"
 #include "yb/gutil/thread_annotations.h"
 
@@ -47,6 +48,7 @@ using EnumLabelCache = std::unordered_map<NamespaceName, EnumOidLabelMap>;
 using CompositeAttsMap = std::unordered_map<uint32_t, std::vector<master::PgAttributePB>>;
 using CompositeTypeCache = std::unordered_map<NamespaceName, CompositeAttsMap>;
 YB_DEFINE_ENUM(RefreshStreamMapOption, (kNone)(kAlways)(kIfInitiatedState));
+YB_STRONGLY_TYPED_BOOL(BulkSnapshot);
 
 struct SchemaDetails {
   SchemaVersion schema_version;
@@ -134,7 +136,8 @@ Status GetChangesForCDCSDK(
     OpId* last_streamed_op_id,
     int64_t* last_readable_opid_index = nullptr,
     const TableId& colocated_table_id = "",
-    const CoarseTimePoint deadline = CoarseTimePoint::max());
+    const CoarseTimePoint deadline = CoarseTimePoint::max(),
+    BulkSnapshot bulk_snapshot = BulkSnapshot::kFalse);
 
 using UpdateOnSplitOpFunc = std::function<Status(const consensus::ReplicateMsg&)>;
 
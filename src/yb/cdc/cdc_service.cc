@@ -58,6 +58,7 @@
 #include "yb/master/master_ddl.pb.h"
 #include "yb/master/master_defaults.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_context.h"
 #include "yb/rpc/rpc_controller.h"
 
@@ -156,6 +157,11 @@ DEFINE_UNKNOWN_int32(wait_replication_drain_tserver_retry_interval_ms, 100,
     "Time in microseconds that a tserver will sleep between each iteration of polling "
     "its tablets until the tablets are all caught-up in the replication.");
 
+DEFINE_RUNTIME_uint32(cdc_get_changes_max_wait_ms, 1000,
+    "Max time GetChanges waits for new committed changes when the caller asks it to, by setting "
+    "wait_for_changes_ms. The request does not occupy a CDC service thread while waiting. "
+    "0 to never wait.");
+
 DEFINE_test_flag(bool, block_get_changes, false,
     "For testing only. When set to true, GetChanges will not send any new changes "
     "to the consumer.");
@@ -1502,8 +1508,70 @@ bool CDCServiceImpl::IsReplicationPausedForStream(const std::string& stream_id)
   return paused_xcluster_producer_streams_.contains(stream_id);
 }
 
+namespace {
+
+// GetChanges request suspended until new changes are committed.
+struct SuspendedGetChanges {
+  const GetChangesRequestPB* req;
+  GetChangesResponsePB* resp;
+  RpcContext context;
+
+  ~SuspendedGetChanges() {
+    // The request was not resumed, for instance because the thread pool is shutting down.
+    if (context && !context.responded()) {
+      SetupErrorAndRespond(
+          resp->mutable_error(),
+          STATUS(Aborted, "GetChanges was aborted while waiting for changes"),
+          CDCErrorPB::INTERNAL_ERROR, &context);
+    }
+  }
+};
+
+} // namespace
+
 void CDCServiceImpl::GetChanges(
     const GetChangesRequestPB* req, GetChangesResponsePB* resp, RpcContext context) {
+  DoGetChanges(req, resp, std::move(context), /* wait_for_changes= */ true);
+}
+
+bool CDCServiceImpl::SuspendGetChanges(
+    const GetChangesRequestPB* req, GetChangesResponsePB* resp, RpcContext* context,
+    const std::shared_ptr<consensus::Consensus>& consensus, int64_t index,
+    CoarseTimePoint deadline) {
+  auto suspended = std::make_shared<SuspendedGetChanges>(SuspendedGetChanges {
+    .req = req,
+    .resp = resp,
+    .context = std::move(*context),
+  });
+  // Leadership is checked again by the resumed request, so the status of the wait is ignored.
+  auto resume = [this, suspended](const Status&) {
+    client()->messenger()->ThreadPool().EnqueueFunctor([this, suspended] {
+      DoGetChanges(
+          suspended->req, suspended->resp, std::move(suspended->context),
+          /* wait_for_changes= */ false);
+    });
+  };
+  auto waiter_id = consensus->RegisterCommittedOpIdWaiter(index, resume);
+  if (!waiter_id) {
+    *context = std::move(suspended->context);
+    return false;
+  }
+  // The waiter is invoked at most once, so the request is resumed either by it or by the timer,
+  // whichever removes it first.
+  client()->messenger()->scheduler().Schedule(
+      [consensus, waiter_id, resume](const Status& status) {
+        if (consensus->RemoveCommittedOpIdWaiter(waiter_id)) {
+          resume(status);
+        }
+      },
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          deadline - CoarseMonoClock::Now()));
+  return true;
+}
+
+void CDCServiceImpl::DoGetChanges(
+    const GetChangesRequestPB* req, GetChangesResponsePB* resp, RpcContext context,
+    bool wait_for_changes) {
   RPC_CHECK_AND_RETURN_ERROR(
       get_changes_rpc_sem_.TryAcquire(), STATUS(LeaderNotReadyToServe, "Not ready to serve"),
       resp->mutable_error(), CDCErrorPB::LEADER_NOT_READY, context);
@@ -1686,6 +1754,24 @@ void CDCServiceImpl::GetChanges(
     get_changes_deadline = ToCoarse(MonoTime::FromUint64(safe_deadline.time_since_epoch().count()));
   }
 
+  // Long poll: wait for new committed operations instead of making the caller poll again.
+  const auto wait_for_changes_ms =
+      std::min(req->wait_for_changes_ms(), GetAtomicFlag(&FLAGS_cdc_get_changes_max_wait_ms));
+  if (wait_for_changes && wait_for_changes_ms > 0 &&
+      (record.source_type == XCLUSTER || cdc_sdk_from_op_id.write_id() != -1)) {
+    auto consensus = tablet_peer->shared_consensus();
+    if (consensus) {
+      const auto index =
+          record.source_type == XCLUSTER ? from_op_id.index : cdc_sdk_from_op_id.index();
+      if (SuspendGetChanges(
+              req, resp, &context, consensus, index,
+              std::min(get_changes_deadline,
+                       CoarseMonoClock::Now() + wait_for_changes_ms * 1ms))) {
+        return;
+      }
+    }
+  }
+
   bool report_tablet_split = false;
   // Read the latest changes from the Log.
   if (record.source_type == XCLUSTER) {
@@ -1727,7 +1813,8 @@ void CDCServiceImpl::GetChanges(
         req->stream_id(), req->tablet_id(), cdc_sdk_from_op_id, record, tablet_peer, mem_tracker,
         *enum_map_result, *composite_atts_map, client(), &msgs_holder, resp, &commit_timestamp,
         &cached_schema_details, &last_streamed_op_id, &last_readable_index,
-        tablet_peer->tablet_metadata()->colocated() ? req->table_id() : "", get_changes_deadline);
+        tablet_peer->tablet_metadata()->colocated() ? req->table_id() : "", get_changes_deadline,
+        BulkSnapshot(req->bulk_snapshot()));
     // This specific error from the docdb_pgapi layer is used to identify enum cache entry is
     // out of date, hence we need to repopulate.
     if (status.IsCacheMissError()) {
@@ -1751,11 +1838,13 @@ void CDCServiceImpl::GetChanges(
       // Clean all the records which got added in the resp, till the enum cache miss failure is
       // encountered.
       resp->clear_cdc_sdk_proto_records();
+      resp->clear_bulk_snapshot_batch();
       status = GetChangesForCDCSDK(
           req->stream_id(), req->tablet_id(), cdc_sdk_from_op_id, record, tablet_peer, mem_tracker,
           *enum_map_result, *composite_atts_map, client(), &msgs_holder, resp, &commit_timestamp,
           &cached_schema_details, &last_streamed_op_id, &last_readable_index,
-          tablet_peer->tablet_metadata()->colocated() ? req->table_id() : "", get_changes_deadline);
+          tablet_peer->tablet_metadata()->colocated() ? req->table_id() : "", get_changes_deadline,
+          BulkSnapshot(req->bulk_snapshot()));
     }
     // This specific error indicates that a tablet split occured on the tablet.
     if (status.IsTabletSplit()) {
@@ -1803,6 +1892,9 @@ void CDCServiceImpl::GetChanges(
                        .row_message()
                        .commit_time()
                  : 0);
+  if (last_record_hybrid_time == 0 && !resp->bulk_snapshot_batch().rows().empty()) {
+    last_record_hybrid_time = resp->bulk_snapshot_batch().commit_time();
+  }
 
   if (record.checkpoint_type == IMPLICIT ||
       (record.checkpoint_type == EXPLICIT && got_explicit_checkpoint_from_request)) {
@@ -3983,6 +4075,9 @@ boost::optional<MicrosTime> GetCDCSDKLastSendRecordTime(const GetChangesResponse
     }
     cur_idx -= 1;
   }
+  if (!resp->bulk_snapshot_batch().rows().empty()) {
+    return HybridTime(resp->bulk_snapshot_batch().commit_time()).GetPhysicalValueMicros();
+  }
   return boost::optional<MicrosTime>{};
 }
 
@@ -4000,11 +4095,16 @@ void CDCServiceImpl::UpdateCDCTabletMetrics(
 
   if (source_type == CDCSDK) {
     auto tablet_metric = std::static_pointer_cast<CDCSDKTabletMetrics>(tablet_metric_row);
-    tablet_metric->cdcsdk_change_event_count->IncrementBy(resp->cdc_sdk_proto_records_size());
+    const auto& bulk_snapshot_batch = resp->bulk_snapshot_batch();
+    tablet_metric->cdcsdk_change_event_count->IncrementBy(
+        resp->cdc_sdk_proto_records_size() + bulk_snapshot_batch.rows_size());
     tablet_metric->cdcsdk_expiry_time_ms->set_value(GetAtomicFlag(&FLAGS_cdc_intent_retention_ms));
-    if (resp->cdc_sdk_proto_records_size() > 0) {
+    if (resp->cdc_sdk_proto_records_size() > 0 || !bulk_snapshot_batch.rows().empty()) {
       tablet_metric->cdcsdk_traffic_sent->IncrementBy(
-          resp->cdc_sdk_proto_records_size() * resp->cdc_sdk_proto_records(0).ByteSize());
+          (resp->cdc_sdk_proto_records_size() > 0
+               ? resp->cdc_sdk_proto_records_size() * resp->cdc_sdk_proto_records(0).ByteSize()
+               : 0) +
+          bulk_snapshot_batch.ByteSize());
       auto last_record_time = GetCDCSDKLastSendRecordTime(resp);
       auto last_record_micros =
           last_record_time
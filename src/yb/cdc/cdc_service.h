@@ -302,6 +302,20 @@ class CDCServiceImpl : public CDCServiceIf {
 
   Status CheckTabletValidForStream(const ProducerTabletInfo& producer_info);
 
+  // Implements GetChanges. When wait_for_changes is true, the request could be suspended until new
+  // changes are committed, after that it is processed again with wait_for_changes set to false.
+  void DoGetChanges(
+      const GetChangesRequestPB* req, GetChangesResponsePB* resp, rpc::RpcContext context,
+      bool wait_for_changes);
+
+  // Suspends GetChanges until an operation after index is committed or deadline passes, without
+  // occupying a service thread. Returns false and keeps the context when there is nothing to wait
+  // for.
+  bool SuspendGetChanges(
+      const GetChangesRequestPB* req, GetChangesResponsePB* resp, rpc::RpcContext* context,
+      const std::shared_ptr<consensus::Consensus>& consensus, int64_t index,
+      CoarseTimePoint deadline);
+
   void TabletLeaderGetChanges(
       const GetChangesRequestPB* req,
       GetChangesResponsePB* resp,
@@ -27,6 +27,7 @@
 #include "yb/dockv/doc_key.h"
 #include "yb/docdb/doc_reader.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/gutil/casts.h"
 #include "yb/server/hybrid_clock.h"
 
 #include "yb/master/master_client.pb.h"
@@ -34,13 +35,19 @@
 
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
 
 #include "yb/tablet/tablet_metadata.h"
 
 using std::string;
+using namespace yb::size_literals;
 
 DEFINE_RUNTIME_int32(cdc_snapshot_batch_size, 250, "Batch size for the snapshot operation in CDC");
 
+DEFINE_RUNTIME_int64(cdc_bulk_snapshot_batch_max_bytes, 16_MB,
+    "Max size of encoded records in a snapshot batch, when the snapshot is requested in bulk mode. "
+    "0 to use cdc_snapshot_batch_size for bulk snapshots as well.");
+
 DEFINE_RUNTIME_bool(stream_truncate_record, false, "Enable streaming of TRUNCATE record");
 
 DECLARE_int64(cdc_intent_retention_ms);
@@ -1228,6 +1235,24 @@ Status ProcessIntents(
   return Status::OK();
 }
 
+Status PopulateCDCSDKSnapshotDatum(
+    const qlexpr::QLTableRow& row,
+    ColumnId col_id,
+    const ColumnSchema& col_schema,
+    const EnumOidLabelMap& enum_oid_label_map,
+    const CompositeAttsMap& composite_atts_map,
+    DatumMessagePB* cdc_datum_message) {
+  const auto* value = row.GetColumn(col_id);
+  if (value && value->value_case() != QLValuePB::VALUE_NOT_SET &&
+      col_schema.pg_type_oid() != 0 /*kInvalidOid*/) {
+    return docdb::SetValueFromQLBinaryWrapper(
+        *value, col_schema.pg_type_oid(), enum_oid_label_map, composite_atts_map,
+        cdc_datum_message);
+  }
+  cdc_datum_message->set_column_type(col_schema.pg_type_oid());
+  return Status::OK();
+}
+
 Status PopulateCDCSDKSnapshotRecord(
     GetChangesResponsePB* resp,
     const qlexpr::QLTableRow* row,
@@ -1251,20 +1276,12 @@ Status PopulateCDCSDKSnapshotRecord(
 
   for (size_t col_idx = 0; col_idx < schema.num_columns(); col_idx++) {
     ColumnId col_id = schema.column_id(col_idx);
-    const auto* value = row->GetColumn(col_id);
     const ColumnSchema& col_schema = VERIFY_RESULT(schema.column_by_id(col_id));
 
     cdc_datum_message = row_message->add_new_tuple();
     cdc_datum_message->set_column_name(col_schema.name());
-
-    if (value && value->value_case() != QLValuePB::VALUE_NOT_SET &&
-        col_schema.pg_type_oid() != 0 /*kInvalidOid*/) {
-      RETURN_NOT_OK(docdb::SetValueFromQLBinaryWrapper(
-          *value, col_schema.pg_type_oid(), enum_oid_label_map, composite_atts_map,
-          cdc_datum_message));
-    } else {
-      cdc_datum_message->set_column_type(col_schema.pg_type_oid());
-    }
+    RETURN_NOT_OK(PopulateCDCSDKSnapshotDatum(
+        *row, col_id, col_schema, enum_oid_label_map, composite_atts_map, cdc_datum_message));
 
     row_message->add_old_tuple();
   }
@@ -1272,6 +1289,47 @@ Status PopulateCDCSDKSnapshotRecord(
   return Status::OK();
 }
 
+// Fills the header of a bulk snapshot batch, i.e. everything that is common for all its rows.
+Status InitCDCSDKBulkSnapshotBatch(
+    const Schema& schema,
+    const TableName& table_name,
+    ReadHybridTime time,
+    CDCSDKBulkSnapshotBatchPB* batch) {
+  batch->set_table(table_name);
+  batch->set_pgschema_name(schema.SchemaName());
+  batch->set_commit_time(time.read.ToUint64());
+  batch->mutable_columns()->Reserve(narrow_cast<int>(schema.num_columns()));
+  for (size_t col_idx = 0; col_idx < schema.num_columns(); col_idx++) {
+    const ColumnSchema& col_schema = VERIFY_RESULT(schema.column_by_id(schema.column_id(col_idx)));
+    auto* column = batch->add_columns();
+    column->set_name(col_schema.name());
+    column->set_oid(col_schema.pg_type_oid());
+  }
+  return Status::OK();
+}
+
+// Adds the row to the bulk snapshot batch as a list of column values, in the order of the batch
+// columns. Returns the encoded size of the row.
+Result<size_t> PopulateCDCSDKBulkSnapshotRow(
+    const qlexpr::QLTableRow& row,
+    const Schema& schema,
+    const EnumOidLabelMap& enum_oid_label_map,
+    const CompositeAttsMap& composite_atts_map,
+    CDCSDKBulkSnapshotBatchPB* batch) {
+  auto* row_pb = batch->add_rows();
+  row_pb->mutable_values()->Reserve(narrow_cast<int>(schema.num_columns()));
+  for (size_t col_idx = 0; col_idx < schema.num_columns(); col_idx++) {
+    ColumnId col_id = schema.column_id(col_idx);
+    const ColumnSchema& col_schema = VERIFY_RESULT(schema.column_by_id(col_id));
+    auto* cdc_datum_message = row_pb->add_values();
+    RETURN_NOT_OK(PopulateCDCSDKSnapshotDatum(
+        row, col_id, col_schema, enum_oid_label_map, composite_atts_map, cdc_datum_message));
+    // Column types are part of the batch header.
+    cdc_datum_message->clear_column_type();
+  }
+  return row_pb->ByteSizeLong();
+}
+
 Status PopulateCDCSDKSafepointOpRecord(
     const uint64_t timestamp, const string& table_name, CDCSDKProtoRecordPB* proto_record,
     const Schema& schema) {
@@ -1327,7 +1385,8 @@ Status GetChangesForCDCSDK(
     OpId* last_streamed_op_id,
     int64_t* last_readable_opid_index,
     const TableId& colocated_table_id,
-    const CoarseTimePoint deadline) {
+    const CoarseTimePoint deadline,
+    BulkSnapshot bulk_snapshot) {
   OpId op_id{from_op_id.term(), from_op_id.index()};
   VLOG(1) << "The from_op_id from GetChanges is  " << op_id << " for tablet_id: " << tablet_id;
   ScopedTrackedConsumption consumption;
@@ -1417,19 +1476,46 @@ Status GetChangesForCDCSDK(
         table_name = VERIFY_RESULT(GetColocatedTableName(tablet_peer, colocated_table_id));
       }
 
-      int limit = FLAGS_cdc_snapshot_batch_size;
+      // In bulk mode the batch is limited by the size of encoded rows and by the deadline, so
+      // that a single GetChanges call ships as much data as the RPC allows.
+      const int64_t max_batch_bytes =
+          bulk_snapshot ? GetAtomicFlag(&FLAGS_cdc_bulk_snapshot_batch_max_bytes) : 0;
+      int limit = max_batch_bytes > 0 ? std::numeric_limits<int>::max()
+                                      : FLAGS_cdc_snapshot_batch_size;
       int fetched = 0;
+      size_t batch_bytes = 0;
+      CDCSDKBulkSnapshotBatchPB* bulk_batch = nullptr;
+      if (bulk_snapshot) {
+        bulk_batch = resp->mutable_bulk_snapshot_batch();
+        RETURN_NOT_OK(InitCDCSDKBulkSnapshotBatch(
+            *schema_details.schema, table_name, time, bulk_batch));
+      }
       std::vector<qlexpr::QLTableRow> rows;
       qlexpr::QLTableRow row;
       dockv::ReaderProjection projection(*schema_details.schema);
       auto iter = VERIFY_RESULT(tablet_ptr->CreateCDCSnapshotIterator(
           projection, time, nextKey, colocated_table_id));
       while (fetched < limit && VERIFY_RESULT(iter->FetchNext(&row))) {
-        RETURN_NOT_OK(PopulateCDCSDKSnapshotRecord(
-            resp, &row, *schema_details.schema, table_name, time, enum_oid_label_map,
-            composite_atts_map));
         fetched++;
+        if (!bulk_batch) {
+          RETURN_NOT_OK(PopulateCDCSDKSnapshotRecord(
+              resp, &row, *schema_details.schema, table_name, time, enum_oid_label_map,
+              composite_atts_map));
+          continue;
+        }
+        batch_bytes += VERIFY_RESULT(PopulateCDCSDKBulkSnapshotRow(
+            row, *schema_details.schema, enum_oid_label_map, composite_atts_map, bulk_batch));
+        if (max_batch_bytes > 0 &&
+            (batch_bytes >= static_cast<size_t>(max_batch_bytes) ||
+             CoarseMonoClock::Now() >= deadline)) {
+          break;
+        }
+      }
+      if (bulk_batch && bulk_batch->rows().empty()) {
+        resp->clear_bulk_snapshot_batch();
       }
+      VLOG(1) << "Fetched " << fetched << " snapshot rows, " << batch_bytes << " bytes"
+              << (bulk_snapshot ? " in bulk mode" : "") << " for tablet_id: " << tablet_id;
       dockv::SubDocKey sub_doc_key;
       RETURN_NOT_OK(iter->GetNextReadSubDocKey(&sub_doc_key));
 
@@ -134,6 +134,20 @@ bool LocalTabletServerOnly(const InFlightOps& ops) {
           !FLAGS_forward_redis_requests);
 }
 
+// Whether the first attempt could be sent to the closest replica instead of the leader.
+// Non transactional strong reads of tables with follower read leases could be served by a follower
+// that holds a lease; otherwise the follower rejects the read and the retry goes to the leader.
+bool UseClosestReplica(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_level) {
+  if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    return true;
+  }
+  if (yb_consistency_level != YBConsistencyLevel::STRONG || data.batcher->transaction()) {
+    return false;
+  }
+  const auto& op = *data.ops.front().yb_op;
+  return op.read_only() && op.table()->schema().table_properties().follower_read_leases();
+}
+
 void FillRequestIds(const RetryableRequestId request_id,
                     const RetryableRequestId min_running_request_id,
                     InFlightOps* ops) {
@@ -175,7 +189,7 @@ AsyncRpc::AsyncRpc(
       batcher_(data.batcher),
       ops_(data.ops),
       tablet_invoker_(LocalTabletServerOnly(ops_),
-                      yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX,
+                      UseClosestReplica(data, yb_consistency_level),
                       data.batcher->client_,
                       this,
                       this,
@@ -0,0 +1,326 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/auto_flushing_session.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/rpc/messenger.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/status.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_max_delay_us, 500,
+    "Max time an operation could wait in the buffer of an auto flushing session before it is "
+    "flushed.");
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_max_in_flight_batches, 4,
+    "Max number of batches concurrently flushed by an auto flushing session.");
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_min_batch_size, 8,
+    "Min number of operations in a batch of an auto flushing session.");
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_max_batch_size, 1024,
+    "Max number of operations in a batch of an auto flushing session.");
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_max_buffered_ops, 100000,
+    "Max number of operations buffered by an auto flushing session. Operations applied while the "
+    "buffer is full are failed with Busy. 0 means no limit.");
+
+DEFINE_RUNTIME_uint32(ybclient_auto_flush_target_latency_us, 5000,
+    "Auto flushing session grows its batch size while batches are flushed within this time, and "
+    "shrinks it otherwise.");
+
+namespace yb {
+namespace client {
+
+namespace {
+
+size_t MaxInFlightBatches() {
+  return std::max<size_t>(FLAGS_ybclient_auto_flush_max_in_flight_batches, 1);
+}
+
+} // namespace
+
+AutoFlushingSession::AutoFlushingSession(YBClient* client, MonoDelta timeout)
+    : client_(client), timeout_(timeout),
+      batch_size_(std::max<size_t>(FLAGS_ybclient_auto_flush_min_batch_size, 1)) {
+}
+
+AutoFlushingSession::~AutoFlushingSession() {
+  Shutdown();
+}
+
+void AutoFlushingSession::Apply(YBOperationPtr op, StatusFunctor callback) {
+  std::string partition_key;
+  auto status = op->GetPartitionKey(&partition_key);
+  if (!status.ok()) {
+    if (callback) {
+      callback(status);
+    }
+    return;
+  }
+  auto key = op->table()->id() + partition_key;
+
+  Batches batches;
+  bool closing;
+  bool buffer_full = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing = closing_;
+    const auto max_buffered_ops = FLAGS_ybclient_auto_flush_max_buffered_ops;
+    buffer_full = max_buffered_ops != 0 && buffer_.size() >= max_buffered_ops;
+    if (!closing && !buffer_full) {
+      buffer_.push_back(BufferedOp {
+        .op = std::move(op),
+        .callback = std::move(callback),
+        .key = std::move(key),
+        .start = std::chrono::steady_clock::now(),
+      });
+      batches = TakeBatchesUnlocked(/* force= */ false);
+      ScheduleDelayedFlushUnlocked();
+    }
+  }
+  if (closing) {
+    if (callback) {
+      callback(STATUS(IllegalState, "Auto flushing session is shut down"));
+    }
+    return;
+  }
+  if (buffer_full) {
+    if (callback) {
+      callback(STATUS_FORMAT(
+          Busy, "Auto flushing session has too many buffered operations: $0",
+          FLAGS_ybclient_auto_flush_max_buffered_ops));
+    }
+    return;
+  }
+  FlushBatches(std::move(batches));
+}
+
+void AutoFlushingSession::Flush() {
+  Batches batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches = TakeBatchesUnlocked(/* force= */ true);
+  }
+  FlushBatches(std::move(batches));
+}
+
+void AutoFlushingSession::Shutdown() {
+  Batches batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!closing_) {
+      closing_ = true;
+      batches = TakeBatchesUnlocked(/* force= */ true);
+      if (flush_task_id_ != rpc::kUninitializedScheduledTaskId) {
+        client_->messenger()->scheduler().Abort(flush_task_id_);
+      }
+    }
+  }
+  FlushBatches(std::move(batches));
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Have to use while, since GUARDED_BY does not understand cond wait with predicate.
+  while (!IdleUnlocked()) {
+    cond_.wait(lock);
+  }
+}
+
+size_t AutoFlushingSession::batch_size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batch_size_;
+}
+
+size_t AutoFlushingSession::TEST_buffered_ops() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffer_.size();
+}
+
+size_t AutoFlushingSession::TEST_max_flushed_batch_ops() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_flushed_batch_ops_;
+}
+
+AutoFlushingSession::Batch AutoFlushingSession::TakeBatchUnlocked(bool force) {
+  if (buffer_.empty()) {
+    return Batch();
+  }
+  // In-flight limit is ignored during shutdown, so all buffered operations are flushed.
+  if (!closing_ && in_flight_batches_ >= MaxInFlightBatches()) {
+    return Batch();
+  }
+  if (!force && buffer_.size() < batch_size_ &&
+      std::chrono::steady_clock::now() <
+          buffer_.front().start + FLAGS_ybclient_auto_flush_max_delay_us * 1us) {
+    return Batch();
+  }
+  Batch result;
+  Batch left;
+  // Keys of operations left in the buffer, later operations with the same key should wait for them.
+  std::unordered_set<std::string> left_keys;
+  for (auto& buffered_op : buffer_) {
+    // Operations that don't fit into the batch are left in the buffer for the next one.
+    if (result.size() >= batch_size_ || in_flight_keys_.count(buffered_op.key) ||
+        left_keys.count(buffered_op.key)) {
+      left_keys.insert(buffered_op.key);
+      left.push_back(std::move(buffered_op));
+    } else {
+      result.push_back(std::move(buffered_op));
+    }
+  }
+  buffer_.swap(left);
+  if (result.empty()) {
+    return result;
+  }
+  ++in_flight_batches_;
+  max_flushed_batch_ops_ = std::max(max_flushed_batch_ops_, result.size());
+  for (const auto& buffered_op : result) {
+    ++in_flight_keys_[buffered_op.key];
+  }
+  return result;
+}
+
+AutoFlushingSession::Batches AutoFlushingSession::TakeBatchesUnlocked(bool force) {
+  Batches result;
+  for (;;) {
+    auto batch = TakeBatchUnlocked(force);
+    if (batch.empty()) {
+      return result;
+    }
+    result.push_back(std::move(batch));
+  }
+}
+
+void AutoFlushingSession::ScheduleDelayedFlushUnlocked() {
+  // When the in-flight limit is reached, buffered operations are taken when a batch completes.
+  if (buffer_.empty() || closing_ || in_flight_batches_ >= MaxInFlightBatches() ||
+      flush_task_id_ != rpc::kUninitializedScheduledTaskId) {
+    return;
+  }
+  auto flush_time = buffer_.front().start + FLAGS_ybclient_auto_flush_max_delay_us * 1us;
+  // Buffered operations that are already due were left in the buffer because of in-flight
+  // operations with the same key, so they are taken when a batch completes.
+  if (in_flight_batches_ != 0 && flush_time <= std::chrono::steady_clock::now()) {
+    return;
+  }
+  flush_task_id_ = client_->messenger()->scheduler().Schedule(
+      [this](const Status& status) { DelayedFlush(status); }, flush_time);
+}
+
+void AutoFlushingSession::DelayedFlush(const Status& status) {
+  Batches batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    flush_task_id_ = rpc::kUninitializedScheduledTaskId;
+    if (status.ok()) {
+      batches = TakeBatchesUnlocked(/* force= */ false);
+      ScheduleDelayedFlushUnlocked();
+    }
+    if (closing_) {
+      cond_.notify_all();
+    }
+  }
+  FlushBatches(std::move(batches));
+}
+
+void AutoFlushingSession::FlushBatches(Batches batches) {
+  for (auto& batch : batches) {
+    FlushBatch(std::move(batch));
+  }
+}
+
+void AutoFlushingSession::FlushBatch(Batch batch) {
+  auto session = client_->NewSession();
+  session->SetTimeout(timeout_);
+  for (const auto& buffered_op : batch) {
+    session->Apply(buffered_op.op);
+  }
+  auto start = std::chrono::steady_clock::now();
+  session->FlushAsync([this, session, batch = std::move(batch), start](FlushStatus* flush_status) {
+    BatchFlushed(batch, start, flush_status);
+  });
+}
+
+void AutoFlushingSession::BatchFlushed(
+    const Batch& batch, rpc::SteadyTimePoint start, FlushStatus* flush_status) {
+  MonoDelta latency(std::chrono::steady_clock::now() - start);
+
+  std::unordered_map<const YBOperation*, Status> op_errors;
+  for (const auto& error : flush_status->errors) {
+    op_errors.emplace(&error->failed_op(), error->status());
+  }
+  for (const auto& buffered_op : batch) {
+    if (!buffered_op.callback) {
+      continue;
+    }
+    auto it = op_errors.find(buffered_op.op.get());
+    if (it != op_errors.end()) {
+      buffered_op.callback(it->second);
+    } else {
+      // Operations without errors succeeded, unless the whole flush failed.
+      buffered_op.callback(op_errors.empty() ? flush_status->status : Status::OK());
+    }
+  }
+
+  Batches next_batches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --in_flight_batches_;
+    for (const auto& buffered_op : batch) {
+      auto it = in_flight_keys_.find(buffered_op.key);
+      if (--it->second == 0) {
+        in_flight_keys_.erase(it);
+      }
+    }
+    AdjustBatchSizeUnlocked(latency, batch.size());
+    next_batches = TakeBatchesUnlocked(/* force= */ closing_);
+    ScheduleDelayedFlushUnlocked();
+    if (closing_) {
+      cond_.notify_all();
+    }
+  }
+  FlushBatches(std::move(next_batches));
+}
+
+void AutoFlushingSession::AdjustBatchSizeUnlocked(MonoDelta latency, size_t batch_ops) {
+  const auto min_size = std::max<size_t>(FLAGS_ybclient_auto_flush_min_batch_size, 1);
+  const auto max_size = std::max<size_t>(FLAGS_ybclient_auto_flush_max_batch_size, min_size);
+  if (latency > MonoDelta::FromMicroseconds(FLAGS_ybclient_auto_flush_target_latency_us)) {
+    batch_size_ /= 2;
+  } else if (batch_ops >= batch_size_) {
+    // Grow only after full batches, partial ones are flushed by delay and don't show the latency
+    // of a batch with the current size.
+    batch_size_ *= 2;
+  }
+  batch_size_ = std::clamp(batch_size_, min_size, max_size);
+}
+
+bool AutoFlushingSession::IdleUnlocked() const {
+  return in_flight_batches_ == 0 && flush_task_id_ == rpc::kUninitializedScheduledTaskId;
+}
+
+} // namespace client
+} // namespace yb
@@ -0,0 +1,119 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/rpc/rpc_fwd.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/async_util.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace client {
+
+// Thread safe session that aggregates non transactional operations applied from multiple threads
+// and flushes them in the background, so callers don't have to batch operations by themselves.
+//
+// Buffered operations are flushed in batches of at most the current batch size, grouped per tablet
+// by the batcher, when:
+// 1) the number of buffered operations reaches the current batch size;
+// 2) the oldest buffered operation has waited for ybclient_auto_flush_max_delay_us;
+// 3) Flush or Shutdown is called.
+// At most ybclient_auto_flush_max_in_flight_batches batches are flushed concurrently, operations
+// applied while this limit is reached stay in the buffer until one of the batches completes.
+//
+// Operations with the same partition key are applied in the order they were applied to the session:
+// an operation stays in the buffer while an earlier operation with the same partition key is in
+// flight, so such operations are never sent in concurrent batches.
+//
+// The batch size is adjusted from the observed flush latency. It is doubled while full batches
+// complete within ybclient_auto_flush_target_latency_us, and halved when a flush exceeds it.
+class AutoFlushingSession {
+ public:
+  AutoFlushingSession(YBClient* client, MonoDelta timeout);
+  ~AutoFlushingSession();
+
+  // Buffers the operation. The callback is invoked with the status of the operation when the batch
+  // containing it is flushed. When ybclient_auto_flush_max_buffered_ops operations are already
+  // buffered, the operation is not buffered and the callback is invoked with Busy right away, so
+  // the caller could back off.
+  void Apply(YBOperationPtr op, StatusFunctor callback);
+
+  // Flushes buffered operations without waiting for the batch to fill up.
+  void Flush();
+
+  // Flushes buffered operations and waits until all batches are completed.
+  // Operations applied after shutdown are failed.
+  void Shutdown();
+
+  size_t batch_size() const;
+
+  size_t TEST_buffered_ops() const;
+  // Returns the max number of operations in a batch flushed by this session.
+  size_t TEST_max_flushed_batch_ops() const;
+
+ private:
+  struct BufferedOp {
+    YBOperationPtr op;
+    StatusFunctor callback;
+    // Table id and partition key of the operation.
+    std::string key;
+    // Time when the operation was applied.
+    rpc::SteadyTimePoint start;
+  };
+
+  using Batch = std::vector<BufferedOp>;
+  using Batches = std::vector<Batch>;
+
+  // Takes up to batch size buffered operations when they should be flushed, otherwise returns an
+  // empty batch. Operations with the same key as an operation of an in-flight batch are left in the
+  // buffer.
+  Batch TakeBatchUnlocked(bool force) REQUIRES(mutex_);
+  // Takes batches while the in-flight limit allows it and buffered operations should be flushed.
+  Batches TakeBatchesUnlocked(bool force) REQUIRES(mutex_);
+  void ScheduleDelayedFlushUnlocked() REQUIRES(mutex_);
+  void DelayedFlush(const Status& status);
+  void FlushBatch(Batch batch);
+  void FlushBatches(Batches batches);
+  void BatchFlushed(const Batch& batch, rpc::SteadyTimePoint start, FlushStatus* flush_status);
+  void AdjustBatchSizeUnlocked(MonoDelta latency, size_t batch_ops) REQUIRES(mutex_);
+  bool IdleUnlocked() const REQUIRES(mutex_);
+
+  YBClient* const client_;
+  const MonoDelta timeout_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+  Batch buffer_ GUARDED_BY(mutex_);
+  // Number of operations in in-flight batches per key.
+  std::unordered_map<std::string, size_t> in_flight_keys_ GUARDED_BY(mutex_);
+  size_t batch_size_ GUARDED_BY(mutex_);
+  size_t in_flight_batches_ GUARDED_BY(mutex_) = 0;
+  rpc::ScheduledTaskId flush_task_id_ GUARDED_BY(mutex_) = rpc::kUninitializedScheduledTaskId;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  size_t max_flushed_batch_ops_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace client
+} // namespace yb
@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <regex>
 #include <set>
 #include <thread>
@@ -40,6 +41,7 @@
 #include <gtest/gtest.h>
 
 #include "yb/client/async_initializer.h"
+#include "yb/client/auto_flushing_session.h"
 #include "yb/client/client-internal.h"
 #include "yb/client/client-test-util.h"
 #include "yb/client/client.h"
@@ -137,6 +139,12 @@ DECLARE_int32(pgsql_proxy_webserver_port);
 
 DECLARE_int32(scheduled_full_compaction_frequency_hours);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+DECLARE_uint32(ybclient_auto_flush_max_batch_size);
+DECLARE_uint32(ybclient_auto_flush_max_buffered_ops);
+DECLARE_uint32(ybclient_auto_flush_max_delay_us);
+DECLARE_uint32(ybclient_auto_flush_max_in_flight_batches);
+DECLARE_uint32(ybclient_auto_flush_min_batch_size);
+DECLARE_uint32(ybclient_auto_flush_target_latency_us);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
 
@@ -1251,6 +1259,202 @@ TEST_F(ClientTest, TestSessionClose) {
   ASSERT_OK(session->Close());
 }
 
+TEST_F(ClientTest, AutoFlushingSession) {
+  constexpr int kNumThreads = 4;
+  constexpr int kRowsPerThread = 250;
+
+  std::atomic<int> num_callbacks{0};
+  std::atomic<int> num_failures{0};
+  {
+    AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+    TestThreadHolder thread_holder;
+    for (int thread_idx = 0; thread_idx != kNumThreads; ++thread_idx) {
+      thread_holder.AddThreadFunctor(
+          [this, thread_idx, &session, &num_callbacks, &num_failures] {
+        for (int i = 0; i != kRowsPerThread; ++i) {
+          session.Apply(
+              BuildTestRow(client_table_, thread_idx * kRowsPerThread + i),
+              [&num_callbacks, &num_failures](const Status& status) {
+            if (!status.ok()) {
+              LOG(WARNING) << "Apply failed: " << status;
+              ++num_failures;
+            }
+            ++num_callbacks;
+          });
+        }
+      });
+    }
+    thread_holder.JoinAll();
+    session.Shutdown();
+
+    // Operations applied after shutdown are rejected.
+    Status status_after_shutdown;
+    session.Apply(BuildTestRow(client_table_, 0), [&status_after_shutdown](const Status& status) {
+      status_after_shutdown = status;
+    });
+    ASSERT_TRUE(status_after_shutdown.IsIllegalState()) << status_after_shutdown;
+  }
+
+  ASSERT_EQ(num_callbacks.load(), kNumThreads * kRowsPerThread);
+  ASSERT_EQ(num_failures.load(), 0);
+  ASSERT_EQ(kNumThreads * kRowsPerThread, CountRowsFromClient(client_table_));
+}
+
+// Operations on the same key should be applied in order, even when they are flushed in different
+// batches.
+TEST_F(ClientTest, AutoFlushingSessionSameKeyOrder) {
+  constexpr int kKeys = 10;
+  constexpr int kIterations = 20;
+
+  // Flush every operation in a separate batch, so concurrent batches contain the same keys.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_min_batch_size) = 1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_batch_size) = 1;
+
+  std::atomic<int> num_failures{0};
+  auto callback = [&num_failures](const Status& status) {
+    if (!status.ok()) {
+      LOG(WARNING) << "Apply failed: " << status;
+      ++num_failures;
+    }
+  };
+  {
+    AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+    for (int i = 0; i != kIterations; ++i) {
+      for (int key = 0; key != kKeys; ++key) {
+        session.Apply(BuildTestRow(client_table_, key), callback);
+        session.Apply(DeleteTestRow(client_table_, key), callback);
+      }
+    }
+    // Only rows with even keys should be present at the end.
+    for (int key = 0; key != kKeys; key += 2) {
+      session.Apply(BuildTestRow(client_table_, key), callback);
+    }
+    session.Shutdown();
+  }
+
+  ASSERT_EQ(num_failures.load(), 0);
+  ASSERT_EQ(kKeys / 2, CountRowsFromClient(client_table_));
+}
+
+TEST_F(ClientTest, AutoFlushingSessionBatchSize) {
+  constexpr uint32_t kMinBatchSize = 8;
+  constexpr uint32_t kMaxBatchSize = 64;
+  constexpr int kRows = 1000;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_min_batch_size) = kMinBatchSize;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_batch_size) = kMaxBatchSize;
+  // Every batch is flushed within the target latency, so full batches grow the batch size.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_target_latency_us) = 60000000;
+
+  AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+  ASSERT_EQ(session.batch_size(), kMinBatchSize);
+
+  auto apply_rows = [this, &session](int begin, int end) {
+    CountDownLatch latch(end - begin);
+    for (int i = begin; i != end; ++i) {
+      session.Apply(BuildTestRow(client_table_, i), [&latch](const Status& status) {
+        EXPECT_OK(status);
+        latch.CountDown();
+      });
+    }
+    session.Flush();
+    latch.Wait();
+  };
+
+  apply_rows(0, kRows);
+  ASSERT_EQ(session.batch_size(), kMaxBatchSize);
+
+  // Every batch exceeds the target latency, so the batch size shrinks.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_target_latency_us) = 1;
+  apply_rows(kRows, 2 * kRows);
+  ASSERT_EQ(session.batch_size(), kMinBatchSize);
+
+  session.Shutdown();
+  ASSERT_EQ(2 * kRows, CountRowsFromClient(client_table_));
+}
+
+// Operations are flushed after the max delay even when the batch is not full and the session is
+// never flushed explicitly.
+TEST_F(ClientTest, AutoFlushingSessionDelayedFlush) {
+  constexpr auto kMaxDelay = 200ms;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_min_batch_size) = 1000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_delay_us) =
+      narrow_cast<uint32_t>(ToMicroseconds(kMaxDelay));
+
+  AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+  std::promise<Status> promise;
+  auto start = std::chrono::steady_clock::now();
+  session.Apply(BuildTestRow(client_table_, 1), [&promise](const Status& status) {
+    promise.set_value(status);
+  });
+  auto future = promise.get_future();
+  ASSERT_EQ(future.wait_for(10s * kTimeMultiplier), std::future_status::ready);
+  ASSERT_OK(future.get());
+  ASSERT_GE(std::chrono::steady_clock::now() - start, kMaxDelay);
+  ASSERT_EQ(1, CountRowsFromClient(client_table_));
+  session.Shutdown();
+}
+
+// Operations buffered while the in-flight limit is reached are flushed in batches of at most the
+// batch size.
+TEST_F(ClientTest, AutoFlushingSessionInFlightLimit) {
+  constexpr uint32_t kBatchSize = 8;
+  constexpr int kRows = 1000;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_min_batch_size) = kBatchSize;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_batch_size) = kBatchSize;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_in_flight_batches) = 1;
+
+  AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+  CountDownLatch latch(kRows);
+  size_t max_buffered_ops = 0;
+  for (int i = 0; i != kRows; ++i) {
+    session.Apply(BuildTestRow(client_table_, i), [&latch](const Status& status) {
+      EXPECT_OK(status);
+      latch.CountDown();
+    });
+    max_buffered_ops = std::max(max_buffered_ops, session.TEST_buffered_ops());
+  }
+  session.Flush();
+  ASSERT_TRUE(latch.WaitFor(30s * kTimeMultiplier));
+
+  // Operations were accumulated in the buffer while the only allowed batch was in flight.
+  ASSERT_GT(max_buffered_ops, kBatchSize);
+  ASSERT_EQ(session.batch_size(), kBatchSize);
+  ASSERT_LE(session.TEST_max_flushed_batch_ops(), kBatchSize);
+
+  session.Shutdown();
+  ASSERT_EQ(kRows, CountRowsFromClient(client_table_));
+}
+
+// Operations applied while the buffer is full are failed with Busy.
+TEST_F(ClientTest, AutoFlushingSessionBufferLimit) {
+  constexpr int kMaxBufferedOps = 5;
+
+  // Keep operations in the buffer until shutdown.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_min_batch_size) = 1000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_delay_us) = 60000000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_auto_flush_max_buffered_ops) = kMaxBufferedOps;
+
+  std::vector<Status> statuses(kMaxBufferedOps + 1);
+  {
+    AutoFlushingSession session(client_.get(), 10s * kTimeMultiplier);
+    for (int i = 0; i != kMaxBufferedOps + 1; ++i) {
+      session.Apply(BuildTestRow(client_table_, i), [&statuses, i](const Status& status) {
+        statuses[i] = status;
+      });
+    }
+    // The last operation is rejected right away.
+    ASSERT_TRUE(statuses.back().IsBusy()) << statuses.back();
+    session.Shutdown();
+  }
+  for (int i = 0; i != kMaxBufferedOps; ++i) {
+    ASSERT_OK(statuses[i]);
+  }
+  ASSERT_EQ(kMaxBufferedOps, CountRowsFromClient(client_table_));
+}
+
 // Test which sends multiple batches through the same session, each of which
 // contains multiple rows spread across multiple tablets.
 TEST_F(ClientTest, TestMultipleMultiRowManualBatches) {
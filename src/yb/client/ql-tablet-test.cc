@@ -13,6 +13,7 @@
 //
 //
 
+#include <future>
 #include <shared_mutex>
 #include <thread>
 
@@ -20,7 +21,9 @@
 #include <boost/optional/optional_io.hpp>
 
 #include "yb/client/client-test-util.h"
+#include "yb/client/client_utils.h"
 #include "yb/client/error.h"
+#include "yb/client/meta_cache.h"
 #include "yb/client/ql-dml-test-base.h"
 #include "yb/client/schema.h"
 #include "yb/client/session.h"
@@ -34,6 +37,7 @@
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/raft_consensus.h"
 
@@ -41,6 +45,8 @@
 #include "yb/dockv/doc_key.h"
 #include "yb/docdb/docdb_test_util.h"
 
+#include "yb/fs/fs_manager.h"
+
 #include "yb/gutil/casts.h"
 
 #include "yb/integration-tests/test_workload.h"
@@ -60,6 +66,7 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_retention_policy.h"
 
@@ -69,6 +76,8 @@
 #include "yb/tserver/tserver_service.proxy.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/env.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/range.h"
 #include "yb/util/shared_lock.h"
@@ -107,6 +116,15 @@ DECLARE_uint64(sst_files_hard_limit);
 DECLARE_uint64(sst_files_soft_limit);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_bool(send_leader_hint_on_not_the_leader);
+DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_bool(enable_multi_raft_vote_batching);
+DECLARE_bool(TEST_fail_multi_raft_request_consensus_vote);
+DECLARE_int32(closed_timestamp_propagation_interval_ms);
+
+METRIC_DECLARE_histogram(handler_latency_yb_consensus_ConsensusService_RequestConsensusVote);
+METRIC_DECLARE_histogram(
+    handler_latency_yb_consensus_ConsensusService_MultiRaftRequestConsensusVote);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(TEST_preparer_batch_inject_latency_ms);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
@@ -115,6 +133,11 @@ DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_string(compression_type);
 DECLARE_bool(ycql_enable_packed_row);
 DECLARE_bool(ysql_enable_packed_row);
+DECLARE_uint32(follower_read_lease_duration_ms);
+DECLARE_uint64(log_segment_size_bytes);
+DECLARE_uint64(initial_log_segment_size_bytes);
+DECLARE_int32(log_min_segments_to_retain);
+DECLARE_int32(log_min_seconds_to_retain);
 
 namespace yb {
 namespace client {
@@ -250,6 +273,16 @@ class QLTabletTest : public QLDmlTestBase<MiniCluster> {
     }
   }
 
+  size_t ServerIndex(const tablet::TabletPeerPtr& peer) {
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      if (cluster_->mini_tablet_server(i)->server()->permanent_uuid() == peer->permanent_uuid()) {
+        return i;
+      }
+    }
+    LOG(FATAL) << "Server not found for " << peer->permanent_uuid();
+    return 0;
+  }
+
   typedef std::pair<std::vector<std::string>, std::unordered_set<std::string>> TabletIdsAndReplicas;
 
   Result<TabletIdsAndReplicas> GetTabletIdsAndReplicas(const TableHandle& table) {
@@ -508,6 +541,8 @@ class QLTabletTest : public QLDmlTestBase<MiniCluster> {
 
   void TestDeletePartialKey(int num_range_keys_in_delete);
 
+  void TestLeaderHint(bool send_hint);
+
   void CreateAndVerifyIndexConsistency(int expected_number_rows_mismatched);
 
   TableHandle table1_;
@@ -983,6 +1018,668 @@ TEST_F(QLTabletTest, LeaderChange) {
   ASSERT_EQ(GetValue(session, kKey, table), kValue3);
 }
 
+// Moves leadership to the replica that the client would try last, and checks which replicas
+// reject the write sent to the old leader. Without the hint, the client guesses the next replica
+// in its cache, so the remaining follower also rejects the write. With the hint, the retry goes
+// straight to the new leader.
+void QLTabletTest::TestLeaderHint(bool send_hint) {
+  constexpr int32_t kKey = 1;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_send_leader_hint_on_not_the_leader) = send_hint;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, /* num_tablets = */ 1);
+  auto session = client_->NewSession();
+  session->SetTimeout(60s);
+  SetValue(session, kKey, kKey, table);
+
+  std::unordered_map<std::string, tablet::TabletPeerPtr> peers;
+  tablet::TabletPeerPtr old_leader;
+  for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    for (const auto& peer : cluster_->mini_tablet_server(i)->server()->tablet_manager()
+                                ->GetTabletPeers()) {
+      if (peer->tablet_metadata()->table_id() != table->id()) {
+        continue;
+      }
+      peers.emplace(peer->permanent_uuid(), peer);
+      if (peer->LeaderStatus() != consensus::LeaderStatus::NOT_LEADER) {
+        old_leader = peer;
+      }
+    }
+  }
+  ASSERT_EQ(peers.size(), 3U);
+  ASSERT_NE(old_leader, nullptr);
+
+  // Order in which the client tries the followers when the cached leader rejects the write.
+  auto remote_tablet = ASSERT_RESULT(LookupFirstTabletFuture(client_.get(), table.table()).get());
+  std::vector<tablet::TabletPeerPtr> followers;
+  for (auto* ts : remote_tablet->GetRemoteTabletServers()) {
+    if (ts->permanent_uuid() != old_leader->permanent_uuid()) {
+      followers.push_back(peers.at(ts->permanent_uuid()));
+    }
+  }
+  ASSERT_EQ(followers.size(), 2U);
+  auto guessed_follower = followers[0];
+  auto new_leader = followers[1];
+
+  consensus::LeaderStepDownRequestPB req;
+  req.set_tablet_id(old_leader->tablet_id());
+  req.set_new_leader_uuid(new_leader->permanent_uuid());
+  consensus::LeaderStepDownResponsePB resp;
+  ASSERT_OK(old_leader->consensus()->StepDown(&req, &resp));
+  ASSERT_FALSE(resp.has_error()) << resp.ShortDebugString();
+
+  // Wait until all replicas know the new leader, so the old leader could send the hint.
+  ASSERT_OK(WaitFor([&peers, &new_leader] {
+    if (new_leader->LeaderStatus() != consensus::LeaderStatus::LEADER_AND_READY) {
+      return false;
+    }
+    for (const auto& [uuid, peer] : peers) {
+      auto cstate = peer->consensus()->ConsensusState(consensus::CONSENSUS_CONFIG_ACTIVE);
+      if (cstate.leader_uuid() != new_leader->permanent_uuid()) {
+        return false;
+      }
+    }
+    return true;
+  }, 30s * kTimeMultiplier, "Wait for new leader"));
+
+  std::unordered_map<std::string, int64_t> rejections;
+  for (const auto& [uuid, peer] : peers) {
+    rejections[uuid] = peer->tablet()->metrics()->not_leader_rejections->value();
+  }
+
+  // Client still has the old leader cached.
+  SetValue(session, kKey, kKey + 1, table);
+
+  std::unordered_map<std::string, int64_t> expected_rejections = {
+    {old_leader->permanent_uuid(), 1},
+    {guessed_follower->permanent_uuid(), send_hint ? 0 : 1},
+    {new_leader->permanent_uuid(), 0},
+  };
+  for (const auto& [uuid, peer] : peers) {
+    auto new_rejections = peer->tablet()->metrics()->not_leader_rejections->value() -
+                          rejections[uuid];
+    ASSERT_EQ(new_rejections, expected_rejections[uuid]) << uuid;
+  }
+  ASSERT_EQ(remote_tablet->LeaderTServer()->permanent_uuid(), new_leader->permanent_uuid());
+  ASSERT_EQ(GetValue(session, kKey, table), kKey + 1);
+}
+
+TEST_F(QLTabletTest, LeaderHint) {
+  TestLeaderHint(/* send_hint= */ true);
+}
+
+TEST_F(QLTabletTest, NoLeaderHint) {
+  TestLeaderHint(/* send_hint= */ false);
+}
+
+namespace {
+
+int64_t CountHandlerCalls(MiniCluster* cluster, const HistogramPrototype& metric) {
+  int64_t result = 0;
+  for (size_t i = 0; i != cluster->num_tablet_servers(); ++i) {
+    auto* server = cluster->mini_tablet_server(i)->server();
+    result += metric.Instantiate(server->metric_entity())->TotalCount();
+  }
+  return result;
+}
+
+int64_t CountBatchedVoteCalls(MiniCluster* cluster) {
+  return CountHandlerCalls(
+      cluster, METRIC_handler_latency_yb_consensus_ConsensusService_MultiRaftRequestConsensusVote);
+}
+
+Status RestartTabletServers(MiniCluster* cluster) {
+  for (size_t i = 0; i != cluster->num_tablet_servers(); ++i) {
+    RETURN_NOT_OK(cluster->mini_tablet_server(i)->Restart());
+    RETURN_NOT_OK(cluster->mini_tablet_server(i)->WaitStarted());
+  }
+  return Status::OK();
+}
+
+} // namespace
+
+// After all tablet servers restart, every tablet elects its leader through batched vote requests.
+TEST_F(QLTabletTest, BatchedLeaderElectionVotes) {
+  constexpr int kNumTablets = 6;
+  constexpr int32_t kKey = 1;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_heartbeat_batcher) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_vote_batching) = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, kNumTablets);
+
+  ASSERT_OK(RestartTabletServers(cluster_.get()));
+  ASSERT_RESULT(WaitForTableActiveTabletLeadersPeers(
+      cluster_.get(), table->id(), kNumTablets, 30s * kTimeMultiplier));
+
+  // Restarted servers have fresh metrics, so they count only the votes of the new elections.
+  ASSERT_GT(CountBatchedVoteCalls(cluster_.get()), 0);
+  ASSERT_EQ(CountHandlerCalls(
+      cluster_.get(), METRIC_handler_latency_yb_consensus_ConsensusService_RequestConsensusVote),
+      0);
+
+  auto session = client_->NewSession();
+  session->SetTimeout(60s);
+  SetValue(session, kKey, kKey, table);
+  ASSERT_EQ(GetValue(session, kKey, table), kKey);
+}
+
+// A failed batched vote RPC is reported as a vote error, so elections fail and are retried until
+// the batched RPC succeeds.
+TEST_F(QLTabletTest, BatchedLeaderElectionVotesFailure) {
+  constexpr int kNumTablets = 6;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_heartbeat_batcher) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_vote_batching) = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, kNumTablets);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_fail_multi_raft_request_consensus_vote) = true;
+  ASSERT_OK(RestartTabletServers(cluster_.get()));
+
+  // Elections keep sending batched vote requests, but do not elect anybody.
+  const auto election_retry_time = FLAGS_raft_heartbeat_interval_ms * 10ms * kTimeMultiplier;
+  ASSERT_OK(WaitFor([this] {
+    return CountBatchedVoteCalls(cluster_.get()) > 0;
+  }, 30s * kTimeMultiplier, "Wait for batched votes"));
+  auto batched_votes = CountBatchedVoteCalls(cluster_.get());
+  std::this_thread::sleep_for(election_retry_time);
+  ASSERT_GT(CountBatchedVoteCalls(cluster_.get()), batched_votes);
+  ASSERT_EQ(ListTableActiveTabletLeadersPeers(cluster_.get(), table->id()).size(), 0U);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_fail_multi_raft_request_consensus_vote) = false;
+  ASSERT_RESULT(WaitForTableActiveTabletLeadersPeers(
+      cluster_.get(), table->id(), kNumTablets, 30s * kTimeMultiplier));
+}
+
+namespace {
+
+// Returns the number of times the safe time of the follower advanced during the specified period.
+size_t CountFollowerSafeTimeAdvances(const tablet::TabletPeerPtr& follower, MonoDelta duration) {
+  auto* mvcc = follower->tablet()->mvcc_manager();
+  auto last_safe_time = mvcc->SafeTimeForFollower(HybridTime::kMin, CoarseTimePoint::min());
+  size_t result = 0;
+  const auto deadline = CoarseMonoClock::now() + duration;
+  while (CoarseMonoClock::now() < deadline) {
+    std::this_thread::sleep_for(10ms);
+    auto safe_time = mvcc->SafeTimeForFollower(HybridTime::kMin, CoarseTimePoint::min());
+    if (safe_time > last_safe_time) {
+      ++result;
+      last_safe_time = safe_time;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+// Safe time of a follower of an idle tablet advances every closed_timestamp_propagation_interval_ms
+// while heartbeats are batched, and every raft_heartbeat_interval_ms after batching is turned off.
+TEST_F(QLTabletTest, ClosedTimestampPropagation) {
+  constexpr int32_t kHeartbeatIntervalMs = 1000;
+  constexpr int32_t kPropagationIntervalMs = 100;
+  const auto kWindow = 5s;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_heartbeat_batcher) = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+
+  // Peers pick up the intervals on start.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_raft_heartbeat_interval_ms) = kHeartbeatIntervalMs;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_closed_timestamp_propagation_interval_ms) =
+      kPropagationIntervalMs;
+  ASSERT_OK(RestartTabletServers(cluster_.get()));
+  ASSERT_RESULT(WaitForTableActiveTabletLeadersPeers(
+      cluster_.get(), table->id(), 1, 30s * kTimeMultiplier));
+
+  tablet::TabletPeerPtr follower;
+  for (const auto& peer : ListTableActiveTabletPeers(cluster_.get(), table->id())) {
+    if (peer->LeaderStatus() == consensus::LeaderStatus::NOT_LEADER) {
+      follower = peer;
+      break;
+    }
+  }
+  ASSERT_NE(follower, nullptr);
+
+  auto advances = CountFollowerSafeTimeAdvances(follower, kWindow);
+  LOG(INFO) << "Safe time advances with closed timestamp propagation: " << advances;
+  ASSERT_GE(advances, static_cast<size_t>(kWindow / (kPropagationIntervalMs * 4ms)));
+
+  // Without the batcher every closed timestamp request would be a separate RPC, so safe time is
+  // propagated by regular heartbeats only.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_multi_raft_heartbeat_batcher) = false;
+  advances = CountFollowerSafeTimeAdvances(follower, kWindow);
+  LOG(INFO) << "Safe time advances without heartbeat batcher: " << advances;
+  ASSERT_LE(advances, static_cast<size_t>(kWindow / (kHeartbeatIntervalMs * 1ms) * 2));
+}
+
+class QLTabletFollowerReadLeaseTest : public QLTabletTest {
+ protected:
+  static constexpr int32_t kKey = 1;
+  static constexpr int32_t kLeaseDurationMs = 3000;
+
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_follower_read_lease_duration_ms) =
+        kLeaseDurationMs * kTimeMultiplier;
+    QLTabletTest::SetUp();
+
+    YBSchemaBuilder builder;
+    builder.AddColumn(kKeyColumn)->Type(INT32)->HashPrimaryKey()->NotNull();
+    builder.AddColumn(kValueColumn)->Type(INT32);
+    TableProperties table_properties;
+    table_properties.SetFollowerReadLeases(true);
+    builder.SetTableProperties(table_properties);
+    ASSERT_OK(table_.Create(kTable1Name, /* num_tablets = */ 1, client_.get(), &builder));
+
+    session_ = CreateSession();
+    SetValue(session_, kKey, 0, table_);
+    peers_ = ListTableActiveTabletPeers(cluster_.get(), table_->id());
+    ASSERT_EQ(peers_.size(), 3U);
+  }
+
+  Result<tablet::TabletPeerPtr> Leader() {
+    for (const auto& peer : peers_) {
+      if (peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY) {
+        return peer;
+      }
+    }
+    return STATUS(NotFound, "No leader");
+  }
+
+  std::vector<tablet::TabletPeerPtr> Followers(const tablet::TabletPeerPtr& leader) {
+    std::vector<tablet::TabletPeerPtr> result;
+    for (const auto& peer : peers_) {
+      if (peer != leader) {
+        result.push_back(peer);
+      }
+    }
+    return result;
+  }
+
+  Status WaitForReadLeases(const std::vector<tablet::TabletPeerPtr>& followers) {
+    return WaitFor([&followers] {
+      for (const auto& peer : followers) {
+        if (!peer->CanServeStrongReadAsFollower()) {
+          return false;
+        }
+      }
+      return true;
+    }, 10s * kTimeMultiplier, "Wait for follower read leases");
+  }
+
+  struct ReplicaReadResult {
+    boost::optional<tserver::TabletServerErrorPB::Code> error;
+    boost::optional<int32_t> value;
+  };
+
+  // Sends strong read of kKey directly to the tablet server hosting the replica, without any retry.
+  Result<ReplicaReadResult> StrongReadFromReplica(const tablet::TabletPeerPtr& peer) {
+    auto* tserver = cluster_->mini_tablet_server(ServerIndex(peer))->server();
+    auto endpoint = tserver->rpc_server()->GetBoundAddresses().front();
+    tserver::TabletServerServiceProxy proxy(
+        &tserver->proxy_cache(), HostPort::FromBoundEndpoint(endpoint));
+
+    tserver::ReadRequestPB req;
+    {
+      std::string partition_key;
+      auto op = CreateReadOp(kKey, table_);
+      RETURN_NOT_OK(op->GetPartitionKey(&partition_key));
+      auto* ql_batch = req.add_ql_batch();
+      *ql_batch = op->request();
+      auto hash_code = dockv::PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+      ql_batch->set_hash_code(hash_code);
+      ql_batch->set_max_hash_code(hash_code);
+    }
+    req.set_tablet_id(peer->tablet_id());
+    req.set_consistency_level(YBConsistencyLevel::STRONG);
+
+    rpc::RpcController controller;
+    controller.set_timeout(5s * kTimeMultiplier);
+    tserver::ReadResponsePB resp;
+    RETURN_NOT_OK(proxy.Read(req, &resp, &controller));
+
+    ReplicaReadResult result;
+    if (resp.has_error()) {
+      result.error = resp.error().code();
+      return result;
+    }
+    const auto& ql_batch = resp.ql_batch(0);
+    SCHECK_EQ(ql_batch.status(), QLResponsePB::YQL_STATUS_OK, RemoteError,
+              ql_batch.error_message());
+    Schema projection;
+    RETURN_NOT_OK(client::internal::GetSchema(table_->schema()).CreateProjectionByIdsIgnoreMissing(
+        {table_.ColumnId(kValueColumn)}, &projection));
+    auto columns = std::make_shared<std::vector<ColumnSchema>>(YBSchema(projection).columns());
+    ql::RowsResult rows_result(
+        table_->name(), columns,
+        VERIFY_RESULT(controller.ExtractSidecar(ql_batch.rows_data_sidecar())));
+    auto row_block = rows_result.GetRowBlock();
+    if (row_block->row_count() == 1) {
+      result.value = row_block->row(0).column(0).int32_value();
+    }
+    return result;
+  }
+
+  // A replica could reject the strong read, but once it serves it, the read should see the latest
+  // committed value.
+  void CheckNoStaleRead(const tablet::TabletPeerPtr& peer, int32_t expected_value) {
+    auto result = ASSERT_RESULT(StrongReadFromReplica(peer));
+    if (!result.error) {
+      ASSERT_EQ(result.value, expected_value) << peer->permanent_uuid();
+    }
+  }
+
+  TableHandle table_;
+  YBSessionPtr session_;
+  std::vector<tablet::TabletPeerPtr> peers_;
+};
+
+TEST_F(QLTabletFollowerReadLeaseTest, ReadFromFollower) {
+  auto leader = ASSERT_RESULT(Leader());
+  auto followers = Followers(leader);
+  ASSERT_OK(WaitForReadLeases(followers));
+
+  for (int32_t value = 1; value <= 10; ++value) {
+    SetValue(session_, kKey, value, table_);
+    for (const auto& follower : followers) {
+      auto reads_before = follower->tablet()->metrics()->ql_read_latency->TotalCount();
+      auto result = ASSERT_RESULT(StrongReadFromReplica(follower));
+      // Follower could have not yet applied the write, so it is allowed to reject the read.
+      if (result.error) {
+        ASSERT_EQ(*result.error, tserver::TabletServerErrorPB::NOT_THE_LEADER);
+        continue;
+      }
+      ASSERT_EQ(result.value, value);
+      ASSERT_GT(follower->tablet()->metrics()->ql_read_latency->TotalCount(), reads_before);
+    }
+  }
+
+  // Once followers are caught up, strong reads are served by them.
+  ASSERT_OK(WaitForReadLeases(followers));
+  for (const auto& follower : followers) {
+    auto result = ASSERT_RESULT(StrongReadFromReplica(follower));
+    ASSERT_FALSE(result.error) << follower->permanent_uuid();
+    ASSERT_EQ(result.value, 10);
+  }
+}
+
+TEST_F(QLTabletFollowerReadLeaseTest, RejectWithPendingOperations) {
+  auto leader = ASSERT_RESULT(Leader());
+  auto follower = Followers(leader)[0];
+  ASSERT_OK(WaitForReadLeases({follower}));
+
+  // The follower acks the write, but does not apply it, so it stays pending in MVCC.
+  follower->raft_consensus()->TEST_PauseApply(true);
+  SetValue(session_, kKey, 1, table_);
+  ASSERT_TRUE(follower->tablet()->mvcc_manager()->HasPendingOperations());
+
+  auto result = ASSERT_RESULT(StrongReadFromReplica(follower));
+  ASSERT_EQ(result.error, tserver::TabletServerErrorPB::NOT_THE_LEADER);
+
+  // Client read, even if sent to this follower first, is retried on the leader.
+  auto leader_reads_before = leader->tablet()->metrics()->ql_read_latency->TotalCount();
+  auto follower_reads_before = follower->tablet()->metrics()->ql_read_latency->TotalCount();
+  ASSERT_EQ(GetValue(session_, kKey, table_), 1);
+  ASSERT_GT(leader->tablet()->metrics()->ql_read_latency->TotalCount(), leader_reads_before);
+  ASSERT_EQ(follower->tablet()->metrics()->ql_read_latency->TotalCount(), follower_reads_before);
+
+  follower->raft_consensus()->TEST_PauseApply(false);
+  ASSERT_OK(WaitForReadLeases({follower}));
+  result = ASSERT_RESULT(StrongReadFromReplica(follower));
+  ASSERT_FALSE(result.error);
+  ASSERT_EQ(result.value, 1);
+}
+
+TEST_F(QLTabletFollowerReadLeaseTest, WriteWaitsForPartitionedLeaseHolder) {
+  auto leader = ASSERT_RESULT(Leader());
+  auto followers = Followers(leader);
+  ASSERT_OK(WaitForReadLeases(followers));
+
+  auto partitioned = followers[0];
+  ASSERT_OK(BreakConnectivity(cluster_.get(), ServerIndex(leader), ServerIndex(partitioned)));
+
+  // The write is replicated to the majority right away, but could not be committed until the
+  // lease of the partitioned follower expires.
+  auto start = CoarseMonoClock::now();
+  SetValue(session_, kKey, 1, table_);
+  auto write_time = CoarseMonoClock::now() - start;
+  LOG(INFO) << "Write time: " << AsString(write_time);
+  ASSERT_GE(write_time, FLAGS_follower_read_lease_duration_ms * 1ms / 2);
+
+  // Partitioned follower does not have the write, so it should not serve the read.
+  auto result = ASSERT_RESULT(StrongReadFromReplica(partitioned));
+  ASSERT_EQ(result.error, tserver::TabletServerErrorPB::NOT_THE_LEADER);
+  ASSERT_NO_FATALS(CheckNoStaleRead(followers[1], 1));
+
+  ASSERT_OK(SetupConnectivity(
+      cluster_.get(), ServerIndex(leader), ServerIndex(partitioned), Connectivity::kOn));
+  ASSERT_OK(WaitForReadLeases({partitioned}));
+  ASSERT_NO_FATALS(CheckNoStaleRead(partitioned, 1));
+}
+
+TEST_F(QLTabletFollowerReadLeaseTest, LeaderChange) {
+  auto old_leader = ASSERT_RESULT(Leader());
+  auto followers = Followers(old_leader);
+  ASSERT_OK(WaitForReadLeases(followers));
+
+  ASSERT_OK(StepDown(old_leader, followers[0]->permanent_uuid(), ForceStepDown::kTrue));
+  SetValue(session_, kKey, 1, table_);
+
+  for (const auto& peer : peers_) {
+    ASSERT_NO_FATALS(CheckNoStaleRead(peer, 1));
+  }
+}
+
+TEST_F(QLTabletFollowerReadLeaseTest, ConfigChange) {
+  auto leader = ASSERT_RESULT(Leader());
+  auto followers = Followers(leader);
+  ASSERT_OK(WaitForReadLeases(followers));
+  auto removed = followers[0];
+
+  consensus::ChangeConfigRequestPB req;
+  req.set_tablet_id(leader->tablet_id());
+  req.set_type(consensus::REMOVE_SERVER);
+  req.mutable_server()->set_permanent_uuid(removed->permanent_uuid());
+  std::promise<Status> promise;
+  boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+  ASSERT_OK(leader->consensus()->ChangeConfig(
+      req, [&promise](const Status& status) { promise.set_value(status); }, &error_code));
+
+  // The removed follower does not receive this write, so it should stop serving strong reads
+  // before the write is committed.
+  SetValue(session_, kKey, 1, table_);
+  ASSERT_OK(promise.get_future().get());
+
+  ASSERT_NO_FATALS(CheckNoStaleRead(removed, 1));
+  ASSERT_NO_FATALS(CheckNoStaleRead(followers[1], 1));
+}
+
+class QLTabletWitnessTest : public QLTabletTest {
+ protected:
+  static constexpr int32_t kKey = 1;
+
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_segment_size_bytes) = 16 * 1024;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_initial_log_segment_size_bytes) = 16 * 1024;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_min_segments_to_retain) = 1;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_min_seconds_to_retain) = 0;
+    QLTabletTest::SetUp();
+
+    CreateTable(kTable1Name, &table_, /* num_tablets = */ 1);
+    auto peers = ListTableActiveTabletPeers(cluster_.get(), table_->id());
+    ASSERT_EQ(peers.size(), 3U);
+    tablet_id_ = peers[0]->tablet_id();
+    witness_uuid_ = peers[0]->permanent_uuid();
+    peers.clear();
+    ASSERT_OK(MarkWitnessAndRestart());
+  }
+
+  // There is no config change that turns a replica into a witness, so mark it directly in the
+  // committed config of every replica while the cluster is down.
+  Status MarkWitnessAndRestart() {
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      cluster_->mini_tablet_server(i)->Shutdown();
+    }
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* options = cluster_->mini_tablet_server(i)->options();
+      auto fs_opts = options->fs_opts;
+      fs_opts.server_type = options->server_type;
+      FsManager fs_manager(Env::Default(), fs_opts);
+      RETURN_NOT_OK(fs_manager.CheckAndOpenFileSystemRoots());
+      std::unique_ptr<consensus::ConsensusMetadata> cmeta;
+      RETURN_NOT_OK(consensus::ConsensusMetadata::Load(
+          &fs_manager, tablet_id_, fs_manager.uuid(), &cmeta));
+      auto config = cmeta->committed_config();
+      for (auto& peer : *config.mutable_peers()) {
+        if (peer.permanent_uuid() == witness_uuid_) {
+          peer.set_witness(true);
+        }
+      }
+      cmeta->set_committed_config(config);
+      RETURN_NOT_OK(cmeta->Flush());
+    }
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      RETURN_NOT_OK(cluster_->mini_tablet_server(i)->RestartStoppedServer());
+    }
+    RETURN_NOT_OK(WaitAllReplicasReady(cluster_.get(), table_->id(), 30s * kTimeMultiplier));
+
+    peers_ = ListTableActiveTabletPeers(cluster_.get(), table_->id());
+    SCHECK_EQ(peers_.size(), 3U, IllegalState, "Wrong number of peers");
+    for (const auto& peer : peers_) {
+      if (peer->permanent_uuid() == witness_uuid_) {
+        witness_ = peer;
+      } else {
+        full_voters_.push_back(peer);
+      }
+    }
+    SCHECK(witness_ && witness_->tablet()->witness(), IllegalState, "Witness is not marked");
+    return Status::OK();
+  }
+
+  // Witness never becomes a ready leader, so a ready leader is always a full voter.
+  Result<tablet::TabletPeerPtr> WaitForReadyLeader() {
+    tablet::TabletPeerPtr result;
+    RETURN_NOT_OK(WaitFor([this, &result] {
+      for (const auto& peer : peers_) {
+        if (peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY) {
+          result = peer;
+          return true;
+        }
+      }
+      return false;
+    }, 30s * kTimeMultiplier, "Wait for ready leader"));
+    SCHECK_NE(result, witness_, IllegalState, "Witness is a ready leader");
+    return result;
+  }
+
+  Status WaitReplicated(const tablet::TabletPeerPtr& leader, const tablet::TabletPeerPtr& peer) {
+    auto op_id = leader->consensus()->GetLastReceivedOpId();
+    return WaitFor([&peer, op_id] {
+      return peer->consensus()->GetLastCommittedOpId() >= op_id;
+    }, 30s * kTimeMultiplier, Format("Wait $0 to replicate $1", peer->permanent_uuid(), op_id));
+  }
+
+  TableHandle table_;
+  TabletId tablet_id_;
+  std::string witness_uuid_;
+  std::vector<tablet::TabletPeerPtr> peers_;
+  tablet::TabletPeerPtr witness_;
+  std::vector<tablet::TabletPeerPtr> full_voters_;
+};
+
+TEST_F(QLTabletWitnessTest, AppliesNothing) {
+  constexpr int kNumKeys = 100;
+
+  auto leader = ASSERT_RESULT(WaitForReadyLeader());
+  auto session = CreateSession();
+  for (int key = 0; key != kNumKeys; ++key) {
+    SetValue(session, key, ValueForKey(key), table_);
+  }
+
+  ASSERT_OK(WaitReplicated(leader, witness_));
+  for (const auto& peer : full_voters_) {
+    ASSERT_OK(WaitReplicated(leader, peer));
+    ASSERT_GE(ASSERT_RESULT(peer->tablet()->TEST_CountRegularDBRecords()),
+              static_cast<size_t>(kNumKeys));
+  }
+  ASSERT_EQ(ASSERT_RESULT(witness_->tablet()->TEST_CountRegularDBRecords()), 0U);
+}
+
+TEST_F(QLTabletWitnessTest, RetainsLogForLaggingVoter) {
+  constexpr int kNumKeys = 500;
+
+  auto leader = ASSERT_RESULT(WaitForReadyLeader());
+  auto session = CreateSession();
+  SetValue(session, 0, ValueForKey(0), table_);
+
+  tablet::TabletPeerPtr lagging;
+  for (const auto& peer : full_voters_) {
+    if (peer != leader) {
+      lagging = peer;
+    }
+  }
+  ASSERT_OK(WaitReplicated(leader, lagging));
+  ASSERT_OK(WaitReplicated(leader, witness_));
+  ASSERT_OK(BreakConnectivity(cluster_.get(), ServerIndex(leader), ServerIndex(lagging)));
+  ASSERT_OK(BreakConnectivity(cluster_.get(), ServerIndex(witness_), ServerIndex(lagging)));
+  auto lagging_index = lagging->consensus()->GetLastReceivedOpId().index;
+
+  for (int key = 1; key != kNumKeys; ++key) {
+    SetValue(session, key, ValueForKey(key), table_);
+  }
+  ASSERT_OK(WaitReplicated(leader, witness_));
+  ASSERT_OK(cluster_->FlushTablets());
+  ASSERT_OK(cluster_->CleanTabletLogs());
+
+  // The witness should keep the ops that the lagging voter has not received yet.
+  ASSERT_LE(witness_->consensus()->WitnessAllReplicatedIndex(), lagging_index);
+  ASSERT_LE(ASSERT_RESULT(witness_->GetEarliestNeededLogIndex()), lagging_index);
+  ASSERT_LE(witness_->log()->GetMinReplicateIndex(), lagging_index + 1);
+  ASSERT_GT(witness_->consensus()->GetLastCommittedOpId().index, lagging_index);
+
+  for (const auto& peer : {leader, witness_}) {
+    ASSERT_OK(SetupConnectivity(
+        cluster_.get(), ServerIndex(peer), ServerIndex(lagging), Connectivity::kOn));
+  }
+  ASSERT_OK(WaitReplicated(leader, lagging));
+  auto committed_index = leader->consensus()->GetLastCommittedOpId().index;
+  ASSERT_OK(WaitFor([this, committed_index] {
+    return witness_->consensus()->WitnessAllReplicatedIndex() >= committed_index;
+  }, 30s * kTimeMultiplier, "Wait witness to release log"));
+}
+
+TEST_F(QLTabletWitnessTest, HandsLeadershipToFullVoter) {
+  auto old_leader = ASSERT_RESULT(WaitForReadyLeader());
+  auto session = CreateSession();
+  SetValue(session, kKey, 1, table_);
+  ASSERT_OK(WaitReplicated(old_leader, witness_));
+  auto old_term = old_leader->consensus()->GetLastReceivedOpId().term;
+
+  ASSERT_OK(witness_->consensus()->StartElection(consensus::LeaderElectionData{
+      .mode = consensus::ElectionMode::ELECT_EVEN_IF_LEADER_IS_ALIVE,
+      .pending_commit = false,
+      .must_be_committed_opid = OpId()}));
+
+  // The witness wins the election, as it has all ops, and then steps down to a full voter.
+  ASSERT_OK(WaitFor([this, old_term] {
+    for (const auto& peer : full_voters_) {
+      if (peer->LeaderStatus() == consensus::LeaderStatus::LEADER_AND_READY &&
+          peer->consensus()->GetLastReceivedOpId().term > old_term) {
+        return true;
+      }
+    }
+    return false;
+  }, 30s * kTimeMultiplier, "Wait for new full voter leader"));
+  ASSERT_NE(witness_->consensus()->role(), PeerRole::LEADER);
+
+  SetValue(session, kKey, 2, table_);
+  ASSERT_EQ(GetValue(session, kKey, table_), 2);
+}
+
 void QLTabletTest::TestDeletePartialKey(int num_range_keys_in_delete) {
   YBSchemaBuilder builder;
   builder.AddColumn(kKeyColumn)->Type(INT32)->HashPrimaryKey()->NotNull();
@@ -44,6 +44,8 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -63,6 +65,7 @@ DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
+DECLARE_bool(enable_transaction_status_batching);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_disable_compactions);
@@ -73,8 +76,13 @@ DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
 DECLARE_uint64(aborted_intent_cleanup_ms);
 DECLARE_uint64(max_clock_skew_usec);
+DECLARE_uint64(transaction_intents_cache_max_bytes);
 DECLARE_uint64(transaction_heartbeat_usec);
 
+METRIC_DECLARE_counter(transaction_status_batcher_cache_hits);
+METRIC_DECLARE_counter(transaction_status_batcher_requests);
+METRIC_DECLARE_counter(transactions_applied_from_intents_cache);
+
 namespace yb {
 namespace client {
 
@@ -1045,6 +1053,126 @@ TEST_F(QLTransactionTest, ResolveIntentsCheckConsistency) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+TEST_F(QLTransactionTest, ResolveIntentsWithStatusBatching) {
+  constexpr int kKeys = 30;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_transaction_status_batching) = true;
+  SetAtomicFlag(0ULL, &FLAGS_max_clock_skew_usec); // To avoid read restart in this test.
+  DisableApplyingIntents();
+
+  auto sum_counters = [this](const CounterPrototype& prototype) {
+    int64_t result = 0;
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* server = cluster_->mini_tablet_server(i)->server();
+      result += prototype.Instantiate(server->metric_entity())->value();
+    }
+    return result;
+  };
+
+  {
+    auto session = CreateSession();
+    for (int key = 0; key != kKeys; ++key) {
+      ASSERT_OK(WriteRow(session, key, key));
+    }
+  }
+
+  auto txn1 = CreateTransaction();
+  {
+    auto session = CreateSession(txn1);
+    for (int key = 0; key != kKeys; ++key) {
+      ASSERT_OK(UpdateRow(session, key, key + 100));
+    }
+  }
+
+  // Intents of the pending transaction should be ignored by readers on all tablets. Pending status
+  // is not final, so it should never be served from the cache.
+  auto requests = sum_counters(METRIC_transaction_status_batcher_requests);
+  auto cache_hits = sum_counters(METRIC_transaction_status_batcher_cache_hits);
+  for (int iteration = 0; iteration != 2; ++iteration) {
+    auto session = CreateSession();
+    for (int key = 0; key != kKeys; ++key) {
+      VERIFY_ROW(session, key, key);
+    }
+  }
+  ASSERT_GT(sum_counters(METRIC_transaction_status_batcher_requests), requests);
+  ASSERT_EQ(sum_counters(METRIC_transaction_status_batcher_cache_hits), cache_hits);
+
+  CommitAndResetSync(&txn1);
+
+  // Every tablet resolves the same committed transaction. Once one of them has received the
+  // committed status, other tablets of the same tablet server get it from the cache.
+  requests = sum_counters(METRIC_transaction_status_batcher_requests);
+  for (int iteration = 0; iteration != 2; ++iteration) {
+    auto session = CreateSession();
+    for (int key = 0; key != kKeys; ++key) {
+      VERIFY_ROW(session, key, key + 100);
+    }
+  }
+  ASSERT_GT(sum_counters(METRIC_transaction_status_batcher_requests), requests);
+  ASSERT_GT(sum_counters(METRIC_transaction_status_batcher_cache_hits), cache_hits);
+}
+
+TEST_F(QLTransactionTest, ApplyFromIntentsCache) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_intents_cache_max_bytes) = 64_KB;
+
+  auto applied_from_cache = [this] {
+    int64_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      if (peer->TEST_table_type() == TableType::TRANSACTION_STATUS_TABLE_TYPE) {
+        continue;
+      }
+      result += METRIC_transactions_applied_from_intents_cache.Instantiate(
+          peer->tablet()->GetTabletMetricsEntity())->value();
+    }
+    return result;
+  };
+
+  std::vector<MemTrackerPtr> intents_cache_trackers;
+  for (const auto& tracker : MemTracker::ListTrackers()) {
+    if (tracker->id() == "intents_cache") {
+      intents_cache_trackers.push_back(tracker);
+    }
+  }
+  ASSERT_EQ(intents_cache_trackers.size(), cluster_->num_tablet_servers());
+  auto released = [&intents_cache_trackers] {
+    for (const auto& tracker : intents_cache_trackers) {
+      if (tracker->consumption() != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  WriteData();
+  VerifyData();
+  ASSERT_NO_FATALS(AssertNoRunningTransactions());
+  auto applied = applied_from_cache();
+  ASSERT_GT(applied, 0);
+  ASSERT_OK(WaitFor(released, 10s * kTimeMultiplier, "Release cached intents"));
+
+  // Intents of a transaction that does not fit into the server wide limit are applied from
+  // intents DB.
+  for (const auto& tracker : intents_cache_trackers) {
+    tracker->SetLimit(1);
+  }
+  WriteData(WriteOpType::UPDATE);
+  VerifyData(WriteOpType::UPDATE);
+  ASSERT_NO_FATALS(AssertNoRunningTransactions());
+  ASSERT_EQ(applied_from_cache(), applied);
+  ASSERT_OK(WaitFor(released, 10s * kTimeMultiplier, "Release cached intents"));
+
+  // Intents of a transaction that does not fit into the per transaction limit are applied from
+  // intents DB.
+  for (const auto& tracker : intents_cache_trackers) {
+    tracker->SetLimit(64_KB);
+  }
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_intents_cache_max_bytes) = 1;
+  WriteData(WriteOpType::UPDATE);
+  VerifyData(WriteOpType::UPDATE);
+  ASSERT_NO_FATALS(AssertNoRunningTransactions());
+  ASSERT_EQ(applied_from_cache(), applied);
+}
+
 // This test launches write thread, that writes increasing value to key using transaction.
 // Then it launches multiple read threads, each of them tries to read this key and
 // verifies that its value is at least the same like it was written before read was started.
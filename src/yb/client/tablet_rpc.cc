@@ -288,6 +288,7 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
       .status = STATUS(IllegalState, "Not the leader"),
       .time = CoarseMonoClock::now()
     });
+    ApplyLeaderHint(reason);
   } else {
     VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason
             << ", old replica: " << yb::ToString(current_ts_);
@@ -316,6 +317,30 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   return status;
 }
 
+void TabletInvoker::ApplyLeaderHint(const Status& status) {
+  auto leader_uuid = tserver::TabletServerLeaderHint::ValueFromStatus(status);
+  if (!leader_uuid || !tablet_) {
+    return;
+  }
+  for (auto* ts : tablet_->GetRemoteTabletServers()) {
+    if (ts->permanent_uuid() != *leader_uuid) {
+      continue;
+    }
+    // Hinted replica already rejected this request, so the hint is older than what we know.
+    if (followers_.count(ts)) {
+      return;
+    }
+    VLOG(1) << "Tablet " << tablet_id_ << ": Using leader hint " << ts->ToString()
+            << " from " << yb::ToString(current_ts_);
+    if (tablet_->MarkTServerAsLeader(ts)) {
+      return;
+    }
+  }
+  // Leader is not among the cached replicas, it will be picked up by the next master lookup.
+  VLOG(1) << "Tablet " << tablet_id_ << ": Leader hint " << *leader_uuid
+          << " is not a known replica: " << tablet_->ReplicasAsString();
+}
+
 bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
@@ -113,6 +113,10 @@ class TabletInvoker {
   Status FailToNewReplica(const Status& reason,
                           const tserver::TabletServerErrorPB* error_code = nullptr);
 
+  // Marks the leader reported along with a NOT_THE_LEADER error as the leader of the tablet, so
+  // the retry and all other requests that share the cached tablet go to it right away.
+  void ApplyLeaderHint(const Status& status);
+
   // Called when we finish a lookup (to find the new consensus leader). Retries
   // the rpc after a short delay.
   void LookupTabletCb(const Result<RemoteTabletPtr>& result);
@@ -334,6 +334,7 @@ class TableProperties {
     // Ignoring num_tablets_.
     // Ignoring retain_delete_markers_.
     // Ignoring partitioning_version_.
+    // Ignoring follower_read_leases_.
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -359,6 +360,7 @@ class TableProperties {
     // Ignoring contain_counters_.
     // Ignoring retain_delete_markers_.
     // Ignoring partitioning_version_.
+    // Ignoring follower_read_leases_.
     return true;
   }
 
@@ -434,6 +436,14 @@ class TableProperties {
     retain_delete_markers_ = retain_delete_markers;
   }
 
+  bool follower_read_leases() const {
+    return follower_read_leases_;
+  }
+
+  void SetFollowerReadLeases(bool follower_read_leases) {
+    follower_read_leases_ = follower_read_leases;
+  }
+
   uint32_t partitioning_version() const {
     return partitioning_version_;
   }
@@ -466,6 +476,7 @@ class TableProperties {
   int num_tablets_;
   bool is_ysql_catalog_table_;
   uint32_t partitioning_version_;
+  bool follower_read_leases_;
 };
 
 typedef std::string PgSchemaName;
@@ -333,6 +333,16 @@ class Consensus {
       const yb::OpId& from, int64_t* repl_index, const CoarseTimePoint deadline,
       const bool fetch_single_entry = false) = 0;
 
+  // Registers a waiter that is invoked with OK once an operation with index greater than `index`
+  // is committed, or with an error when this peer stops being the leader or shuts down. Used by
+  // CDC producer to long poll for new changes without blocking a thread.
+  // Returns 0 without registering the waiter when such an operation is already committed or this
+  // peer is not the leader. Otherwise returns an id for RemoveCommittedOpIdWaiter.
+  virtual uint64_t RegisterCommittedOpIdWaiter(int64_t index, CommittedOpIdWaiter waiter) = 0;
+
+  // Removes the waiter without invoking it. Returns false if the waiter was already invoked.
+  virtual bool RemoveCommittedOpIdWaiter(uint64_t id) = 0;
+
   virtual void UpdateCDCConsumerOpId(const yb::OpId& op_id) = 0;
 
  protected:
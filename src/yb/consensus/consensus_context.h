@@ -51,6 +51,10 @@ class ConsensusContext {
   // Returns the current safe time, so we can send it from leaders to followers.
   virtual Result<HybridTime> PreparePeerRequest() = 0;
 
+  // Whether the leader should grant read leases to followers, see
+  // TablePropertiesPB::follower_read_leases.
+  virtual bool FollowerReadLeasesEnabled() = 0;
+
   // This is called every time majority-replicated watermarks (OpId / leader leases) change. This is
   // used for updating the "propagated safe time" value in MvccManager and unblocking readers
   // waiting for it to advance.
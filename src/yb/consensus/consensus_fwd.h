@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <type_traits>
 
@@ -22,6 +23,7 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/math_util.h"
+#include "yb/util/status_fwd.h"
 #include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
@@ -46,6 +48,7 @@ struct ConsensusBootstrapInfo;
 struct LeaderState;
 struct ReadOpsResult;
 struct RetryableRequestsCounts;
+struct SentRequestInfo;
 struct StateChangeContext;
 
 class ConsensusRound;
@@ -66,6 +69,9 @@ using MultiRaftHeartbeatBatcherPtr = std::shared_ptr<MultiRaftHeartbeatBatcher>;
 
 struct LeaderElectionData;
 
+// Invoked once a committed op id waiter is satisfied, see Consensus::RegisterCommittedOpIdWaiter.
+using CommittedOpIdWaiter = std::function<void(const Status&)>;
+
 // The elected Leader (this peer) can be in not-ready state because it's not yet synced.
 // The state reflects the real leader status: not-leader, leader-not-ready, leader-ready.
 // Not-ready status means that the leader is not ready to serve up-to-date read requests.
@@ -84,6 +90,7 @@ using ReplicateMsgs = std::vector<ReplicateMsgPtr>;
 
 YB_STRONGLY_TYPED_BOOL(TEST_SuppressVoteRequest);
 YB_STRONGLY_TYPED_BOOL(PreElection);
+YB_STRONGLY_TYPED_BOOL(Pipelined);
 
 } // namespace consensus
 
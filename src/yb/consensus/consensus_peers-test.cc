@@ -59,6 +59,8 @@ using namespace std::chrono_literals;
 
 METRIC_DECLARE_entity(tablet);
 
+DECLARE_uint32(consensus_max_in_flight_requests_per_peer);
+
 namespace yb {
 namespace consensus {
 
@@ -195,10 +197,6 @@ TEST_F(ConsensusPeersTest, TestRemotePeer) {
   // Append a bunch of messages to the queue.
   AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1, 20);
 
-  // The above append ends up appending messages in term 2, so we update the peer's term to match.
-  ThreadSafeArena arena;
-  remote_peer->TEST_SetTerm(2, &arena);
-
   // signal the peer there are requests pending.
   ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
 
@@ -209,6 +207,31 @@ TEST_F(ConsensusPeersTest, TestRemotePeer) {
   CheckLastRemoteEntry(proxy, 2, 20);
 }
 
+// Same as above, but ops are appended in several batches and sent without waiting for the
+// responses to the previous requests.
+TEST_F(ConsensusPeersTest, TestPipelinedRemotePeer) {
+  FLAGS_consensus_max_in_flight_requests_per_peer = 4;
+
+  std::shared_ptr<Peer> remote_peer;
+  auto se = ScopeExit([&remote_peer] {
+    // This guarantees that the Peer object doesn't get destroyed if there is a pending request.
+    remote_peer->Close();
+  });
+
+  DelayablePeerProxy<NoOpTestPeerProxy>* proxy = NewRemotePeer(kFollowerUuid, &remote_peer);
+
+  constexpr int64_t kBatchSize = 5;
+  constexpr int64_t kNumBatches = 4;
+  for (int64_t batch = 0; batch != kNumBatches; ++batch) {
+    AppendReplicateMessagesToQueue(message_queue_.get(), clock_, 1 + batch * kBatchSize,
+                                   kBatchSize);
+    ASSERT_OK(remote_peer->SignalRequest(RequestTriggerMode::kNonEmptyOnly));
+  }
+
+  consensus_->WaitForMajorityReplicatedIndex(kBatchSize * kNumBatches);
+  CheckLastRemoteEntry(proxy, 2, kBatchSize * kNumBatches);
+}
+
 TEST_F(ConsensusPeersTest, TestLocalAppendAndRemotePeerDelay) {
   // Create a set of remote peers.
   std::shared_ptr<Peer> remote_peer1;
@@ -83,9 +83,26 @@ DEFINE_UNKNOWN_int32(max_wait_for_processresponse_before_closing_ms,
              "finish before returning proceding to close the Peer and return");
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
+DEFINE_NON_RUNTIME_uint32(consensus_max_in_flight_requests_per_peer, 1,
+                          "Max number of UpdateConsensus requests the leader could have in flight "
+                          "to a single follower. With values greater than 1, new ops are sent to "
+                          "the follower without waiting for the responses to the previous "
+                          "requests.");
+TAG_FLAG(consensus_max_in_flight_requests_per_peer, advanced);
+
+DEFINE_NON_RUNTIME_int32(closed_timestamp_propagation_interval_ms, 0,
+                         "If positive and less than raft_heartbeat_interval_ms, the leader sends "
+                         "its safe time, i.e. the closed timestamp, to followers at this interval "
+                         "even when the tablet is idle, so followers could serve bounded staleness "
+                         "reads with staleness close to this interval. Such requests always go "
+                         "through the multi Raft heartbeat batcher, so the flag has effect only "
+                         "with enable_multi_raft_heartbeat_batcher.");
+TAG_FLAG(closed_timestamp_propagation_interval_ms, advanced);
+
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_bool(enable_multi_raft_vote_batching);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -114,6 +131,15 @@ using rpc::Messenger;
 using rpc::PeriodicTimer;
 using strings::Substitute;
 
+struct Peer::UpdateCall {
+  ThreadSafeArena arena;
+  LWConsensusRequestPB* request = nullptr;
+  LWConsensusResponsePB* response = nullptr;
+  rpc::RpcController controller;
+  SentRequestInfo sent;
+  bool done = false;
+};
+
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, MultiRaftHeartbeatBatcherPtr multi_raft_batcher,
@@ -123,16 +149,13 @@ Peer::Peer(
       peer_pb_(peer_pb),
       proxy_(std::move(proxy)),
       queue_(queue),
+      max_in_flight_calls_(std::max<uint32_t>(FLAGS_consensus_max_in_flight_requests_per_peer, 1)),
+      last_request_committed_index_(kMinimumOpIdIndex),
       multi_raft_batcher_(std::move(multi_raft_batcher)),
       raft_pool_token_(raft_pool_token),
       consensus_(consensus),
       messenger_(messenger) {}
 
-void Peer::TEST_SetTerm(int term, ThreadSafeArena* arena) {
-  update_response_ = arena->NewObject<LWConsensusResponsePB>(arena);
-  update_response_->set_responder_term(term);
-}
-
 Status Peer::Init() {
   std::lock_guard<simple_spinlock> lock(peer_lock_);
   queue_->TrackPeer(peer_pb_);
@@ -148,6 +171,24 @@ Status Peer::Init() {
       },
       MonoDelta::FromMilliseconds(FLAGS_raft_heartbeat_interval_ms));
   heartbeater_->Start();
+  if (FLAGS_closed_timestamp_propagation_interval_ms > 0 &&
+      FLAGS_closed_timestamp_propagation_interval_ms < FLAGS_raft_heartbeat_interval_ms &&
+      multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher) {
+    closed_timestamp_sender_ = PeriodicTimer::Create(
+        messenger_,
+        [weak_peer]() {
+          // The flag could be turned off after the peer was started, then every request would be
+          // a separate RPC, so closed timestamps are only propagated by regular heartbeats.
+          if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
+            return;
+          }
+          if (auto p = weak_peer.lock()) {
+            Status s = p->SignalRequest(RequestTriggerMode::kAlwaysSend);
+          }
+        },
+        MonoDelta::FromMilliseconds(FLAGS_closed_timestamp_propagation_interval_ms));
+    closed_timestamp_sender_->Start();
+  }
   state_ = kPeerStarted;
   return Status::OK();
 }
@@ -166,6 +207,15 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
       return STATUS(IllegalState, "Peer was closed.");
     }
 
+    // If the window is full, the next request is sent when a response is received.
+    if (in_flight_calls_.size() >= max_in_flight_calls_) {
+      performing_update_lock.unlock();
+      return Status::OK();
+    }
+    if (std::exchange(send_requested_, false)) {
+      trigger_mode = RequestTriggerMode::kAlwaysSend;
+    }
+
     // For the first request sent by the peer, we send it even if the queue is empty, which it will
     // always appear to be for the first request, since this is the negotiation round.
     if (PREDICT_FALSE(state_ == kPeerStarted)) {
@@ -183,6 +233,7 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
     // something like exponential backoff after an error. As it is implemented today, any transient
     // error will result in a latency blip as long as the heartbeat period.
     if (failed_attempts_ > 0 && trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      performing_update_lock.unlock();
       return Status::OK();
     }
 
@@ -201,30 +252,46 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   auto retain_self = shared_from_this();
   DCHECK(performing_update_mutex_.is_locked()) << "Cannot send request";
 
-  auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
   auto processing_lock = StartProcessingUnlocked();
+  // Declared after processing_lock, so it is released first. See send_requested_.
+  auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
   if (!processing_lock.owns_lock()) {
     return;
   }
 
-  int64_t commit_index_before = update_request_ && update_request_->has_committed_op_id() ?
-      update_request_->committed_op_id().index() : kMinimumOpIdIndex;
+  // send_requested_ is kept when the request is not sent, so it is picked up when an in-flight
+  // call completes.
+  if (in_flight_calls_.size() >= max_in_flight_calls_) {
+    return;
+  }
+  const Pipelined pipelined(!in_flight_calls_.empty());
+  if (pipelined && failed_attempts_ > 0) {
+    return;
+  }
+  if (std::exchange(send_requested_, false)) {
+    trigger_mode = RequestTriggerMode::kAlwaysSend;
+  }
+
+  int64_t commit_index_before = last_request_committed_index_;
 
-  arena_.Reset(ResetMode::kKeepFirst);
-  update_request_ = arena_.NewObject<LWConsensusRequestPB>(&arena_);
-  update_response_ = arena_.NewObject<LWConsensusResponsePB>(&arena_);
+  auto call = AcquireCall();
+  auto release_call = ScopeExit([this, &call] {
+    if (call) {
+      ReleaseCall(std::move(call));
+    }
+  });
 
-  // The peer has no pending request nor is sending: send the request.
+  // The window is not full: send the request.
   bool needs_remote_bootstrap = false;
   bool last_exchange_successful = false;
   PeerMemberType member_type = PeerMemberType::UNKNOWN_MEMBER_TYPE;
   LWReplicateMsgsHolder msgs_holder;
-  std::vector<std::shared_ptr<ThreadSafeArena>> msg_arenas;
   Status s = queue_->RequestForPeer(
-      peer_pb_.permanent_uuid(), update_request_, &msgs_holder, &needs_remote_bootstrap,
-      &member_type, &last_exchange_successful);
-  int64_t commit_index_after = update_request_->has_committed_op_id() ?
-      update_request_->committed_op_id().index() : kMinimumOpIdIndex;
+      peer_pb_.permanent_uuid(), call->request, &msgs_holder, &needs_remote_bootstrap,
+      &member_type, &last_exchange_successful, pipelined, &call->sent);
+  int64_t commit_index_after = call->request->has_committed_op_id() ?
+      call->request->committed_op_id().index() : kMinimumOpIdIndex;
+  last_request_committed_index_ = commit_index_after;
 
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX(INFO) << "Could not obtain request from queue for peer: " << s;
@@ -264,8 +331,9 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     if (PREDICT_TRUE(consensus_)) {
       auto uuid = peer_pb_.permanent_uuid();
       // Remove these here, before we drop the locks.
-      processing_lock.unlock();
+      ReleaseCall(std::move(call));
       performing_update_lock.unlock();
+      processing_lock.unlock();
       consensus::ChangeConfigRequestPB req;
       consensus::ChangeConfigResponsePB resp;
 
@@ -294,15 +362,22 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     }
   }
 
-  if (update_request_->tablet_id().empty()) {
-    update_request_->ref_tablet_id(tablet_id_);
-    update_request_->ref_caller_uuid(leader_uuid_);
-    update_request_->ref_dest_uuid(peer_pb_.permanent_uuid());
+  auto* request = call->request;
+  if (request->tablet_id().empty()) {
+    request->ref_tablet_id(tablet_id_);
+    request->ref_caller_uuid(leader_uuid_);
+    request->ref_dest_uuid(peer_pb_.permanent_uuid());
   }
 
-  const bool req_is_heartbeat = update_request_->ops().empty() &&
+  const bool req_is_heartbeat = request->ops().empty() &&
                                 commit_index_after <= commit_index_before;
 
+  // Status-only requests are not pipelined, the response to the request in flight brings the
+  // peer status anyway.
+  if (pipelined && req_is_heartbeat) {
+    return;
+  }
+
   // If the queue is empty, check if we were told to send a status-only message (which is what
   // happens during heartbeats). If not, just return.
   if (PREDICT_FALSE(req_is_heartbeat && trigger_mode == RequestTriggerMode::kNonEmptyOnly)) {
@@ -313,6 +388,9 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // If we're actually sending ops there's no need to heartbeat for a while, reset the heartbeater.
   if (!req_is_heartbeat) {
     heartbeater_->Snooze();
+    if (closed_timestamp_sender_) {
+      closed_timestamp_sender_->Snooze();
+    }
   }
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
@@ -329,11 +407,12 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
     }
 
     // TODO(lw_uc) support multiraft heartbeat with LW
-    update_request_->ToGoogleProtobuf(&heartbeat_request_);
-    update_response_->ToGoogleProtobuf(&heartbeat_response_);
+    request->ToGoogleProtobuf(&heartbeat_request_);
+    call->response->ToGoogleProtobuf(&heartbeat_response_);
     cur_heartbeat_id_++;
-    processing_lock.unlock();
+    ReleaseCall(std::move(call));
     performing_update_lock.unlock();
+    processing_lock.unlock();
     performing_heartbeat_lock.release();
     multi_raft_batcher_->AddRequestToBatch(
         &heartbeat_request_, &heartbeat_response_,
@@ -349,11 +428,47 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // and this new request in the same order they were received by the remote peer.
   // TODO: Remove batched but unsent heartbeats (in the respective MultiRaftBatcher) in this case
   minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
+  const bool has_ops = !request->ops().empty();
+  auto* call_ptr = call.get();
+  call_ptr->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  in_flight_calls_.push_back(std::move(call));
+  processing_lock.unlock();
+  proxy_->UpdateAsync(request, trigger_mode, call_ptr->response, &call_ptr->controller,
+                      std::bind(&Peer::ProcessResponse, retain_self, call_ptr));
+
+  processing_lock.lock();
+  if (state_ == kPeerClosed) {
+    return;
+  }
+  // Pipeline the ops that were appended after this request was built, if the window allows.
+  if (!send_requested_ && (!has_ops || max_in_flight_calls_ == 1)) {
+    return;
+  }
   processing_lock.unlock();
   performing_update_lock.release();
-  controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
-  proxy_->UpdateAsync(update_request_, trigger_mode, update_response_, &controller_,
-                      std::bind(&Peer::ProcessResponse, retain_self));
+  SendNextRequest(RequestTriggerMode::kNonEmptyOnly);
+}
+
+std::unique_ptr<Peer::UpdateCall> Peer::AcquireCall() {
+  std::unique_ptr<UpdateCall> call;
+  if (free_calls_.empty()) {
+    call = std::make_unique<UpdateCall>();
+  } else {
+    call = std::move(free_calls_.back());
+    free_calls_.pop_back();
+    call->arena.Reset(ResetMode::kKeepFirst);
+  }
+  call->request = call->arena.NewObject<LWConsensusRequestPB>(&call->arena);
+  call->response = call->arena.NewObject<LWConsensusResponsePB>(&call->arena);
+  call->done = false;
+  return call;
+}
+
+void Peer::ReleaseCall(std::unique_ptr<UpdateCall> call) {
+  if (free_calls_.size() < max_in_flight_calls_) {
+    call->controller.Reset();
+    free_calls_.push_back(std::move(call));
+  }
 }
 
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
@@ -367,7 +482,8 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
 }
 
 bool Peer::ProcessResponseWithStatus(const Status& status,
-                                     LWConsensusResponsePB* response) {
+                                     LWConsensusResponsePB* response,
+                                     const SentRequestInfo* sent_request) {
   if (!status.ok()) {
     if (status.IsRemoteError()) {
       // Most controller errors are caused by network issues or corner cases like shutdown and
@@ -431,29 +547,42 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
   }
 
   failed_attempts_ = 0;
-  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response);
+  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response, sent_request);
 }
 
-void Peer::ProcessResponse() {
-  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
-  auto status = controller_.status();
-  if (status.ok()) {
-    status = controller_.thread_pool_failure();
-  }
-  controller_.Reset();
-
-  auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
+void Peer::ProcessResponse(UpdateCall* call) {
   auto processing_lock = StartProcessingUnlocked();
   if (!processing_lock.owns_lock()) {
     return;
   }
-  bool more_pending = ProcessResponseWithStatus(status, update_response_);
+  call->done = true;
+
+  // Responses are processed in the order the requests were sent, so the queue observes the peer
+  // state in the same order as the peer did.
+  bool more_pending = false;
+  while (!in_flight_calls_.empty() && in_flight_calls_.front()->done) {
+    auto front = std::move(in_flight_calls_.front());
+    in_flight_calls_.pop_front();
+    auto status = front->controller.status();
+    if (status.ok()) {
+      status = front->controller.thread_pool_failure();
+    }
+    more_pending = ProcessResponseWithStatus(status, front->response, &front->sent);
+    ReleaseCall(std::move(front));
+  }
 
-  if (more_pending) {
-    processing_lock.unlock();
-    performing_update_lock.release();
-    SendNextRequest(RequestTriggerMode::kAlwaysSend);
+  // A request could have been asked for while the window was full.
+  if (!more_pending && !send_requested_) {
+    return;
+  }
+  auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
+  if (!performing_update_lock.owns_lock()) {
+    send_requested_ = true;
+    return;
   }
+  processing_lock.unlock();
+  performing_update_lock.release();
+  SendNextRequest(RequestTriggerMode::kAlwaysSend);
 }
 
 void Peer::ProcessHeartbeatResponse(const Status& status) {
@@ -481,6 +610,7 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
   if (more_pending) {
     auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
     if (!performing_update_lock.owns_lock()) {
+      send_requested_ = true;
       return;
     }
     performing_heartbeat_lock.unlock();
@@ -531,7 +661,9 @@ void Peer::ProcessRemoteBootstrapResponse() {
 }
 
 void Peer::ProcessResponseError(const Status& status) {
-  DCHECK(performing_update_mutex_.is_locked() || performing_heartbeat_mutex_.is_locked());
+  // Responses to update requests are processed without performing_update_mutex_, since several
+  // requests could be in flight, so peer_lock_ is what serializes them.
+  DCHECK(peer_lock_.is_locked());
   failed_attempts_++;
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5) << "Couldn't send request. "
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
@@ -548,6 +680,9 @@ void Peer::Close() {
   if (heartbeater_) {
     heartbeater_->Stop();
   }
+  if (closed_timestamp_sender_) {
+    closed_timestamp_sender_->Stop();
+  }
 
   // If the peer is already closed return.
   {
@@ -583,8 +718,10 @@ Peer::~Peer() {
   CHECK_EQ(state_, kPeerClosed) << "Peer cannot be implicitly closed";
 }
 
-RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy)
-    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)) {
+RpcPeerProxy::RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+                           MultiRaftHeartbeatBatcherPtr multi_raft_batcher)
+    : hostport_(std::move(hostport)), consensus_proxy_(std::move(consensus_proxy)),
+      multi_raft_batcher_(std::move(multi_raft_batcher)) {
 }
 
 void RpcPeerProxy::UpdateAsync(const LWConsensusRequestPB* request,
@@ -600,6 +737,10 @@ void RpcPeerProxy::RequestConsensusVoteAsync(const VoteRequestPB* request,
                                              VoteResponsePB* response,
                                              rpc::RpcController* controller,
                                              const rpc::ResponseCallback& callback) {
+  if (multi_raft_batcher_ && FLAGS_enable_multi_raft_vote_batching) {
+    multi_raft_batcher_->AddVoteRequestToBatch(*request, response, controller->timeout(), callback);
+    return;
+  }
   consensus_proxy_->RequestConsensusVoteAsync(*request, response, controller, callback);
 }
 
@@ -628,13 +769,20 @@ void RpcPeerProxy::StartRemoteBootstrap(const StartRemoteBootstrapRequestPB* req
 RpcPeerProxy::~RpcPeerProxy() {}
 
 RpcPeerProxyFactory::RpcPeerProxyFactory(
-    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from)
-    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)) {}
+    Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+    MultiRaftManager* multi_raft_manager)
+    : messenger_(messenger), proxy_cache_(proxy_cache), from_(std::move(from)),
+      multi_raft_manager_(multi_raft_manager) {}
 
 PeerProxyPtr RpcPeerProxyFactory::NewProxy(const RaftPeerPB& peer_pb) {
   auto hostport = HostPortFromPB(DesiredHostPort(peer_pb, from_));
   auto proxy = std::make_unique<ConsensusServiceProxy>(proxy_cache_, hostport);
-  return std::make_unique<RpcPeerProxy>(std::move(hostport), std::move(proxy));
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher;
+  if (multi_raft_manager_ && FLAGS_enable_multi_raft_vote_batching) {
+    multi_raft_batcher = multi_raft_manager_->AddOrGetBatcher(peer_pb);
+  }
+  return std::make_unique<RpcPeerProxy>(
+      std::move(hostport), std::move(proxy), std::move(multi_raft_batcher));
 }
 
 RpcPeerProxyFactory::~RpcPeerProxyFactory() {}
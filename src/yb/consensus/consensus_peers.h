@@ -37,6 +37,7 @@
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <deque>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -109,12 +110,12 @@ namespace consensus {
 //                                 processing = true
 //                                 - get reqs. from queue
 //                                 - update peer async
+//                                 processing = false
 //                                 return
 //
 //                         +
 //                         |
 //      ProcessResponse()  |
-//      processing = false |
 //                         v
 //               +------------------+
 //        +------+   more pending?  +-----+
@@ -125,6 +126,9 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// Up to consensus_max_in_flight_requests_per_peer update requests could be in flight to the peer.
+// While the window is not full, requests with new ops are sent without waiting for the responses
+// to the previous ones. Responses are processed in the order the requests were sent.
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -158,8 +162,6 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // the ThreadPoolToken.
   void Close();
 
-  void TEST_SetTerm(int term, ThreadSafeArena* arena);
-
   ~Peer();
 
   // Creates a new remote peer and makes the queue track it.'
@@ -180,18 +182,25 @@ class Peer : public std::enable_shared_from_this<Peer> {
   }
 
  private:
+  struct UpdateCall;
+
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
   // Signals that a response was received from the peer. This method does response handling that
   // requires IO or may block.
-  void ProcessResponse();
+  void ProcessResponse(UpdateCall* call);
 
   // Signals that a heartbeat response was received from the peer.
   void ProcessHeartbeatResponse(const Status& status);
 
   // Returns true if there are more pending ops to process, false otherwise.
   bool ProcessResponseWithStatus(const Status& status,
-                                 LWConsensusResponsePB* response);
+                                 LWConsensusResponsePB* response,
+                                 const SentRequestInfo* sent_request = nullptr);
+
+  // Returns an unused update call, reusing a finished one if possible. Requires peer_lock_.
+  std::unique_ptr<UpdateCall> AcquireCall();
+  void ReleaseCall(std::unique_ptr<UpdateCall> call);
 
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
@@ -233,10 +242,23 @@ class Peer : public std::enable_shared_from_this<Peer> {
   PeerMessageQueue* queue_;
   uint64_t failed_attempts_ = 0;
 
-  // The latest consensus update request and response stored in arena_.
-  ThreadSafeArena arena_;
-  LWConsensusRequestPB* update_request_ = nullptr;
-  LWConsensusResponsePB* update_response_ = nullptr;
+  // Max number of update calls in flight to the peer.
+  const size_t max_in_flight_calls_;
+
+  // Update calls in flight, in the order they were sent. Protected by peer_lock_.
+  std::deque<std::unique_ptr<UpdateCall>> in_flight_calls_;
+
+  // Finished update calls, kept to reuse their arenas. Protected by peer_lock_.
+  std::vector<std::unique_ptr<UpdateCall>> free_calls_;
+
+  // Committed op index in the latest update request obtained from the queue.
+  int64_t last_request_committed_index_;
+
+  // Set when a response asked for the next request while performing_update_mutex_ was held by
+  // another thread. The holder sends the next request regardless of its trigger mode then. Cleared
+  // only when a request is sent, if the window is full it is handled when a response is received.
+  // Protected by peer_lock_.
+  bool send_requested_ = false;
 
   // Latest heartbeat request and response
   ConsensusRequestPB heartbeat_request_;
@@ -257,8 +279,10 @@ class Peer : public std::enable_shared_from_this<Peer> {
 
   rpc::RpcController controller_;
 
-  // Held if there is an outstanding request.  This is used in order to ensure that we only have a
-  // single request outstanding at a time, and to wait for the outstanding requests at Close().
+  // Held while the next request is prepared and sent, or while a remote bootstrap request is
+  // outstanding. This is used in order to ensure that requests are built one at a time, in the
+  // order of the ops they contain. It is released before peer_lock_, so a thread that fails to
+  // acquire it while holding peer_lock_ could rely on send_requested_ being checked by the holder.
   AtomicTryMutex performing_update_mutex_;
 
   // Held if there is an outstanding heartbeat request.
@@ -270,6 +294,11 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // peers whenever we go more than 'FLAGS_raft_heartbeat_interval_ms' without sending actual data.
   std::shared_ptr<rpc::PeriodicTimer> heartbeater_;
 
+  // Sends status only requests, that carry the leader safe time, every
+  // 'FLAGS_closed_timestamp_propagation_interval_ms' when it is set. Such requests are batched
+  // across tablets by 'multi_raft_batcher_'.
+  std::shared_ptr<rpc::PeriodicTimer> closed_timestamp_sender_;
+
   // Batcher that currently batches heartbeat requests that are sent by each consensus peer
   // on a per tserver level
   MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
@@ -355,7 +384,8 @@ class PeerProxyFactory {
 // PeerProxy implementation that does RPC calls
 class RpcPeerProxy : public PeerProxy {
  public:
-  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy);
+  RpcPeerProxy(HostPort hostport, ConsensusServiceProxyPtr consensus_proxy,
+               MultiRaftHeartbeatBatcherPtr multi_raft_batcher = nullptr);
 
   virtual void UpdateAsync(const LWConsensusRequestPB* request,
                            RequestTriggerMode trigger_mode,
@@ -388,12 +418,15 @@ class RpcPeerProxy : public PeerProxy {
  private:
   HostPort hostport_;
   ConsensusServiceProxyPtr consensus_proxy_;
+  // When set, vote requests are sent in batches with requests of other tablets.
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
 };
 
 // PeerProxyFactory implementation that generates RPCPeerProxies
 class RpcPeerProxyFactory : public PeerProxyFactory {
  public:
-  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from);
+  RpcPeerProxyFactory(rpc::Messenger* messenger, rpc::ProxyCache* proxy_cache, CloudInfoPB from,
+                      MultiRaftManager* multi_raft_manager = nullptr);
 
   PeerProxyPtr NewProxy(const RaftPeerPB& peer_pb) override;
 
@@ -405,6 +438,7 @@ class RpcPeerProxyFactory : public PeerProxyFactory {
   rpc::Messenger* messenger_ = nullptr;
   rpc::ProxyCache* const proxy_cache_;
   const CloudInfoPB from_;
+  MultiRaftManager* const multi_raft_manager_;
 };
 
 // Query the consensus service at last known host/port that is specified in 'remote_peer' and set
@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <future>
+
 #include <gtest/gtest.h>
 
 #include "yb/common/schema.h"
@@ -55,6 +57,8 @@
 
 using std::string;
 
+using namespace std::literals;
+
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_uint64(consensus_max_batch_size_bytes);
 
@@ -105,7 +109,7 @@ class ConsensusQueueTest : public YBTest {
     CloseAndReopenQueue();
   }
 
-  void CloseAndReopenQueue() {
+  void CloseAndReopenQueue(const RaftPeerPB& local_peer_pb = FakeRaftPeerPB(kLeaderUuid)) {
     // Blow away the memtrackers before creating the new queue.
     queue_.reset();
     auto token = raft_pool_->NewToken(ThreadPool::ExecutionMode::SERIAL);
@@ -113,7 +117,7 @@ class ConsensusQueueTest : public YBTest {
                                       log_.get(),
                                       nullptr /* server_tracker */,
                                       nullptr /* parent_tracker */,
-                                      FakeRaftPeerPB(kLeaderUuid),
+                                      local_peer_pb,
                                       kTestTablet,
                                       clock_,
                                       nullptr /* consensus_context */,
@@ -361,6 +365,71 @@ TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
   ASSERT_FALSE(queue_->ResponseFromPeer(response.responder_uuid().ToBuffer(), response));
 }
 
+// Tests that a rejection of a pipelined request, that reached the peer before its predecessor, does
+// not move the peer back once the predecessor is acked. While other rejections still do.
+TEST_F(ConsensusQueueTest, TestOvertakenPipelinedRequestRejection) {
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+  queue_->TrackPeer(kPeerUuid);
+
+  ThreadSafeArena arena;
+  LWReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  auto& request1 = *arena.NewObject<LWConsensusRequestPB>(&arena);
+  auto& request2 = *arena.NewObject<LWConsensusRequestPB>(&arena);
+  SentRequestInfo sent1;
+  SentRequestInfo sent2;
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 50);
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &request1, &refs, &needs_remote_bootstrap, nullptr, nullptr, Pipelined::kFalse,
+      &sent1));
+  ASSERT_EQ(50, request1.ops().size());
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 51, 50);
+  LWReplicateMsgsHolder refs2;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &request2, &refs2, &needs_remote_bootstrap, nullptr, nullptr, Pipelined::kTrue,
+      &sent2));
+  ASSERT_EQ(50, request2.ops().size());
+  ASSERT_EQ(sent2.preceding_id, MakeOpIdForIndex(50));
+
+  // The peer processes request2 first and rejects it, then accepts request1. The responses are
+  // processed in the order the requests were sent.
+  auto& response1 = *arena.NewObject<LWConsensusResponsePB>(&arena);
+  response1.ref_responder_uuid(kPeerUuid);
+  SetLastReceivedAndLastCommitted(&response1, MakeOpIdForIndex(50), 0);
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response1, &sent1));
+
+  auto& response2 = *arena.NewObject<LWConsensusResponsePB>(&arena);
+  response2.ref_responder_uuid(kPeerUuid);
+  RefuseWithLogPropertyMismatch(&response2, OpId::Min(), OpId::Min());
+  response2.mutable_status()->set_last_committed_idx(0);
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response2, &sent2));
+
+  auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(peer.last_received, MakeOpIdForIndex(50));
+  ASSERT_EQ(peer.next_index, 51);
+
+  // Rejection of a request that was not pipelined is handled as usual.
+  request1.Clear();
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &request1, &refs, &needs_remote_bootstrap, nullptr, nullptr, Pipelined::kFalse,
+      &sent1));
+  ASSERT_EQ(sent1.preceding_id, MakeOpIdForIndex(50));
+  response1.Clear();
+  response1.ref_responder_uuid(kPeerUuid);
+  RefuseWithLogPropertyMismatch(&response1, MakeOpIdForIndex(20), OpId::Min());
+  response1.mutable_status()->set_last_committed_idx(0);
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response1, &sent1));
+
+  auto rejected_peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(rejected_peer.last_received, MakeOpIdForIndex(20));
+  ASSERT_EQ(rejected_peer.next_index, 21);
+}
+
 TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   queue_->Init(OpId::Min());
   queue_->SetLeaderMode(
@@ -897,6 +966,63 @@ TEST_F(ConsensusQueueTest, TestTriggerRemoteBootstrapIfTabletNotFound) {
             rb_req.bootstrap_source_private_addr()[0].ShortDebugString());
 }
 
+// Tests that a witness leader does not offer itself as a remote bootstrap source, and picks a full
+// voter instead once one is caught up.
+TEST_F(ConsensusQueueTest, TestWitnessLeaderDoesNotBootstrapFromItself) {
+  auto local_peer_pb = FakeRaftPeerPB(kLeaderUuid);
+  local_peer_pb.set_witness(true);
+  queue_->Close();
+  CloseAndReopenQueue(local_peer_pb);
+
+  static const char* kFullPeerUuid = "peer-2";
+  auto config = BuildRaftConfigPBForTests(3);
+  config.mutable_peers(0)->set_witness(true);
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(OpId::Min(), OpId::Min().term, OpId::Min(), config);
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, 100);
+  WaitForLocalPeerToAckIndex(100);
+
+  ThreadSafeArena arena;
+  LWConsensusRequestPB request(&arena);
+  LWConsensusResponsePB response(&arena);
+  LWReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  queue_->TrackPeer(kPeerUuid);
+  queue_->TrackPeer(kFullPeerUuid);
+
+  // Peer responds with tablet not found, so it needs remote bootstrap.
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  response.ref_responder_uuid(kPeerUuid);
+  response.mutable_error()->set_code(tserver::TabletServerErrorPB::TABLET_NOT_FOUND);
+  StatusToPB(STATUS(NotFound, "No such tablet"), response.mutable_error()->mutable_status());
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response));
+  request.Clear();
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_TRUE(needs_remote_bootstrap);
+
+  // No full replica has the data yet, so there is no bootstrap source.
+  StartRemoteBootstrapRequestPB rb_req;
+  auto status = queue_->GetRemoteBootstrapRequestForPeer(kPeerUuid, &rb_req);
+  ASSERT_TRUE(status.IsIllegalState()) << status;
+
+  // The full voter replicates and applies everything.
+  request.Clear();
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kFullPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  response.Clear();
+  SetLastReceivedAndLastCommitted(
+      &response, MakeOpIdForIndex(100), MakeOpIdForIndex(100).index);
+  response.ref_responder_uuid(kFullPeerUuid);
+  MakeOpIdForIndex(100).ToPB(response.mutable_status()->mutable_last_applied());
+  queue_->ResponseFromPeer(kFullPeerUuid, response);
+
+  rb_req.Clear();
+  ASSERT_OK(queue_->GetRemoteBootstrapRequestForPeer(kPeerUuid, &rb_req));
+  ASSERT_EQ(kFullPeerUuid, rb_req.bootstrap_source_peer_uuid());
+}
+
 // Tests that ReadReplicatedMessagesForCDC() only reads messages until the last known
 // committed index.
 TEST_F(ConsensusQueueTest, TestReadReplicatedMessagesForCDC) {
@@ -945,5 +1071,71 @@ TEST_F(ConsensusQueueTest, TestReadReplicatedMessagesForCDC) {
   ASSERT_EQ(last_committed_index - start, read_result.messages.size());
 }
 
+// Tests that committed op id waiters are invoked when the committed index advances and when the
+// queue leaves leader mode.
+TEST_F(ConsensusQueueTest, TestCommittedOpIdWaiters) {
+  auto start_op_id = MakeOpIdForIndex(3);
+  queue_->Init(start_op_id);
+  queue_->SetLeaderMode(
+      start_op_id, start_op_id.term, start_op_id, BuildRaftConfigPBForTests(2));
+  queue_->TrackPeer(kPeerUuid);
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, start_op_id.index, kNumMessages);
+  WaitForLocalPeerToAckIndex(kNumMessages);
+  queue_->raft_pool_observers_token_->Wait();
+  ASSERT_EQ(queue_->TEST_GetCommittedIndex(), start_op_id);
+
+  // Operations up to start_op_id are already committed, so the waiter is not registered.
+  ASSERT_EQ(queue_->RegisterCommittedOpIdWaiter(start_op_id.index - 1, [](const Status&) {
+    FAIL() << "Waiter should not be invoked";
+  }), 0);
+
+  // A removed waiter is not invoked.
+  auto removed_id = queue_->RegisterCommittedOpIdWaiter(start_op_id.index, [](const Status&) {
+    FAIL() << "Removed waiter should not be invoked";
+  });
+  ASSERT_NE(removed_id, 0);
+  ASSERT_TRUE(queue_->RemoveCommittedOpIdWaiter(removed_id));
+  ASSERT_FALSE(queue_->RemoveCommittedOpIdWaiter(removed_id));
+
+  std::promise<Status> committed_promise;
+  auto committed_id = queue_->RegisterCommittedOpIdWaiter(
+      start_op_id.index, [&committed_promise](const Status& status) {
+    committed_promise.set_value(status);
+  });
+  ASSERT_NE(committed_id, 0);
+
+  std::promise<Status> not_leader_promise;
+  auto not_leader_id = queue_->RegisterCommittedOpIdWaiter(
+      kNumMessages, [&not_leader_promise](const Status& status) {
+    not_leader_promise.set_value(status);
+  });
+  ASSERT_NE(not_leader_id, 0);
+
+  ThreadSafeArena arena;
+  LWConsensusResponsePB response(&arena);
+  response.ref_responder_uuid(kPeerUuid);
+  SetLastReceivedAndLastCommitted(&response, MakeOpIdForIndex(kNumMessages));
+  ASSERT_TRUE(queue_->ResponseFromPeer(response.responder_uuid().ToBuffer(), response));
+  queue_->raft_pool_observers_token_->Wait();
+
+  auto committed_future = committed_promise.get_future();
+  ASSERT_EQ(committed_future.wait_for(30s), std::future_status::ready);
+  ASSERT_OK(committed_future.get());
+  ASSERT_FALSE(queue_->RemoveCommittedOpIdWaiter(committed_id));
+
+  // Nothing after kNumMessages is committed, so the second waiter is invoked only once the queue
+  // leaves leader mode.
+  auto not_leader_future = not_leader_promise.get_future();
+  ASSERT_EQ(not_leader_future.wait_for(0s), std::future_status::timeout);
+  queue_->SetNonLeaderMode();
+  ASSERT_EQ(not_leader_future.wait_for(0s), std::future_status::ready);
+  ASSERT_TRUE(not_leader_future.get().IsIllegalState());
+  ASSERT_FALSE(queue_->RemoveCommittedOpIdWaiter(not_leader_id));
+
+  // Waiters are not registered while the queue is not the leader.
+  ASSERT_EQ(queue_->RegisterCommittedOpIdWaiter(kNumMessages, [](const Status&) {}), 0);
+}
+
 }  // namespace consensus
 }  // namespace yb
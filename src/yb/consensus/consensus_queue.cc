@@ -112,6 +112,13 @@ DEFINE_RUNTIME_int32(consensus_lagging_follower_threshold, 10,
     "-1 disables the feature.");
 TAG_FLAG(consensus_lagging_follower_threshold, advanced);
 
+DEFINE_RUNTIME_uint32(follower_read_lease_duration_ms, 2000,
+    "Duration of read leases granted by the leader to followers of tables with the "
+    "follower_read_leases property. While a follower holds a lease, the leader does not commit "
+    "operations it has not received, so writes could wait up to this time when a lease holder "
+    "becomes unreachable. 0 disables read leases.");
+TAG_FLAG(follower_read_lease_duration_ms, advanced);
+
 DEFINE_RUNTIME_int64(cdc_intent_retention_ms, 4 * 3600 * 1000,
     "Interval up to which CDC consumer's checkpoint is considered for retaining intents."
     "If we haven't received an updated checkpoint from CDC consumer within the interval "
@@ -281,12 +288,15 @@ void PeerMessageQueue::SetLeaderMode(const OpId& committed_op_id,
 }
 
 void PeerMessageQueue::SetNonLeaderMode() {
-  LockGuard lock(queue_lock_);
-  queue_state_.active_config.reset();
-  queue_state_.mode = Mode::NON_LEADER;
-  queue_state_.majority_size_ = -1;
-  LOG_WITH_PREFIX_UNLOCKED(INFO) << "Queue going to NON_LEADER mode. State: "
-      << queue_state_.ToString();
+  {
+    LockGuard lock(queue_lock_);
+    queue_state_.active_config.reset();
+    queue_state_.mode = Mode::NON_LEADER;
+    queue_state_.majority_size_ = -1;
+    LOG_WITH_PREFIX_UNLOCKED(INFO) << "Queue going to NON_LEADER mode. State: "
+        << queue_state_.ToString();
+  }
+  FailCommittedOpIdWaiters(STATUS(IllegalState, "Not the leader"), /* close= */ false);
 }
 
 void PeerMessageQueue::TrackPeer(const string& uuid) {
@@ -339,6 +349,12 @@ void PeerMessageQueue::UntrackPeer(const string& uuid) {
   LockGuard lock(queue_lock_);
   TrackedPeer* peer = EraseKeyReturnValuePtr(&peers_map_, uuid);
   if (peer != nullptr) {
+    if (peer->follower_read_lease_expiration > clock_->Now()) {
+      auto& holder = departed_read_lease_holders_[uuid];
+      holder.lease_expiration =
+          std::max(holder.lease_expiration, peer->follower_read_lease_expiration);
+      holder.last_received = peer->last_received;
+    }
     delete peer;
   }
 }
@@ -483,7 +499,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         LWReplicateMsgsHolder* msgs_holder,
                                         bool* needs_remote_bootstrap,
                                         PeerMemberType* member_type,
-                                        bool* last_exchange_successful) {
+                                        bool* last_exchange_successful,
+                                        Pipelined pipelined,
+                                        SentRequestInfo* sent_request) {
   static constexpr uint64_t kSendUnboundedLogOps = std::numeric_limits<uint64_t>::max();
   DCHECK(request->ops().empty()) << request->ShortDebugString();
 
@@ -499,6 +517,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   if (context_) {
     propagated_safe_time = VERIFY_RESULT(context_->PreparePeerRequest());
   }
+  const auto read_lease_duration_ms = GetAtomicFlag(&FLAGS_follower_read_lease_duration_ms);
+  const bool grant_read_lease =
+      read_lease_duration_ms > 0 && context_ && context_->FollowerReadLeasesEnabled();
 
   int64 current_term;
   RaftConfigPB active_config;
@@ -535,9 +556,18 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
 
       // Because of coarse clocks we subtract 2ms, to be sure that our local version of lease
       // does not expire after it expires at follower.
-      peer->leader_lease_expiration.last_sent =
+      auto leader_lease_expiration =
           CoarseMonoClock::Now() + leader_lease_duration_ms * 1ms - kCoarseClockPrecision * 2;
-      peer->leader_ht_lease_expiration.last_sent = ht_lease_expiration_micros;
+      // Pipelined request could be skipped by the caller, and its reply is credited using
+      // sent_request, so last_sent is left to the requests that are not pipelined.
+      if (!pipelined) {
+        peer->leader_lease_expiration.last_sent = leader_lease_expiration;
+        peer->leader_ht_lease_expiration.last_sent = ht_lease_expiration_micros;
+      }
+      if (sent_request) {
+        sent_request->leader_lease_expiration = leader_lease_expiration;
+        sent_request->ht_lease_expiration = ht_lease_expiration_micros;
+      }
     } else {
       now_ht = clock_->Now();
       request->clear_leader_lease_duration_ms();
@@ -576,6 +606,27 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     } else {
       queue_state_.committed_op_id.ToPB(request->mutable_committed_op_id());
     }
+    if (peer->witness) {
+      queue_state_.all_replicated_op_id.ToPB(request->mutable_all_replicated_op_id());
+    }
+
+    // Read lease is granted only to caught up voters. It never outlives the majority replicated
+    // hybrid time leader lease, so a new leader does not accept writes while followers of the old
+    // one could still serve reads.
+    request->clear_follower_read_lease_expiration();
+    if (grant_read_lease && !is_new && peer->is_last_exchange_successful &&
+        peer->member_type == PeerMemberType::VOTER && !peer->witness &&
+        peer->last_received == queue_state_.last_appended) {
+      auto now_micros = now_ht.GetPhysicalValueMicros();
+      auto expiration_micros = std::min<MicrosTime>(
+          now_micros + read_lease_duration_ms * 1000ULL, HybridTimeLeaseExpirationWatermark());
+      if (expiration_micros > now_micros) {
+        HybridTime expiration(expiration_micros, /* logical */ 0);
+        peer->follower_read_lease_expiration =
+            std::max(peer->follower_read_lease_expiration, expiration);
+        request->set_follower_read_lease_expiration(expiration.ToUint64());
+      }
+    }
 
     request->set_caller_term(queue_state_.current_term);
     unreachable_time =
@@ -585,7 +636,16 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     previously_sent_index = peer->next_index - 1;
-    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
+    if (pipelined) {
+      // Ops up to pipelined_next_index are in flight already, and the requests after a rejected
+      // one would be rejected as well, so wait for the responses before resending anything.
+      if (peer->pipelined_next_index > peer->next_index) {
+        previously_sent_index = peer->pipelined_next_index - 1;
+        num_log_ops_to_send = kSendUnboundedLogOps;
+      } else {
+        num_log_ops_to_send = 0;
+      }
+    } else if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
       num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
@@ -595,7 +655,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       num_log_ops_to_send = kSendUnboundedLogOps;
     }
 
-    peer->current_retransmissions++;
+    if (!pipelined) {
+      peer->current_retransmissions++;
+    }
 
     if (peer->member_type == PeerMemberType::VOTER) {
       is_voter = true;
@@ -663,7 +725,12 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         return STATUS(NotFound, "Peer not tracked.");
       }
 
-      peer->last_num_messages_sent = result->messages.size();
+      if (!pipelined) {
+        peer->last_num_messages_sent = result->messages.size();
+      }
+      if (!result->messages.empty()) {
+        peer->pipelined_next_index = result->messages.back()->id().index() + 1;
+      }
     }
 
     ScopedTrackedConsumption consumption;
@@ -681,6 +748,10 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   }
 
   preceding_id.ToPB(request->mutable_preceding_id());
+  if (sent_request) {
+    sent_request->preceding_id = preceding_id;
+    sent_request->pipelined = pipelined;
+  }
 
   // All entries committed at leader may not be available at lagging follower.
   // `commited_op_id` in this request may make a lagging follower aware of the
@@ -799,14 +870,19 @@ Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(
 const PeerMessageQueue::TrackedPeer* PeerMessageQueue::FindClosestPeerForBootstrap(
     const TrackedPeer* remote_tracked_peer) {
   const CloudInfoPB& src_cloud_info = remote_tracked_peer->cloud_info.value();
-  // initializing rbs_source as the leader itself.
-  LocalityLevel best_locality_level =
-      PlacementInfoConverter::GetLocalityLevel(src_cloud_info, local_peer_pb_.cloud_info());
-  PeerMessageQueue::TrackedPeer* rbs_source = local_peer_;
+  // initializing rbs_source as the leader itself, unless the leader is a witness that does not
+  // have the data.
+  LocalityLevel best_locality_level = LocalityLevel::kNone;
+  PeerMessageQueue::TrackedPeer* rbs_source = nullptr;
+  if (!local_peer_->witness) {
+    best_locality_level =
+        PlacementInfoConverter::GetLocalityLevel(src_cloud_info, local_peer_pb_.cloud_info());
+    rbs_source = local_peer_;
+  }
   for (auto it = peers_map_.begin(); it != peers_map_.end(); it++) {
     // don't consider locality of remote_tracked_peer with itself
     if (!it->second->cloud_info.has_value() || remote_tracked_peer == it->second ||
-        it->second->needs_remote_bootstrap) {
+        it->second->needs_remote_bootstrap || it->second->witness) {
       continue;
     }
 
@@ -823,7 +899,7 @@ const PeerMessageQueue::TrackedPeer* PeerMessageQueue::FindClosestPeerForBootstr
 
     auto cur_locality_level =
         PlacementInfoConverter::GetLocalityLevel(src_cloud_info, it->second->cloud_info.value());
-    if (cur_locality_level > best_locality_level) {
+    if (!rbs_source || cur_locality_level > best_locality_level) {
       best_locality_level = cur_locality_level;
       rbs_source = it->second;
     }
@@ -832,6 +908,21 @@ const PeerMessageQueue::TrackedPeer* PeerMessageQueue::FindClosestPeerForBootstr
   return rbs_source;
 }
 
+const PeerMessageQueue::TrackedPeer* PeerMessageQueue::FindFullVoterForBootstrap(
+    const TrackedPeer* remote_tracked_peer) {
+  for (const auto& [peer_uuid, tracked_peer] : peers_map_) {
+    if (tracked_peer == remote_tracked_peer || tracked_peer->witness ||
+        tracked_peer->needs_remote_bootstrap ||
+        tracked_peer->member_type != PeerMemberType::VOTER ||
+        tracked_peer->last_applied.term != queue_state_.current_term ||
+        tracked_peer->last_applied.index < log_cache_.earliest_op_index()) {
+      continue;
+    }
+    return tracked_peer;
+  }
+  return nullptr;
+}
+
 Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
                                                           StartRemoteBootstrapRequestPB* req) {
   TrackedPeer* peer = nullptr;
@@ -862,9 +953,18 @@ Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
                          peer->bootstrap_attempts_from_non_leader < 5
                      ? FindClosestPeerForBootstrap(peer)
                      : local_peer_;
+    if (rbs_source && rbs_source->witness) {
+      rbs_source = FindFullVoterForBootstrap(peer);
+    }
     current_term = queue_state_.current_term;
   }
 
+  if (!rbs_source) {
+    // Peer will be bootstrapped after leadership is transferred to a full voter.
+    return STATUS_FORMAT(
+        IllegalState, "Witness leader has no full replica to remote bootstrap $0 from", uuid);
+  }
+
   LOG(INFO) << "Remote bootstrapping peer " << uuid << " from closest peer " << rbs_source->uuid;
 
   req->Clear();
@@ -1139,6 +1239,39 @@ MicrosTime PeerMessageQueue::HybridTimeLeaseExpirationWatermark() {
   return GetWatermark<Policy>();
 }
 
+OpId PeerMessageQueue::CapByFollowerReadLeases(OpId op_id) {
+  HybridTime now;
+  for (auto& [uuid, peer] : peers_map_) {
+    if (peer->follower_read_lease_expiration == HybridTime::kMin) {
+      continue;
+    }
+    if (!now) {
+      now = clock_->Now();
+    }
+    if (peer->follower_read_lease_expiration <= now) {
+      peer->follower_read_lease_expiration = HybridTime::kMin;
+      continue;
+    }
+    if (peer->last_received.index < op_id.index) {
+      op_id = peer->last_received;
+    }
+  }
+  for (auto it = departed_read_lease_holders_.begin(); it != departed_read_lease_holders_.end();) {
+    if (!now) {
+      now = clock_->Now();
+    }
+    if (it->second.lease_expiration <= now) {
+      it = departed_read_lease_holders_.erase(it);
+      continue;
+    }
+    if (it->second.last_received.index < op_id.index) {
+      op_id = it->second.last_received;
+    }
+    ++it;
+  }
+  return op_id;
+}
+
 uint64_t PeerMessageQueue::NumSSTFilesWatermark() {
   struct Policy {
     typedef uint64_t result_type;
@@ -1210,7 +1343,8 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
 
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
-                                        const LWConsensusResponsePB& response) {
+                                        const LWConsensusResponsePB& response,
+                                        const SentRequestInfo* sent_request) {
   MajorityReplicatedData majority_replicated;
   Mode mode_copy;
   bool result = false;
@@ -1249,6 +1383,7 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
         LOG(FATAL) << "Peer " << peer_uuid << " not in active config";
       }
       peer->member_type = peer_pb.member_type();
+      peer->witness = peer_pb.witness();
     } else {
       peer->member_type = PeerMemberType::UNKNOWN_MEMBER_TYPE;
     }
@@ -1280,8 +1415,21 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       // If we've never successfully sent them anything, start after the last-committed op in their
       // log, which is guaranteed by the Raft protocol to be a valid op.
 
+      // A pipelined request could reach the peer before its predecessor, and be rejected because
+      // the peer does not have the preceding op yet. Such a rejection is overtaken if the
+      // predecessor was acked since then, so it reflects an older state of the peer. The peer is
+      // not moved back in this case, and the ops of the rejected request are resent after the
+      // acked ones.
+      const bool overtaken_rejection =
+          sent_request && sent_request->pipelined && status.has_error() &&
+          status.error().code() == ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH &&
+          status.last_received().index() < sent_request->preceding_id.index &&
+          previous.last_received.index >= sent_request->preceding_id.index;
+
       bool peer_has_prefix_of_log = IsOpInLog(OpId::FromPB(status.last_received()));
-      if (peer_has_prefix_of_log) {
+      if (overtaken_rejection) {
+        peer->next_index = peer->last_received.index + 1;
+      } else if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
         peer->last_received = OpId::FromPB(status.last_received());
         peer->next_index = peer->last_received.index + 1;
@@ -1304,10 +1452,15 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
       if (PREDICT_FALSE(status.has_error())) {
         peer->is_last_exchange_successful = false;
+        peer->pipelined_next_index = kInvalidOpIdIndex;
         switch (status.error().code()) {
           case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
             DCHECK(status.has_last_received());
-            if (previous.is_new) {
+            if (overtaken_rejection) {
+              VLOG_WITH_PREFIX_UNLOCKED(1)
+                  << "Pipelined request overtook its predecessor, preceding op id: "
+                  << sent_request->preceding_id << ", peer: " << peer->ToString();
+            } else if (previous.is_new) {
               // That's currently how we can detect that we able to connect to a peer.
               LOG_WITH_PREFIX_UNLOCKED(INFO) << "Connected to new peer: " << peer->ToString();
             } else {
@@ -1361,14 +1514,22 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       auto new_majority_replicated_opid = OpIdWatermark();
       if (new_majority_replicated_opid != OpId::Min()) {
         if (new_majority_replicated_opid.index == MaximumOpId().index()) {
-          queue_state_.majority_replicated_op_id = local_peer_->last_received;
-        } else {
-          queue_state_.majority_replicated_op_id = new_majority_replicated_opid;
+          new_majority_replicated_opid = local_peer_->last_received;
+        }
+        auto op_id = CapByFollowerReadLeases(new_majority_replicated_opid);
+        if (op_id == new_majority_replicated_opid ||
+            op_id.index > queue_state_.majority_replicated_op_id.index) {
+          queue_state_.majority_replicated_op_id = op_id;
         }
       }
 
-      peer->leader_lease_expiration.OnReplyFromFollower();
-      peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      if (sent_request) {
+        peer->leader_lease_expiration.OnReplyFromFollower(sent_request->leader_lease_expiration);
+        peer->leader_ht_lease_expiration.OnReplyFromFollower(sent_request->ht_lease_expiration);
+      } else {
+        peer->leader_lease_expiration.OnReplyFromFollower();
+        peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      }
 
       majority_replicated.op_id = queue_state_.majority_replicated_op_id;
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
@@ -1481,8 +1642,11 @@ void PeerMessageQueue::Close() {
     installed_num_sst_files_changed_listener_ = false;
   }
   raft_pool_observers_token_->Shutdown();
-  LockGuard lock(queue_lock_);
-  ClearUnlocked();
+  {
+    LockGuard lock(queue_lock_);
+    ClearUnlocked();
+  }
+  FailCommittedOpIdWaiters(STATUS(Aborted, "Consensus queue is closed"), /* close= */ true);
 }
 
 string PeerMessageQueue::ToString() const {
@@ -1612,6 +1776,89 @@ void PeerMessageQueue::NotifyObserversOfMajorityReplOpChangeTask(
     local_peer_->last_applied = queue_state_.last_applied_op_id;
     UpdateAllAppliedOpId(&queue_state_.all_applied_op_id);
   }
+
+  NotifyCommittedOpIdWaiters();
+}
+
+uint64_t PeerMessageQueue::RegisterCommittedOpIdWaiter(
+    int64_t index, CommittedOpIdWaiter waiter) {
+  std::lock_guard<std::mutex> lock(committed_op_id_waiters_mutex_);
+  if (committed_op_id_waiters_closed_) {
+    return 0;
+  }
+  // The counter is incremented before committed op id is checked, so a concurrent update either
+  // is seen by the check or sees the waiter and invokes it.
+  ++num_committed_op_id_waiters_;
+  {
+    LockGuard queue_lock(queue_lock_);
+    if (queue_state_.committed_op_id.index > index || queue_state_.mode != Mode::LEADER ||
+        queue_state_.state != State::kQueueOpen) {
+      --num_committed_op_id_waiters_;
+      return 0;
+    }
+  }
+  auto id = next_committed_op_id_waiter_id_++;
+  committed_op_id_waiters_.emplace(id, CommittedOpIdWaiterEntry {
+    .index = index,
+    .waiter = std::move(waiter),
+  });
+  return id;
+}
+
+bool PeerMessageQueue::RemoveCommittedOpIdWaiter(uint64_t id) {
+  std::lock_guard<std::mutex> lock(committed_op_id_waiters_mutex_);
+  if (!committed_op_id_waiters_.erase(id)) {
+    return false;
+  }
+  --num_committed_op_id_waiters_;
+  return true;
+}
+
+void PeerMessageQueue::NotifyCommittedOpIdWaiters() {
+  if (num_committed_op_id_waiters_.load() == 0) {
+    return;
+  }
+  std::vector<CommittedOpIdWaiter> ready;
+  {
+    std::lock_guard<std::mutex> lock(committed_op_id_waiters_mutex_);
+    int64_t committed_index;
+    {
+      LockGuard queue_lock(queue_lock_);
+      committed_index = queue_state_.committed_op_id.index;
+    }
+    for (auto it = committed_op_id_waiters_.begin(); it != committed_op_id_waiters_.end();) {
+      if (it->second.index < committed_index) {
+        ready.push_back(std::move(it->second.waiter));
+        it = committed_op_id_waiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    num_committed_op_id_waiters_ -= ready.size();
+  }
+  // Waiters are invoked without holding the mutex, since they could register a new waiter.
+  for (const auto& waiter : ready) {
+    waiter(Status::OK());
+  }
+}
+
+void PeerMessageQueue::FailCommittedOpIdWaiters(const Status& status, bool close) {
+  std::vector<CommittedOpIdWaiter> waiters;
+  {
+    std::lock_guard<std::mutex> lock(committed_op_id_waiters_mutex_);
+    if (close) {
+      committed_op_id_waiters_closed_ = true;
+    }
+    waiters.reserve(committed_op_id_waiters_.size());
+    for (auto& [id, entry] : committed_op_id_waiters_) {
+      waiters.push_back(std::move(entry.waiter));
+    }
+    committed_op_id_waiters_.clear();
+    num_committed_op_id_waiters_ -= waiters.size();
+  }
+  for (const auto& waiter : waiters) {
+    waiter(status);
+  }
 }
 
 void PeerMessageQueue::NotifyObserversOfFailedFollower(const string& uuid,
@@ -1649,6 +1896,10 @@ bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
     LOG(ERROR) << "Invalid peer UUID: " << peer_uuid;
     return false;
   }
+  if (peer->witness) {
+    LOG(INFO) << Format("Peer $0 cannot become Leader as it is a witness", peer_uuid);
+    return false;
+  }
   const bool peer_can_be_leader = peer->last_received >= queue_state_.majority_replicated_op_id;
   if (!peer_can_be_leader) {
     LOG(INFO) << Format(
@@ -1675,7 +1926,7 @@ string PeerMessageQueue::GetUpToDatePeer() const {
   {
     std::lock_guard<simple_spinlock> lock(queue_lock_);
     for (const PeersMap::value_type& entry : peers_map_) {
-      if (local_peer_uuid_ == entry.first) {
+      if (local_peer_uuid_ == entry.first || entry.second->witness) {
         continue;
       }
       if (highest_op_id > entry.second->last_received) {
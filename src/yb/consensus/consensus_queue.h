@@ -32,8 +32,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -71,6 +75,20 @@ struct MajorityReplicatedData;
 // The id for the server-wide consensus queue MemTracker.
 extern const char kConsensusQueueParentTrackerId[];
 
+// Information about a particular request sent to a follower, used when several requests could be
+// in flight to it.
+struct SentRequestInfo {
+  // Leader leases sent in the request.
+  CoarseTimePoint leader_lease_expiration;
+  MicrosTime ht_lease_expiration = 0;
+
+  // Id of the op preceding the ops of the request.
+  OpId preceding_id;
+
+  // Whether the request was sent while other requests were in flight to the follower.
+  Pipelined pipelined = Pipelined::kFalse;
+};
+
 // Utility structure to track value sent to and received by follower.
 template <class Value>
 struct FollowerWatermark {
@@ -94,6 +112,12 @@ struct FollowerWatermark {
     last_received = last_sent;
   }
 
+  // Used when several requests could be in flight, so last_sent could belong to a request that
+  // the follower did not process yet.
+  void OnReplyFromFollower(const Value& sent) {
+    last_received = std::max(last_received, sent);
+  }
+
   std::string ToString() const {
     return Format("{ last_sent: $0 last_received: $1 }", last_sent, last_received);
   }
@@ -119,7 +143,8 @@ class PeerMessageQueue {
     explicit TrackedPeer(const RaftPeerPB& raft_peer_pb)
         : uuid(raft_peer_pb.permanent_uuid()),
           last_known_committed_idx(OpId::Min().index),
-          last_successful_communication_time(MonoTime::Now()) {
+          last_successful_communication_time(MonoTime::Now()),
+          witness(raft_peer_pb.witness()) {
       cloud_info = raft_peer_pb.cloud_info();
       last_known_private_addr = std::vector<HostPortPB>(
           raft_peer_pb.last_known_private_addr().begin(),
@@ -151,6 +176,10 @@ class PeerMessageQueue {
     // Next index to send to the peer.  This corresponds to "nextIndex" as specified in Raft.
     int64_t next_index = kInvalidOpIdIndex;
 
+    // Next index to send to the peer in a request pipelined after the requests that are in flight,
+    // i.e. the index after the last op sent to the peer. Ignored if not greater than next_index.
+    int64_t pipelined_next_index = kInvalidOpIdIndex;
+
     // Number of ops starting from next_index_ to retransmit.
     int64_t last_num_messages_sent = -1;
 
@@ -195,6 +224,13 @@ class PeerMessageQueue {
     // Member type of this peer in the config.
     PeerMemberType member_type = PeerMemberType::UNKNOWN_MEMBER_TYPE;
 
+    // Whether this peer is a witness, i.e. keeps only the log and cannot serve as a leader.
+    bool witness = false;
+
+    // Max expiration of the read lease granted to this peer, see
+    // ConsensusRequestPB::follower_read_lease_expiration.
+    HybridTime follower_read_lease_expiration = HybridTime::kMin;
+
     uint64_t num_sst_files = 0;
 
     std::optional<CloudInfoPB> cloud_info;
@@ -285,6 +321,12 @@ class PeerMessageQueue {
   // Returns STATUS(Incomplete, "") if we try to read an operation index from the log that has not
   // been written.
   //
+  // pipelined - other requests are in flight to the peer, so the request continues after the last
+  // op sent to it instead of the last op it acked. No ops are added if there were no ops sent
+  // since the last ack, or the peer rejected a request since then.
+  //
+  // sent_request - receives the leader leases and the preceding op id of the request.
+  //
   // WARNING: In order to avoid copying the same messages to every peer, entries are added to
   // 'request' via AddAllocated() methods.  The owner of 'request' is expected not to delete the
   // request prior to removing the entries through ExtractSubRange() or any other method that does
@@ -297,7 +339,9 @@ class PeerMessageQueue {
       LWReplicateMsgsHolder* msgs_holder,
       bool* needs_remote_bootstrap,
       PeerMemberType* member_type = nullptr,
-      bool* last_exchange_successful = nullptr);
+      bool* last_exchange_successful = nullptr,
+      Pipelined pipelined = Pipelined::kFalse,
+      SentRequestInfo* sent_request = nullptr);
 
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
@@ -307,10 +351,15 @@ class PeerMessageQueue {
       StartRemoteBootstrapRequestPB* req);
 
   // Scans the peers_map_ and returns a pointer to the closest peer for the passed remote peer.
-  // Reutrns NULL if all tracked peers in the peers_map_ don't have CloudInfoPB specified.
+  // Witnesses are never returned, since they don't have the data. Returns NULL if the leader is a
+  // witness and no other peer could be used as the source.
   const TrackedPeer* FindClosestPeerForBootstrap(const TrackedPeer* remote_tracked_peer)
       REQUIRES(queue_lock_);
 
+  // Returns a full voter that could serve remote bootstrap of the passed remote peer, or NULL.
+  const TrackedPeer* FindFullVoterForBootstrap(const TrackedPeer* remote_tracked_peer)
+      REQUIRES(queue_lock_);
+
   // Update the last successful communication timestamp for the given peer to the current time. This
   // should be called when a non-network related error is received from the peer, indicating that it
   // is alive, even if it may not be fully up and running or able to accept updates.
@@ -318,8 +367,10 @@ class PeerMessageQueue {
 
   // Updates the request queue with the latest response of a peer, returns whether this peer has
   // more requests pending.
+  // sent_request - info about the request, if several requests could be in flight to the peer.
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
-                                const LWConsensusResponsePB& response);
+                                const LWConsensusResponsePB& response,
+                                const SentRequestInfo* sent_request = nullptr);
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
@@ -390,6 +441,12 @@ class PeerMessageQueue {
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
       const bool fetch_single_entry = false);
 
+  // See Consensus::RegisterCommittedOpIdWaiter.
+  uint64_t RegisterCommittedOpIdWaiter(int64_t index, CommittedOpIdWaiter waiter);
+
+  // See Consensus::RemoveCommittedOpIdWaiter.
+  bool RemoveCommittedOpIdWaiter(uint64_t id);
+
   void UpdateCDCConsumerOpId(const yb::OpId& op_id);
 
   // Get the maximum op ID that can be evicted for CDC consumer from log cache.
@@ -490,6 +547,13 @@ class PeerMessageQueue {
 
   void NotifyObserversOfMajorityReplOpChangeTask(const MajorityReplicatedData& data);
 
+  // Invokes waiters satisfied by the committed op id after it was advanced.
+  void NotifyCommittedOpIdWaiters();
+
+  // Invokes all registered committed op id waiters with the specified status. When close is true,
+  // waiters registered later are not accepted.
+  void FailCommittedOpIdWaiters(const Status& status, bool close);
+
   void NotifyObserversOfTermChange(int64_t term);
 
   void NotifyObserversOfFailedFollower(const std::string& uuid,
@@ -551,6 +615,10 @@ class PeerMessageQueue {
 
   CoarseTimePoint LeaderLeaseExpirationWatermark() REQUIRES(queue_lock_);
   MicrosTime HybridTimeLeaseExpirationWatermark() REQUIRES(queue_lock_);
+
+  // Returns the latest op id, not after op_id, that was received by all followers holding
+  // unexpired read leases.
+  OpId CapByFollowerReadLeases(OpId op_id) REQUIRES(queue_lock_);
   OpId OpIdWatermark() REQUIRES(queue_lock_);
   uint64_t NumSSTFilesWatermark() REQUIRES(queue_lock_);
 
@@ -580,12 +648,37 @@ class PeerMessageQueue {
 
   // The currently tracked peers.
   PeersMap peers_map_;
+
+  struct DepartedReadLeaseHolder {
+    HybridTime lease_expiration = HybridTime::kMin;
+    OpId last_received;
+  };
+
+  // Peers that were untracked, e.g. removed from the config, while holding an unexpired read lease.
+  // Such a peer does not receive new operations, so commit is capped by what it received until its
+  // lease expires. It also blocks commit of the config change that removed it.
+  std::unordered_map<std::string, DepartedReadLeaseHolder> departed_read_lease_holders_
+      GUARDED_BY(queue_lock_);
   TrackedPeer* local_peer_ = nullptr;
 
   using LockType = simple_spinlock;
   using LockGuard = std::lock_guard<LockType>;
   mutable LockType queue_lock_; // TODO: rename
 
+  struct CommittedOpIdWaiterEntry {
+    int64_t index;
+    CommittedOpIdWaiter waiter;
+  };
+
+  // Waiters registered by RegisterCommittedOpIdWaiter. Acquired before queue_lock_.
+  std::mutex committed_op_id_waiters_mutex_;
+  std::unordered_map<uint64_t, CommittedOpIdWaiterEntry> committed_op_id_waiters_
+      GUARDED_BY(committed_op_id_waiters_mutex_);
+  uint64_t next_committed_op_id_waiter_id_ GUARDED_BY(committed_op_id_waiters_mutex_) = 1;
+  bool committed_op_id_waiters_closed_ GUARDED_BY(committed_op_id_waiters_mutex_) = false;
+  // Number of registered waiters, lets the commit path skip the mutex when there are none.
+  std::atomic<size_t> num_committed_op_id_waiters_{0};
+
   // We assume that we never have multiple threads racing to append to the queue.  This fake mutex
   // adds some extra assurance that this implementation property doesn't change.
   DFAKE_MUTEX(append_fake_lock_);
@@ -67,6 +67,8 @@ DECLARE_int32(o_direct_block_size_bytes);
 DECLARE_bool(TEST_simulate_abrupt_server_restart);
 DECLARE_bool(TEST_skip_file_close);
 DECLARE_int64(reuse_unclosed_segment_threshold);
+DECLARE_bool(enable_log_compression);
+DECLARE_uint64(log_compression_min_batch_size_bytes);
 
 namespace yb {
 namespace log {
@@ -470,6 +472,111 @@ TEST_F(LogTest, TestSizeIsMaintained) {
   ASSERT_OK(log_->Close());
 }
 
+// Test that compressed entry batches take less space and are read back as written.
+TEST_F(LogTest, TestCompressedEntryBatches) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_log_compression) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_compression_min_batch_size_bytes) = 0;
+  constexpr int kNumBatches = 10;
+  constexpr int kOpsPerBatch = 100;
+
+  options_.preallocate_segments = false;
+  BuildLog();
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(ASSERT_RESULT(segments.front())->header().minor_version(), kLogMinorVersion);
+  const auto orig_size = ASSERT_RESULT(segments.front())->file_size();
+
+  OpIdPB opid = MakeOpId(0, 1);
+  ssize_t uncompressed_size = 0;
+  for (int i = 0; i < kNumBatches; ++i) {
+    ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, kOpsPerBatch, &uncompressed_size));
+  }
+
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  const auto new_size = ASSERT_RESULT(segments.front())->file_size();
+  ASSERT_LT(new_size - orig_size, uncompressed_size);
+
+  auto read_entries = ASSERT_RESULT(segments.front())->ReadEntries();
+  ASSERT_OK(read_entries.status);
+  ASSERT_EQ(read_entries.entries.size(), static_cast<size_t>(kNumBatches * kOpsPerBatch));
+  int64_t expected_index = 1;
+  for (const auto& entry : read_entries.entries) {
+    ASSERT_EQ(entry->replicate().id().index(), expected_index++);
+  }
+
+  ASSERT_OK(log_->Close());
+}
+
+// Test that batches are compressed only in segments created while compression is enabled, so
+// segments readable by older versions never contain compressed batches.
+TEST_F(LogTest, TestCompressionFollowsSegmentVersion) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_log_compression) = false;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_compression_min_batch_size_bytes) = 0;
+  constexpr int kOpsPerBatch = 100;
+
+  options_.preallocate_segments = false;
+  BuildLog();
+
+  auto append_batch_to_last_segment = [this](OpIdPB* opid) -> Result<int64_t> {
+    SegmentSequence segments;
+    RETURN_NOT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+    const auto orig_size = VERIFY_RESULT(segments.back())->file_size();
+    RETURN_NOT_OK(AppendNoOpsToLogSync(clock_, log_.get(), opid, kOpsPerBatch));
+    RETURN_NOT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+    return VERIFY_RESULT(segments.back())->file_size() - orig_size;
+  };
+
+  // Enabling compression does not affect the segment that was created without it.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_log_compression) = true;
+  OpIdPB opid = MakeOpId(0, 1);
+  const auto uncompressed_size = ASSERT_RESULT(append_batch_to_last_segment(&opid));
+
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+  const auto compressed_size = ASSERT_RESULT(append_batch_to_last_segment(&opid));
+  ASSERT_LT(compressed_size, uncompressed_size);
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(segments.size(), 2U);
+  ASSERT_EQ(ASSERT_RESULT(segments.front())->header().minor_version(),
+            kLogMinorVersionWithoutCompression);
+  ASSERT_EQ(ASSERT_RESULT(segments.back())->header().minor_version(), kLogMinorVersion);
+
+  int64_t expected_index = 1;
+  for (const auto& segment : segments) {
+    auto read_entries = segment->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    ASSERT_EQ(read_entries.entries.size(), static_cast<size_t>(kOpsPerBatch));
+    for (const auto& entry : read_entries.entries) {
+      ASSERT_EQ(entry->replicate().id().index(), expected_index++);
+    }
+  }
+
+  ASSERT_OK(log_->Close());
+}
+
+// Test that the reader refuses segments with a log version newer than the one it supports.
+TEST_F(LogTest, TestRefuseNewerSegmentVersion) {
+  const auto path = GetTestPath("wal-newer-version");
+  std::unique_ptr<WritableFile> file;
+  ASSERT_OK(fs_manager_->env()->NewWritableFile(path, &file));
+  WritableLogSegment segment(path, std::move(file));
+
+  LogSegmentHeaderPB header;
+  header.set_major_version(kLogMajorVersion);
+  header.set_minor_version(kLogMinorVersion + 1);
+  header.set_sequence_number(1);
+  header.set_unused_tablet_id(kTestTablet);
+  SchemaToPB(GetSimpleTestSchema(), header.mutable_deprecated_schema());
+  ASSERT_OK(segment.WriteHeader(header));
+  ASSERT_OK(segment.Sync());
+
+  auto result = ReadableLogSegment::Open(fs_manager_->env(), path);
+  ASSERT_FALSE(result.ok());
+  ASSERT_TRUE(result.status().IsNotSupported()) << result.status();
+}
+
 // Test that the reader can read from the log even if it hasn't been
 // properly closed.
 TEST_F(LogTest, TestLogNotTrimmed) {
@@ -726,7 +833,7 @@ TEST_F(LogTest, TestWriteAndReadToAndFromInProgressSegment) {
   // Now that we closed the original segment. If we get a segment from the reader
   // again, we should get one with a footer and we should be able to read all entries.
   ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
-  ASSERT_EQ(segments.size(), 2);
+  ASSERT_EQ(segments.size(), 2U);
   readable_segment = ASSERT_RESULT(segments.front());
   read_entries = readable_segment->ReadEntries();
   ASSERT_OK(read_entries.status);
@@ -1029,7 +1136,7 @@ TEST_F(LogTest, TestLogReader) {
 
   // Asking for 30 should include the first two.
   ASSERT_OK(reader.GetSegmentPrefixNotIncluding(30, &segments));
-  ASSERT_EQ(segments.size(), 2);
+  ASSERT_EQ(segments.size(), 2U);
   ASSERT_EQ((*segments.begin())->header().sequence_number(), 2);
   ASSERT_EQ((*(segments.begin() + 1))->header().sequence_number(), 3);
 
@@ -116,6 +116,17 @@ DEFINE_RUNTIME_int32(log_min_seconds_to_retain, 900,
     "machines.");
 TAG_FLAG(log_min_seconds_to_retain, advanced);
 
+// Auto flag, since segments written with compression could not be read by older versions, that
+// could get them with remote bootstrap or after a downgrade.
+DEFINE_RUNTIME_AUTO_bool(enable_log_compression, kLocalPersisted, false, true,
+    "Compress WAL entry batches with LZ4 when they are written to log segments. Segments created "
+    "while this flag is set are marked with log minor version 1, and could not be read by "
+    "versions that do not support log compression.");
+
+DEFINE_RUNTIME_uint64(log_compression_min_batch_size_bytes, 1_KB,
+    "Min size of serialized WAL entry batch to try compressing it, when enable_log_compression "
+    "is set.");
+
 // Flag to enable background log sync. When enabled, we DON'T wait for performing fsync until
 // either
 // 1. unsynced data reaches bytes_durable_wal_write_mb_ threshold OR
@@ -300,6 +311,16 @@ class Log::LogEntryBatch {
     return Slice(buffer_);
   }
 
+  // Compresses the serialized data with CompressEntryBatch, if it is large enough and compression
+  // makes it smaller.
+  void Compress();
+
+  // Whether data() is compressed with CompressEntryBatch.
+  bool compressed() const {
+    DCHECK_EQ(state_, kEntrySerialized);
+    return compressed_;
+  }
+
   bool IsMarker() const;
 
   bool IsSingleEntryOfType(LogEntryTypePB type) const;
@@ -346,6 +367,9 @@ class Log::LogEntryBatch {
   // Buffer to which 'phys_entries_' are serialized by call to 'Serialize()'
   faststring buffer_;
 
+  // Whether 'buffer_' is compressed.
+  bool compressed_ = false;
+
   // Offset into the log file for this entry batch.
   int64_t offset_;
 
@@ -890,7 +914,14 @@ Status Log::DoAppend(LogEntryBatch* entry_batch, SkipWalWrite skip_wal_write) {
       LongOperationTracker long_operation_tracker(
           "Log append", FLAGS_consensus_log_scoped_watch_delay_append_threshold_ms * 1ms);
 
-      RETURN_NOT_OK(active_segment_->WriteEntryBatch(entry_batch_data));
+      // Compression is decided after the rollover, since only segments with the minor version
+      // that supports compression could contain compressed batches.
+      if (active_segment_->header().minor_version() >= kLogMinorVersion) {
+        entry_batch->Compress();
+        entry_batch_data = entry_batch->data();
+      }
+      RETURN_NOT_OK(
+          active_segment_->WriteEntryBatch(entry_batch_data, entry_batch->compressed()));
     }
 
     if (metrics_) {
@@ -1832,7 +1863,8 @@ Status Log::SwitchToAllocatedSegment() {
   // Set up the new header and footer.
   LogSegmentHeaderPB header;
   header.set_major_version(kLogMajorVersion);
-  header.set_minor_version(kLogMinorVersion);
+  header.set_minor_version(GetAtomicFlag(&FLAGS_enable_log_compression)
+      ? kLogMinorVersion : kLogMinorVersionWithoutCompression);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_unused_tablet_id(tablet_id_);
 
@@ -1978,6 +2010,7 @@ Status Log::LogEntryBatch::Serialize() {
   }
   SCHECK_NE(entry_batch_pb_->mono_time(), 0ULL, IllegalState, "Mono time should be specified");
   total_size_bytes_ = entry_batch_pb_->SerializedSize();
+  compressed_ = false;
   buffer_.resize(total_size_bytes_);
   entry_batch_pb_->SerializeToArray(buffer_.data());
 
@@ -1985,6 +2018,20 @@ Status Log::LogEntryBatch::Serialize() {
   return Status::OK();
 }
 
+void Log::LogEntryBatch::Compress() {
+  DCHECK_EQ(state_, kEntrySerialized);
+  if (compressed_ || buffer_.empty() ||
+      buffer_.size() < GetAtomicFlag(&FLAGS_log_compression_min_batch_size_bytes)) {
+    return;
+  }
+  faststring compressed;
+  if (CompressEntryBatch(Slice(buffer_), &compressed)) {
+    buffer_.assign_copy(compressed.data(), compressed.size());
+    total_size_bytes_ = buffer_.size();
+    compressed_ = true;
+  }
+}
+
 void Log::LogEntryBatch::MarkReady() {
   DCHECK_EQ(state_, kEntryReserved);
   state_ = kEntryReady;
@@ -38,6 +38,7 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
 
 #include "yb/common/hybrid_time.h"
 
@@ -150,7 +151,8 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 const size_t kEntryHeaderSize = 12;
 
 const int kLogMajorVersion = 1;
-const int kLogMinorVersion = 0;
+const int kLogMinorVersion = 1;
+const int kLogMinorVersionWithoutCompression = 0;
 
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
@@ -447,6 +449,13 @@ Result<bool> ReadableLogSegment::ReadHeader() {
                                                 header_size),
                         "Unable to parse protobuf");
   DCHECK(header.IsInitialized()) << "Log segment header must be initialized";
+  if (header.major_version() > implicit_cast<uint32_t>(kLogMajorVersion) ||
+      header.minor_version() > implicit_cast<uint32_t>(kLogMinorVersion)) {
+    return STATUS_FORMAT(
+        NotSupported, "Log segment $0 has version $1.$2, while max supported version is $3.$4",
+        path_, header.major_version(), header.minor_version(), kLogMajorVersion,
+        kLogMinorVersion);
+  }
 
   header_.CopyFrom(header);
   first_entry_offset_ = header_size + kLogSegmentHeaderMagicAndHeaderLength;
@@ -896,6 +905,8 @@ Status ReadableLogSegment::ReadEntryHeader(int64_t *offset, EntryHeader* header)
 Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* header) {
   DCHECK_EQ(kEntryHeaderSize, data.size());
   header->msg_length = DecodeFixed32(data.data());
+  header->compressed = (header->msg_length & kCompressedEntryBatchFlag) != 0;
+  header->msg_length &= ~kCompressedEntryBatchFlag;
   header->msg_crc = DecodeFixed32(data.data() + 4);
   header->header_crc = DecodeFixed32(data.data() + 8);
 
@@ -957,9 +968,25 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
     explicit DataHolder(const RefCntBuffer& buffer_) : buffer(buffer_) {}
   };
 
+  if (header.compressed) {
+    if (header_.minor_version() < implicit_cast<uint32_t>(kLogMinorVersion)) {
+      return STATUS_FORMAT(
+          Corruption, "Compressed entry at offset $0 in segment with log minor version $1",
+          *offset, header_.minor_version());
+    }
+    auto decompressed = DecompressEntryBatch(entry_batch_slice);
+    if (!decompressed.ok()) {
+      return STATUS_FORMAT(
+          Corruption, "Failed to decompress entry at offset: $0, length: $1. Cause: $2", *offset,
+          header.msg_length, decompressed.status());
+    }
+    buffer = std::move(*decompressed);
+  }
+
   auto holder = std::make_shared<DataHolder>(buffer);
   auto batch = holder->arena.NewArenaObject<LWLogEntryBatchPB>();
-  s = batch->ParseFromSlice(entry_batch_slice.Prefix(header.msg_length));
+  s = batch->ParseFromSlice(
+      header.compressed ? buffer.AsSlice() : entry_batch_slice.Prefix(header.msg_length));
 
   if (!s.ok()) {
     return STATUS_FORMAT(
@@ -1112,14 +1139,46 @@ Status WritableLogSegment::WriteIndexWithFooterAndClose(
   return Status::OK();
 }
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+bool CompressEntryBatch(Slice data, faststring* out) {
+  const auto input_size = narrow_cast<int>(data.size());
+  const auto bound = LZ4_compressBound(input_size);
+  out->resize(sizeof(uint32_t) + bound);
+  InlineEncodeFixed32(out->data(), narrow_cast<uint32_t>(data.size()));
+  const auto compressed_size = LZ4_compress_default(
+      data.cdata(), pointer_cast<char*>(out->data() + sizeof(uint32_t)), input_size, bound);
+  if (compressed_size <= 0 ||
+      sizeof(uint32_t) + static_cast<size_t>(compressed_size) >= data.size()) {
+    return false;
+  }
+  out->resize(sizeof(uint32_t) + compressed_size);
+  return true;
+}
+
+Result<RefCntBuffer> DecompressEntryBatch(Slice data) {
+  SCHECK_GE(data.size(), sizeof(uint32_t), Corruption, "Compressed entry batch is too short");
+  const auto uncompressed_size = DecodeFixed32(data.data());
+  data.remove_prefix(sizeof(uint32_t));
+  RefCntBuffer result(uncompressed_size);
+  const auto decompressed_size = LZ4_decompress_safe(
+      data.cdata(), result.data(), narrow_cast<int>(data.size()),
+      narrow_cast<int>(uncompressed_size));
+  if (decompressed_size < 0 || implicit_cast<uint32_t>(decompressed_size) != uncompressed_size) {
+    return STATUS_FORMAT(
+        Corruption, "Failed to decompress entry batch, expected $0 bytes, result: $1",
+        uncompressed_size, decompressed_size);
+  }
+  return result;
+}
+
+Status WritableLogSegment::WriteEntryBatch(const Slice& data, bool compressed) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
   uint8_t header_buf[kEntryHeaderSize];
 
-  // First encode the length of the message.
-  auto len = data.size();
-  InlineEncodeFixed32(&header_buf[0], narrow_cast<uint32_t>(len));
+  // First encode the length of the message, along with the compression flag.
+  auto len = narrow_cast<uint32_t>(data.size());
+  SCHECK_EQ(len & kCompressedEntryBatchFlag, 0U, InvalidArgument, "Too big entry batch");
+  InlineEncodeFixed32(&header_buf[0], compressed ? len | kCompressedEntryBatchFlag : len);
 
   // Then the CRC of the message.
   uint32_t msg_crc = crc::Crc32c(data.data(), data.size());
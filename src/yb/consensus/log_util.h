@@ -53,6 +53,7 @@
 #include "yb/util/env.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/status.h"
 #include "yb/util/tostring.h"
@@ -74,7 +75,23 @@ extern const char kTmpSuffix[];
 extern const size_t kEntryHeaderSize;
 
 extern const int kLogMajorVersion;
+// Segments with this minor version could contain compressed entry batches. Readers refuse segments
+// with a version greater than the one they support.
 extern const int kLogMinorVersion;
+// Minor version of segments without compressed entry batches, which could be read by versions that
+// do not support log compression.
+extern const int kLogMinorVersionWithoutCompression;
+
+// Set in the length field of a log entry header when the entry batch data is compressed, see
+// CompressEntryBatch.
+constexpr uint32_t kCompressedEntryBatchFlag = 1U << 31;
+
+// Compresses serialized entry batch `data` with LZ4 into `out`. Compressed batch is prefixed with
+// its uncompressed size. Returns false, when compression does not make batch smaller.
+bool CompressEntryBatch(Slice data, faststring* out);
+
+// Decompresses entry batch compressed by CompressEntryBatch.
+Result<RefCntBuffer> DecompressEntryBatch(Slice data);
 
 // Options for the Write Ahead Log. The LogOptions constructor initializes default field values
 // based on flags. See log_util.cc for details.
@@ -306,6 +323,9 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
     // The length of the batch data.
     uint32_t msg_length;
 
+    // Whether the batch data is compressed.
+    bool compressed;
+
     // The CRC32C of the batch data.
     uint32_t msg_crc;
 
@@ -434,7 +454,8 @@ class WritableLogSegment {
   // Appends the provided batch of data, including a header
   // and checksum.
   // Makes sure that the log segment has not been closed.
-  Status WriteEntryBatch(const Slice& entry_batch_data);
+  // `compressed` should be set when the data was compressed with CompressEntryBatch.
+  Status WriteEntryBatch(const Slice& entry_batch_data, bool compressed = false);
 
   // Makes sure the I/O buffers in the underlying writable file are flushed.
   Status Sync();
@@ -22,6 +22,7 @@
 #include "yb/rpc/periodic.h"
 
 #include "yb/util/flags.h"
+#include "yb/util/status_format.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -37,6 +38,12 @@ DEFINE_UNKNOWN_uint64(multi_raft_batch_size, 0,
               "Maximum batch size for a multi-Raft consensus payload. Ignored if set to zero.");
 TAG_FLAG(multi_raft_batch_size, advanced);
 
+DEFINE_RUNTIME_bool(enable_multi_raft_vote_batching, false,
+                    "If true and multi-Raft heartbeat batching is enabled, vote requests of leader "
+                    "elections are batched per destination tserver as well. Tablet servers of "
+                    "older versions do not implement the batched vote RPC, so keep it off until "
+                    "all tablet servers are upgraded.");
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
 namespace yb {
@@ -52,6 +59,18 @@ struct ResponseCallbackData {
   HeartbeatResponseCallback callback;
 };
 
+// Tracks a single VoteResponsePB as well as the callback of the leader election that waits for it.
+struct VoteCallbackData {
+  VoteResponsePB* resp;
+  rpc::ResponseCallback callback;
+};
+
+void SetVoteError(const Status& status, VoteResponsePB* resp) {
+  resp->Clear();
+  resp->mutable_error()->set_code(tserver::TabletServerErrorPB::UNKNOWN_ERROR);
+  StatusToPB(status, resp->mutable_error()->mutable_status());
+}
+
 }
 
 struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
@@ -61,6 +80,15 @@ struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
   std::vector<ResponseCallbackData> response_callback_data;
 };
 
+struct MultiRaftHeartbeatBatcher::MultiRaftVoteData {
+  MultiRaftVoteRequestPB batch_req;
+  MultiRaftVoteResponsePB batch_res;
+  rpc::RpcController controller;
+  // Max timeout of requests in the batch.
+  MonoDelta timeout;
+  std::vector<VoteCallbackData> callback_data;
+};
+
 MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
     const HostPort& hostport,
     rpc::ProxyCache* proxy_cache,
@@ -69,6 +97,7 @@ MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
     : messenger_(messenger),
       consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
       current_batch_(std::make_shared<MultiRaftConsensusData>()),
+      current_vote_batch_(std::make_shared<MultiRaftVoteData>()),
       running_calls_(running_calls) {}
 
 void MultiRaftHeartbeatBatcher::Start() {
@@ -88,6 +117,8 @@ MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
   std::lock_guard<std::mutex> lock(mutex_);
   LOG_IF(DFATAL, current_batch_ && !current_batch_->response_callback_data.empty())
       << "Not empty batch in ~MultiRaftHeartbeatBatcher";
+  LOG_IF(DFATAL, current_vote_batch_ && !current_vote_batch_->callback_data.empty())
+      << "Not empty vote batch in ~MultiRaftHeartbeatBatcher";
 }
 
 void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
@@ -110,13 +141,50 @@ void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
   SendBatchRequest(data);
 }
 
+void MultiRaftHeartbeatBatcher::AddVoteRequestToBatch(const VoteRequestPB& request,
+                                                      VoteResponsePB* response,
+                                                      MonoDelta timeout,
+                                                      rpc::ResponseCallback callback) {
+  std::shared_ptr<MultiRaftVoteData> data;
+  bool added = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (current_vote_batch_) {
+      added = true;
+      current_vote_batch_->callback_data.push_back({
+        .resp = response,
+        .callback = std::move(callback)
+      });
+      *current_vote_batch_->batch_req.add_vote_request() = request;
+      auto& batch_timeout = current_vote_batch_->timeout;
+      if (timeout.Initialized() && (!batch_timeout.Initialized() || timeout > batch_timeout)) {
+        batch_timeout = timeout;
+      }
+      if (FLAGS_multi_raft_batch_size > 0 &&
+          current_vote_batch_->callback_data.size() >= FLAGS_multi_raft_batch_size) {
+        data = PrepareNextVoteBatchRequest();
+      }
+    }
+  }
+  if (!added) {
+    // Batcher was shut down.
+    SetVoteError(STATUS(Aborted, "MultiRaft shutdown"), response);
+    callback();
+    return;
+  }
+  SendVoteBatchRequest(data);
+}
+
 void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   std::shared_ptr<MultiRaftConsensusData> data;
+  std::shared_ptr<MultiRaftVoteData> vote_data;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     data = PrepareNextBatchRequest();
+    vote_data = PrepareNextVoteBatchRequest();
   }
   SendBatchRequest(data);
+  SendVoteBatchRequest(vote_data);
 }
 
 std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
@@ -155,17 +223,70 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
       data->batch_req, &data->batch_res, &data->controller, callback);
 }
 
+std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftVoteData>
+    MultiRaftHeartbeatBatcher::PrepareNextVoteBatchRequest() {
+  if (!current_vote_batch_ || current_vote_batch_->callback_data.empty()) {
+    return nullptr;
+  }
+  auto data = std::make_shared<MultiRaftVoteData>();
+  current_vote_batch_.swap(data);
+  auto running_calls = ++*running_calls_;
+  LOG_IF(DFATAL, running_calls <= 0) << "Wrong number or running calls: " << running_calls;
+  return data;
+}
+
+void MultiRaftHeartbeatBatcher::SendVoteBatchRequest(std::shared_ptr<MultiRaftVoteData> data) {
+  if (!data) {
+    return;
+  }
+
+  data->controller.Reset();
+  data->controller.set_timeout(
+      data->timeout.Initialized() ? data->timeout
+                                  : MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  auto callback = [data, running_calls = running_calls_]() {
+    --*running_calls;
+    auto status = data->controller.status();
+    if (status.ok() &&
+        data->batch_res.vote_response_size() != data->batch_req.vote_request_size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of vote responses: $0, expected: $1",
+          data->batch_res.vote_response_size(), data->batch_req.vote_request_size());
+    }
+    for (int i = 0; i < data->batch_req.vote_request_size(); i++) {
+      auto& callback_data = data->callback_data[i];
+      // Leader election checks the status of its own controller, which is never used for a
+      // batched request, so the batch failure is reported as an error of each response.
+      if (status.ok()) {
+        callback_data.resp->Swap(data->batch_res.mutable_vote_response(i));
+      } else {
+        SetVoteError(status, callback_data.resp);
+      }
+      callback_data.callback();
+    }
+  };
+  consensus_proxy_->MultiRaftRequestConsensusVoteAsync(
+      data->batch_req, &data->batch_res, &data->controller, callback);
+}
+
 void MultiRaftHeartbeatBatcher::Shutdown() {
   decltype(current_batch_) batch;
+  decltype(current_vote_batch_) vote_batch;
   batch_sender_->Stop();
   {
     std::lock_guard<std::mutex> lock(mutex_);
     batch.swap(current_batch_);
+    vote_batch.swap(current_vote_batch_);
   }
   static const Status status = STATUS(Aborted, "MultiRaft shutdown");
   for (const auto& callback : batch->response_callback_data) {
     callback.callback(status);
   }
+  for (const auto& callback_data : vote_batch->callback_data) {
+    SetVoteError(status, callback_data.resp);
+    callback_data.callback();
+  }
 }
 
 MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger,
@@ -42,6 +42,9 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 //   FLAGS_multi_raft_batch_size
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
+// - Vote requests of leader elections could be batched the same way, in a separate batch that
+//   is sent together with the heartbeat batch, so a tserver restart does not produce a vote RPC
+//   per tablet
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
  public:
   MultiRaftHeartbeatBatcher(const HostPort& hostport,
@@ -62,6 +65,13 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
                          ConsensusResponsePB* response,
                          HeartbeatResponseCallback callback);
 
+  // Adds a copy of the vote request to the vote batch. The callback is executed once the response
+  // is populated. If the batch rpc call fails, the error is reported in response->error().
+  void AddVoteRequestToBatch(const VoteRequestPB& request,
+                             VoteResponsePB* response,
+                             MonoDelta timeout,
+                             rpc::ResponseCallback callback);
+
   void Shutdown();
 
  private:
@@ -69,6 +79,9 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   // ResponseCallbackData registered by each local peer with this batch in AddRequestToBatch().
   struct MultiRaftConsensusData;
 
+  // The same for vote requests registered with AddVoteRequestToBatch().
+  struct MultiRaftVoteData;
+
   void PrepareAndSendBatchRequest();
 
   // This method will return a nullptr if the current batch is empty.
@@ -79,6 +92,11 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void MultiRaftUpdateHeartbeatResponseCallback(std::shared_ptr<MultiRaftConsensusData> data);
 
+  // This method will return a nullptr if the current vote batch is empty.
+  std::shared_ptr<MultiRaftVoteData> PrepareNextVoteBatchRequest() REQUIRES(mutex_);
+
+  void SendVoteBatchRequest(std::shared_ptr<MultiRaftVoteData> data);
+
   rpc::Messenger* messenger_;
 
   ConsensusServiceProxyPtr consensus_proxy_;
@@ -89,6 +107,8 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   std::shared_ptr<MultiRaftConsensusData> current_batch_ GUARDED_BY(mutex_);
 
+  std::shared_ptr<MultiRaftVoteData> current_vote_batch_ GUARDED_BY(mutex_);
+
   std::atomic<int>* running_calls_;
 };
 
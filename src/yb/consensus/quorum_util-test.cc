@@ -74,5 +74,20 @@ TEST(QuorumUtilTest, TestMemberExtraction) {
   ASSERT_EQ("B", peer_pb.permanent_uuid());
 }
 
+TEST(QuorumUtilTest, TestWitness) {
+  RaftConfigPB config;
+  SetPeerInfo("A", PeerMemberType::VOTER, config.add_peers());
+  SetPeerInfo("B", PeerMemberType::VOTER, config.add_peers());
+  auto* witness = config.add_peers();
+  SetPeerInfo("C", PeerMemberType::VOTER, witness);
+  witness->set_witness(true);
+
+  ASSERT_FALSE(IsWitness("A", config));
+  ASSERT_TRUE(IsWitness("C", config));
+  ASSERT_FALSE(IsWitness("invalid", config));
+  // Witness is still a voter.
+  ASSERT_TRUE(IsRaftConfigVoter("C", config));
+}
+
 } // namespace consensus
 } // namespace yb
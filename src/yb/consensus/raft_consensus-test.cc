@@ -111,14 +111,17 @@ class MockQueue : public PeerMessageQueue {
                                             RestartSafeCoarseTimePoint time));
   MOCK_METHOD1(TrackPeer, void(const string&));
   MOCK_METHOD1(UntrackPeer, void(const string&));
-  MOCK_METHOD6(RequestForPeer, Status(const std::string& uuid,
+  MOCK_METHOD8(RequestForPeer, Status(const std::string& uuid,
                                       LWConsensusRequestPB* request,
                                       LWReplicateMsgsHolder* msgs_holder,
                                       bool* needs_remote_bootstrap,
                                       PeerMemberType* member_type,
-                                      bool* last_exchange_successful));
-  MOCK_METHOD2(ResponseFromPeer, bool(const std::string& peer_uuid,
-                                      const LWConsensusResponsePB& response));
+                                      bool* last_exchange_successful,
+                                      Pipelined pipelined,
+                                      SentRequestInfo* sent_request));
+  MOCK_METHOD3(ResponseFromPeer, bool(const std::string& peer_uuid,
+                                      const LWConsensusResponsePB& response,
+                                      const SentRequestInfo* sent_request));
   MOCK_METHOD0(Close, void());
 };
 
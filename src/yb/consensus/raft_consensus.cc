@@ -338,7 +338,7 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     MultiRaftManager* multi_raft_manager) {
 
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
-    messenger, proxy_cache, local_peer_pb.cloud_info());
+    messenger, proxy_cache, local_peer_pb.cloud_info(), multi_raft_manager);
 
   // The message queue that keeps track of which operations need to be replicated
   // where.
@@ -1405,6 +1405,20 @@ void RaftConsensus::UpdateMajorityReplicated(
     delayed_step_down_.term = OpId::kUnknownTerm;
   }
 
+  if (!majority_replicated_data.peer_got_all_ops.empty() &&
+      state_->GetActiveRoleUnlocked() == PeerRole::LEADER &&
+      IsWitness(state_->GetPeerUuid(), state_->GetActiveConfigUnlocked())) {
+    // Witness does not have the data to serve as a leader, so it hands leadership over to the
+    // first full voter that got all ops.
+    const auto* peer = FindPeer(
+        state_->GetActiveConfigUnlocked(), majority_replicated_data.peer_got_all_ops);
+    if (peer && peer->member_type() == PeerMemberType::VOTER && !peer->witness()) {
+      LOG_WITH_PREFIX(INFO) << "Witness synchronized full voter: " << peer->permanent_uuid();
+      WARN_NOT_OK(StartStepDownUnlocked(*peer, /* graceful= */ false),
+                  "Start step down failed");
+    }
+  }
+
   if (committed_index_changed &&
       state_->GetActiveRoleUnlocked() == PeerRole::LEADER) {
     // If all operations were just committed, and we don't have pending operations, then
@@ -2011,12 +2025,24 @@ Result<RaftConsensus::UpdateReplicaResult> RaftConsensus::UpdateReplica(
   }
   follower_last_update_time_ms_metric_->UpdateTimestampInMilliseconds(
       (update_time_ms > 0 ? update_time_ms : clock_->Now().GetPhysicalValueMicros() / 1000));
+  if (request.has_all_replicated_op_id()) {
+    witness_all_replicated_index_.store(
+        request.all_replicated_op_id().index(), std::memory_order_release);
+  }
+  if (request.has_follower_read_lease_expiration()) {
+    follower_read_lease_expiration_.store(
+        request.follower_read_lease_expiration(), std::memory_order_release);
+  }
   TRACE("UpdateReplica() finished");
   return result;
 }
 
 Status RaftConsensus::EarlyCommitUnlocked(const LWConsensusRequestPB& request,
                                           const LeaderRequest& deduped_req) {
+  if (PREDICT_FALSE(TEST_pause_apply_.load(std::memory_order_acquire))) {
+    return Status::OK();
+  }
+
   // What should we commit?
   // 1. As many pending operations as we can, except...
   // 2. ...if we commit beyond the preceding index, we'd regress KUDU-639
@@ -2223,6 +2249,10 @@ Status RaftConsensus::MarkOperationsAsCommittedUnlocked(const LWConsensusRequest
     state_->UpdateLastReceivedOpIdFromCurrentLeaderIfEmptyUnlocked(deduped_req.preceding_op_id);
   }
 
+  if (PREDICT_FALSE(TEST_pause_apply_.load(std::memory_order_acquire))) {
+    return Status::OK();
+  }
+
   VLOG_WITH_PREFIX(1) << "Marking committed up to " << apply_up_to;
   TRACE(Format("Marking committed up to $0", apply_up_to));
   return ResultToStatus(state_->AdvanceCommittedOpIdUnlocked(apply_up_to, CouldStop::kTrue));
@@ -3028,6 +3058,15 @@ PeerRole RaftConsensus::GetRoleUnlocked() const {
   return state_->GetActiveRoleUnlocked();
 }
 
+bool RaftConsensus::HasFollowerReadLease() const {
+  HybridTime expiration(follower_read_lease_expiration_.load(std::memory_order_acquire));
+  // Our clock could lag behind the clock of the leader by up to the max clock skew.
+  if (clock_->MaxGlobalNow() >= expiration) {
+    return false;
+  }
+  return role() == PeerRole::FOLLOWER;
+}
+
 PeerRole RaftConsensus::role() const {
   auto lock = state_->LockForRead();
   return GetRoleUnlocked();
@@ -3515,6 +3554,15 @@ Result<ReadOpsResult> RaftConsensus::ReadReplicatedMessagesForCDC(
       from, last_replicated_opid_index, deadline, fetch_single_entry);
 }
 
+uint64_t RaftConsensus::RegisterCommittedOpIdWaiter(
+    int64_t index, CommittedOpIdWaiter waiter) {
+  return queue_->RegisterCommittedOpIdWaiter(index, std::move(waiter));
+}
+
+bool RaftConsensus::RemoveCommittedOpIdWaiter(uint64_t id) {
+  return queue_->RemoveCommittedOpIdWaiter(id);
+}
+
 void RaftConsensus::UpdateCDCConsumerOpId(const yb::OpId& op_id) {
   return queue_->UpdateCDCConsumerOpId(op_id);
 }
@@ -246,6 +246,16 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   yb::OpId MinRetryableRequestOpId();
 
+  // Index of the latest op replicated to all peers, as reported by the leader. Only reported to
+  // witnesses, 0 otherwise.
+  int64_t WitnessAllReplicatedIndex() const {
+    return witness_all_replicated_index_.load(std::memory_order_acquire);
+  }
+
+  // Whether this peer is a follower that holds an unexpired read lease granted by the leader, see
+  // ConsensusRequestPB::follower_read_lease_expiration.
+  bool HasFollowerReadLease() const;
+
   Status StartElection(const LeaderElectionData& data) override {
     return DoStartElection(data, PreElected::kFalse);
   }
@@ -265,12 +275,22 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
     TEST_delay_update_.store(duration, std::memory_order_release);
   }
 
+  // When set, the follower keeps received operations without applying them, even after the leader
+  // reports them as committed.
+  void TEST_PauseApply(bool value) {
+    TEST_pause_apply_.store(value, std::memory_order_release);
+  }
+
   Result<ReadOpsResult> ReadReplicatedMessagesForCDC(
       const yb::OpId& from,
       int64_t* last_replicated_opid_index,
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
       const bool fetch_single_entry = false) override;
 
+  uint64_t RegisterCommittedOpIdWaiter(int64_t index, CommittedOpIdWaiter waiter) override;
+
+  bool RemoveCommittedOpIdWaiter(uint64_t id) override;
+
   void UpdateCDCConsumerOpId(const yb::OpId& op_id) override;
 
   // Start memory tracking of following operation in case it is still present in our caches.
@@ -748,8 +768,14 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   std::atomic<MonoDelta> TEST_delay_update_{MonoDelta::kZero};
 
+  std::atomic<bool> TEST_pause_apply_{false};
+
   std::atomic<uint64_t> majority_num_sst_files_{0};
 
+  std::atomic<int64_t> witness_all_replicated_index_{0};
+
+  std::atomic<uint64_t> follower_read_lease_expiration_{0};
+
   const TabletId split_parent_tablet_id_;
 
   DISALLOW_COPY_AND_ASSIGN(RaftConsensus);
@@ -227,8 +227,9 @@ LeaderState ReplicaState::GetLeaderStateUnlocked(
     return result.MakeNotReadyLeader(LeaderStatus::NOT_LEADER);
   }
 
-  if (!leader_no_op_committed_) {
+  if (!leader_no_op_committed_ || IsWitness(peer_uuid_, GetActiveConfigUnlocked())) {
     // This will cause the client to retry on the same server (won't try to find the new leader).
+    // Witness is leader only until a full voter catches up, see RaftPeerPB::witness.
     return result.MakeNotReadyLeader(LeaderStatus::LEADER_BUT_NO_OP_NOT_COMMITTED);
   }
 
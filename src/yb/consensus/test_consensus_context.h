@@ -28,6 +28,8 @@ class TestConsensusContext : public ConsensusContext {
 
   Result<HybridTime> PreparePeerRequest() override { return HybridTime(); }
 
+  bool FollowerReadLeasesEnabled() override { return false; }
+
   void MajorityReplicated() override {}
 
   void ChangeConfigReplicated(const RaftConfigPB&) override {}
@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <vector>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/doc_pg_expr.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_uint32(ysql_pg_expr_executor_cache_size);
+
+namespace yb::docdb {
+
+class DocPgExprExecutorCacheTest : public YBTest {
+ protected:
+  DocPgExprExecutor BuildExecutor() {
+    return CHECK_RESULT(
+        DocPgExprExecutorBuilder(schema_).Build(std::vector<PgsqlColRefPB>()));
+  }
+
+  void Put(DocPgExprExecutorCache* cache, const std::string& key) {
+    cache->Put(std::string(key), BuildExecutor());
+  }
+
+  Schema schema_;
+};
+
+TEST_F(DocPgExprExecutorCacheTest, HitMissEviction) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_pg_expr_executor_cache_size) = 2;
+  DocPgExprExecutorCache cache;
+
+  ASSERT_FALSE(cache.Take("a").has_value());
+  Put(&cache, "a");
+  ASSERT_TRUE(cache.Take("a").has_value());
+  // Executor is removed from the cache while in use.
+  ASSERT_FALSE(cache.Take("a").has_value());
+
+  // Executors of concurrent scans with the same key are cached separately.
+  Put(&cache, "a");
+  Put(&cache, "a");
+  ASSERT_TRUE(cache.Take("a").has_value());
+  ASSERT_TRUE(cache.Take("a").has_value());
+
+  Put(&cache, "a");
+  Put(&cache, "b");
+  // Cache is full, so the least recently put "a" is evicted.
+  Put(&cache, "c");
+  ASSERT_FALSE(cache.Take("a").has_value());
+  ASSERT_TRUE(cache.Take("b").has_value());
+  ASSERT_TRUE(cache.Take("c").has_value());
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(stats.hits, 5U);
+  ASSERT_EQ(stats.misses, 3U);
+  ASSERT_EQ(stats.evictions, 1U);
+}
+
+TEST_F(DocPgExprExecutorCacheTest, Disabled) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_pg_expr_executor_cache_size) = 0;
+  DocPgExprExecutorCache cache;
+
+  Put(&cache, "a");
+  ASSERT_FALSE(cache.Take("a").has_value());
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(stats.hits, 0U);
+  ASSERT_EQ(stats.misses, 1U);
+}
+
+} // namespace yb::docdb
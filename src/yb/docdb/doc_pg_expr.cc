@@ -26,10 +26,16 @@
 
 #include "ybgate/ybgate_api.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 
 #include "yb/yql/pggate/pg_value.h"
 
+DEFINE_RUNTIME_uint32(ysql_pg_expr_executor_cache_size, 32,
+                      "Maximal number of built Postgres expression executors cached per table "
+                      "schema version. Cached executors are reused by subsequent pages and "
+                      "repeated executions of the same scan. 0 disables caching.");
+
 namespace yb::docdb {
 namespace {
 
@@ -383,4 +389,53 @@ DocPgExprExecutor DocPgExprExecutorBuilder::DoBuild() {
   return DocPgExprExecutor(std::move(state));
 }
 
+DocPgExprExecutorCache::DocPgExprExecutorCache() = default;
+
+DocPgExprExecutorCache::~DocPgExprExecutorCache() = default;
+
+std::optional<DocPgExprExecutor> DocPgExprExecutorCache::Take(const std::string& key) {
+  std::lock_guard lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+  ++stats_.hits;
+  auto entry = it->second;
+  index_.erase(it);
+  std::optional<DocPgExprExecutor> result(std::move(entry->second));
+  entries_.erase(entry);
+  return result;
+}
+
+void DocPgExprExecutorCache::Put(std::string&& key, DocPgExprExecutor&& executor) {
+  // Evicted executors are destroyed outside of the lock.
+  Entries evicted;
+  std::lock_guard lock(mutex_);
+  const size_t capacity = FLAGS_ysql_pg_expr_executor_cache_size;
+  if (capacity == 0) {
+    evicted.emplace_back(std::move(key), std::move(executor));
+    return;
+  }
+  entries_.emplace_front(std::move(key), std::move(executor));
+  index_.emplace(entries_.front().first, entries_.begin());
+  while (entries_.size() > capacity) {
+    auto last = std::prev(entries_.end());
+    auto range = index_.equal_range(last->first);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        index_.erase(it);
+        break;
+      }
+    }
+    evicted.splice(evicted.end(), entries_, last);
+    ++stats_.evictions;
+  }
+}
+
+DocPgExprExecutorCache::Stats DocPgExprExecutorCache::GetStats() const {
+  std::lock_guard lock(mutex_);
+  return stats_;
+}
+
 }  // namespace yb::docdb
@@ -14,11 +14,19 @@
 #pragma once
 
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "yb/common/pgsql_protocol.fwd.h"
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/qlexpr/ql_expr.h"
 
 #include "yb/util/result.h"
@@ -111,5 +119,74 @@ class DocPgExprExecutorBuilder {
   std::unique_ptr<DocPgExprExecutor::State> state_;
 };
 
+// Cache of executors built for the where clauses of the read requests.
+//
+// Deserialization of the Postgres expressions is relatively expensive, while the same expressions
+// are sent with every page of the scan and with every execution of the same prepared statement.
+// Cached executors refer the schema they were built for, so every DocReadContext has its own cache.
+// Executor could be used by one scan at a time, so it is removed from the cache while in use and
+// put back when the scan is complete. When the cache is full, the least recently used executor is
+// evicted.
+class DocPgExprExecutorCache {
+ public:
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+  };
+
+  DocPgExprExecutorCache();
+  ~DocPgExprExecutorCache();
+
+  // Returns the key identifying the executor for specified where clauses and column references.
+  // Returns empty string if such executor could not be cached.
+  // Postgres inlines the bind values into the serialized expressions as constants, so the key is
+  // the expression tree together with those constants.
+  template <class WhereClauses, class ColumnRefs>
+  static std::string BuildKey(const WhereClauses& where_clauses, const ColumnRefs& col_refs) {
+    std::string result;
+    for (const auto& expr : where_clauses) {
+      // Condition filter refers the request it was built from, so it could not be reused.
+      if (!expr.has_tscall()) {
+        return std::string();
+      }
+      AppendToKey(expr, &result);
+    }
+    for (const auto& col_ref : col_refs) {
+      AppendToKey(col_ref, &result);
+    }
+    return result;
+  }
+
+  // Removes the executor for the specified key from the cache and returns it.
+  std::optional<DocPgExprExecutor> Take(const std::string& key);
+
+  // Puts the executor back to the cache, evicting the least recently used executors if the cache
+  // is full.
+  void Put(std::string&& key, DocPgExprExecutor&& executor);
+
+  Stats GetStats() const;
+
+ private:
+  template <class PB>
+  static void AppendToKey(const PB& pb, std::string* out) {
+    const uint64_t size = pb.ByteSizeLong();
+    out->append(reinterpret_cast<const char*>(&size), sizeof(size));
+    pb.AppendToString(out);
+  }
+
+  using Entry = std::pair<std::string, DocPgExprExecutor>;
+  using Entries = std::list<Entry>;
+
+  mutable std::mutex mutex_;
+  // Most recently put executors are at the front.
+  Entries entries_ GUARDED_BY(mutex_);
+  // Keys refer the strings stored in entries_.
+  std::unordered_multimap<std::string_view, Entries::iterator> index_ GUARDED_BY(mutex_);
+  Stats stats_ GUARDED_BY(mutex_);
+};
+
+using DocPgExprExecutorCachePtr = std::shared_ptr<DocPgExprExecutorCache>;
+
 } // namespace docdb
 } // namespace yb
@@ -13,18 +13,22 @@
 
 #include "yb/docdb/doc_read_context.h"
 
+#include "yb/docdb/doc_pg_expr.h"
+
 #include "yb/util/logging.h"
 
 namespace yb::docdb {
 
 DocReadContext::DocReadContext(const std::string& log_prefix, TableType table_type)
-    : schema_packing_storage(table_type), log_prefix_(log_prefix) {
+    : schema_packing_storage(table_type), log_prefix_(log_prefix),
+      pg_expr_executor_cache_(std::make_shared<DocPgExprExecutorCache>()) {
 }
 
 DocReadContext::DocReadContext(
     const std::string& log_prefix, TableType table_type, const Schema& schema_,
     SchemaVersion schema_version)
-    : schema(schema_), schema_packing_storage(table_type), log_prefix_(log_prefix) {
+    : schema(schema_), schema_packing_storage(table_type), log_prefix_(log_prefix),
+      pg_expr_executor_cache_(std::make_shared<DocPgExprExecutorCache>()) {
   schema_packing_storage.AddSchema(schema_version, schema_);
   LOG_IF_WITH_PREFIX(INFO, schema_version != 0)
       << "DocReadContext, from schema, version: " << schema_version;
@@ -33,7 +37,8 @@ DocReadContext::DocReadContext(
 DocReadContext::DocReadContext(
     const DocReadContext& rhs, const Schema& schema_, SchemaVersion schema_version)
     : schema(schema_), schema_packing_storage(rhs.schema_packing_storage),
-      log_prefix_(rhs.log_prefix_) {
+      log_prefix_(rhs.log_prefix_),
+      pg_expr_executor_cache_(std::make_shared<DocPgExprExecutorCache>()) {
   schema_packing_storage.AddSchema(schema_version, schema_);
   LOG_WITH_PREFIX(INFO)
       << "DocReadContext, copy and add: " << schema_packing_storage.VersionsToString()
@@ -42,13 +47,31 @@ DocReadContext::DocReadContext(
 
 DocReadContext::DocReadContext(const DocReadContext& rhs, SchemaVersion min_schema_version)
     : schema(rhs.schema), schema_packing_storage(rhs.schema_packing_storage, min_schema_version),
-      log_prefix_(rhs.log_prefix_) {
+      log_prefix_(rhs.log_prefix_),
+      pg_expr_executor_cache_(std::make_shared<DocPgExprExecutorCache>()) {
   LOG_WITH_PREFIX(INFO)
       << "DocReadContext, copy and filter: " << rhs.schema_packing_storage.VersionsToString()
       << " => " << schema_packing_storage.VersionsToString() << ", min_schema_version: "
       << min_schema_version;
 }
 
+DocReadContext::DocReadContext(const DocReadContext& rhs)
+    : schema(rhs.schema), schema_packing_storage(rhs.schema_packing_storage),
+      log_prefix_(rhs.log_prefix_),
+      pg_expr_executor_cache_(std::make_shared<DocPgExprExecutorCache>()) {
+}
+
+DocReadContext& DocReadContext::operator=(const DocReadContext& rhs) {
+  schema = rhs.schema;
+  schema_packing_storage = rhs.schema_packing_storage;
+  log_prefix_ = rhs.log_prefix_;
+  // Executors cached for the old schema are no longer valid.
+  pg_expr_executor_cache_ = std::make_shared<DocPgExprExecutorCache>();
+  return *this;
+}
+
+DocReadContext::~DocReadContext() = default;
+
 void DocReadContext::LogAfterLoad() {
   LOG_WITH_PREFIX(INFO) << __func__ << ": " << schema_packing_storage.VersionsToString();
 }
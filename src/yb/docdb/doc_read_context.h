@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "yb/common/schema.h"
 #include "yb/common/schema_pbutil.h"
 #include "yb/common/wire_protocol.h"
@@ -22,6 +24,8 @@
 namespace yb {
 namespace docdb {
 
+class DocPgExprExecutorCache;
+
 struct DocReadContext {
   explicit DocReadContext(const std::string& log_prefix, TableType table_type);
 
@@ -33,6 +37,11 @@ struct DocReadContext {
 
   DocReadContext(const DocReadContext& rhs, SchemaVersion min_schema_version);
 
+  DocReadContext(const DocReadContext& rhs);
+  DocReadContext& operator=(const DocReadContext& rhs);
+
+  ~DocReadContext();
+
   template <class PB>
   Status LoadFromPB(const PB& pb) {
     RETURN_NOT_OK(SchemaFromPB(pb.schema(), &schema));
@@ -57,7 +66,7 @@ struct DocReadContext {
     schema_packing_storage.ToPB(schema_version, out->mutable_old_schema_packings());
   }
 
-  // Should account for every field in DocReadContext.
+  // Should account for every field in DocReadContext, except caches.
   static bool TEST_Equals(const DocReadContext& lhs, const DocReadContext& rhs) {
     return Schema::TEST_Equals(lhs.schema, rhs.schema) &&
         lhs.schema_packing_storage == rhs.schema_packing_storage;
@@ -67,6 +76,12 @@ struct DocReadContext {
     return DocReadContext("TEST: ", TableType::YQL_TABLE_TYPE, schema, 0);
   }
 
+  // Executors for the where clauses of YSQL read requests built for the schema of this context.
+  // Shared, so a scan could return the executor after this context was replaced.
+  const std::shared_ptr<DocPgExprExecutorCache>& pg_expr_executor_cache() const {
+    return pg_expr_executor_cache_;
+  }
+
   Schema schema;
   dockv::SchemaPackingStorage schema_packing_storage;
 
@@ -79,6 +94,10 @@ struct DocReadContext {
   }
 
   std::string log_prefix_;
+
+  // Cached executors refer the schema of this particular instance, so the cache is never copied,
+  // every instance gets its own one.
+  std::shared_ptr<DocPgExprExecutorCache> pg_expr_executor_cache_;
 };
 
 } // namespace docdb
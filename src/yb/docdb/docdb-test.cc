@@ -25,6 +25,7 @@
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.messages.h"
+#include "yb/docdb/docdb_compaction_context.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
@@ -70,6 +71,9 @@ using namespace std::literals;
 DECLARE_bool(TEST_docdb_sort_weak_intents);
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int64(db_block_size_bytes);
+DECLARE_uint32(rocksdb_max_subcompactions);
+DECLARE_uint64(rocksdb_min_subcompaction_input_size_bytes);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -2493,6 +2497,53 @@ TEST_F(DocDBTestQl, YsqlSystemTableTombstoneCompaction) {
       ASSERT_RESULT(Uuid::FromString("66666666-7777-8888-9999-000000000000")));
 }
 
+// Table tombstone of a colocated table should remove rows of this table from all subcompactions.
+TEST_F(DocDBTestQl, ColocatedTableTombstoneSubcompactions) {
+  constexpr ColocationId kTruncatedTable = 0x4001;
+  constexpr ColocationId kOtherTable = 0x4002;
+  constexpr int kNumRows = 2000;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_db_block_size_bytes) = 1_KB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_max_subcompactions) = 4;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_min_subcompaction_input_size_bytes) = 1;
+  regular_db_options_.subcompaction_boundary_aligner = CreateSubcompactionBoundaryAligner();
+  ASSERT_OK(ReinitDBOptions());
+
+  for (auto id : {kTruncatedTable, kOtherTable}) {
+    for (int i = 0; i != kNumRows; ++i) {
+      DocKey doc_key(id);
+      doc_key.ResizeRangeComponents(1);
+      doc_key.SetRangeComponent(KeyEntryValue(Format("row$0", i)), 0 /* idx */);
+      ASSERT_OK(SetPrimitive(
+          DocPath(doc_key.Encode(), KeyEntryValue::kLivenessColumn),
+          ValueRef(ValueEntryType::kNullLow), 1000_usec_ht));
+    }
+  }
+  // Pack rows of both tables, so packed rows are present on both sides of subcompaction
+  // boundaries.
+  FullyCompactHistoryBefore(1500_usec_ht);
+  ASSERT_GT(NumSSTableFiles(), 1U);
+
+  // Simulate SQL:
+  //   TRUNCATE TABLE t;
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(kTruncatedTable).Encode()), ValueRef(ValueEntryType::kTombstone),
+      2000_usec_ht));
+  FullyCompactHistoryBefore(3000_usec_ht);
+
+  std::map<ColocationId, int> rows_per_table;
+  rocksdb::ReadOptions read_opts;
+  read_opts.query_id = rocksdb::kDefaultQueryId;
+  unique_ptr<rocksdb::Iterator> iter(doc_db().regular->NewIterator(read_opts));
+  for (iter->SeekToFirst(); ASSERT_RESULT(iter->CheckedValid()); iter->Next()) {
+    DocKey doc_key;
+    ASSERT_OK(doc_key.DecodeFrom(iter->key(), dockv::DocKeyPart::kUpToId));
+    ++rows_per_table[doc_key.colocation_id()];
+  }
+  ASSERT_EQ(rows_per_table[kTruncatedTable], 0);
+  ASSERT_EQ(rows_per_table[kOtherTable], kNumRows);
+}
+
 TEST_P(DocDBTestWrapper, MinorCompactionNoDeletions) {
   ASSERT_OK(DisableCompactions());
   const auto doc_key = MakeDocKey("k");
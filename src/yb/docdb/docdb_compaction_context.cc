@@ -1162,6 +1162,30 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
   });
 }
 
+std::shared_ptr<rocksdb::SubcompactionBoundaryAligner> CreateSubcompactionBoundaryAligner() {
+  return std::make_shared<rocksdb::SubcompactionBoundaryAligner>([](Slice user_key) {
+    // Sampled keys are taken from the index, so they could be shortened and not decodable.
+    if (user_key.empty()) {
+      return std::string();
+    }
+    auto key_type = dockv::DecodeKeyEntryType(user_key[0]);
+    if (dockv::IsInternalRecordKeyType(key_type)) {
+      return std::string();
+    }
+    // Table tombstone of a colocated table is applied to all rows with the same cotable prefix
+    // only inside the compaction context that has seen it. So the whole colocated table should be
+    // processed by the same subcompaction.
+    auto part = key_type == dockv::KeyEntryType::kColocationId ||
+                key_type == dockv::KeyEntryType::kTableId
+        ? dockv::DocKeyPart::kUpToId : dockv::DocKeyPart::kWholeDocKey;
+    auto doc_key_size = dockv::DocKey::EncodedSize(user_key, part);
+    if (!doc_key_size.ok() || *doc_key_size == 0) {
+      return std::string();
+    }
+    return user_key.Prefix(*doc_key_size).ToBuffer();
+  });
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
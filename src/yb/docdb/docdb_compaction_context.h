@@ -111,6 +111,11 @@ std::shared_ptr<rocksdb::CompactionContextFactory> CreateCompactionContextFactor
     const DeleteMarkerRetentionTimeProvider& delete_marker_retention_provider,
     SchemaPackingProvider* schema_packing_provider);
 
+// Aligns subcompaction boundaries to the start of the document, so all records of a row are
+// processed by the same compaction context. For colocated tables boundaries are aligned to the
+// start of the table, so the table tombstone is processed together with all rows of the table.
+std::shared_ptr<rocksdb::SubcompactionBoundaryAligner> CreateSubcompactionBoundaryAligner();
+
 // A history retention policy that can be configured manually. Useful in tests. This class is
 // useful for testing and is thread-safe.
 class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
@@ -47,6 +47,7 @@ class RedisWriteOperation;
 class ScanChoices;
 class SharedLockManager;
 class TransactionStatusCache;
+class TransactionIntentsCache;
 class WaitQueue;
 class YQLRowwiseIteratorIf;
 class YQLStorageIf;
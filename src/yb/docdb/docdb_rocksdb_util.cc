@@ -102,6 +102,15 @@ DEFINE_UNKNOWN_string(rocksdb_compact_flush_rate_limit_sharing_mode, "tserver",
               "  none - rate limit is calculated independently for every RocksDB instance");
 DEFINE_UNKNOWN_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
+DEFINE_NON_RUNTIME_uint32(rocksdb_max_subcompactions, 1,
+                          "Max number of parallel subcompactions a single compaction of a regular "
+                          "DB is split into. Subcompaction boundaries are sampled from the indexes "
+                          "of the input files and aligned to document keys. 1 disables "
+                          "subcompactions.");
+
+DEFINE_NON_RUNTIME_uint64(rocksdb_min_subcompaction_input_size_bytes, 1_GB,
+                          "Min size of the compaction input processed by a single subcompaction.");
+
 DEFINE_UNKNOWN_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
 DEFINE_UNKNOWN_int32(rocksdb_max_write_buffer_number, 2,
@@ -755,6 +764,8 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max<uint32_t>(FLAGS_rocksdb_max_subcompactions, 1);
+    options->min_subcompaction_input_size = FLAGS_rocksdb_min_subcompaction_input_size_bytes;
     options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
                                                         : CreateRocksDBRateLimiter();
   } else {
@@ -253,6 +253,12 @@ class FilteringIterator {
   explicit FilteringIterator(std::unique_ptr<YQLRowwiseIteratorIf>* iterator_holder)
       : iterator_holder_(*iterator_holder) {}
 
+  ~FilteringIterator() {
+    if (filter_ && filter_cache_) {
+      filter_cache_->Put(std::move(filter_key_), std::move(*filter_));
+    }
+  }
+
   Status Init(
       const YQLStorageIf& ql_storage,
       const PgsqlReadRequestPB& request,
@@ -263,7 +269,7 @@ class FilteringIterator {
       const ReadHybridTime& read_time,
       bool is_explicit_request_read_time,
       const DocDBStatistics* statistics) {
-    RETURN_NOT_OK(InitCommon(request, read_context.get().schema, projection));
+    RETURN_NOT_OK(InitCommon(request, read_context, projection));
     iterator_holder_ = VERIFY_RESULT(CreateIterator(
         ql_storage, request, *projection, read_context, txn_op_context, deadline,
         read_time, is_explicit_request_read_time, statistics));
@@ -281,7 +287,7 @@ class FilteringIterator {
       const QLValuePB& min_ybctid,
       const QLValuePB& max_ybctid,
       const docdb::DocDBStatistics* statistics) {
-    RETURN_NOT_OK(InitCommon(request, read_context.get().schema, projection));
+    RETURN_NOT_OK(InitCommon(request, read_context, projection));
     return ql_storage.GetIterator(
         request.stmt_id(), *projection, read_context, txn_op_context, deadline,
         read_time, min_ybctid, max_ybctid, &iterator_holder_, statistics);
@@ -305,13 +311,26 @@ class FilteringIterator {
  private:
   Status InitCommon(
       const PgsqlReadRequestPB& request,
-      const Schema& schema,
+      const DocReadContext& read_context,
       dockv::ReaderProjection* projection) {
+    const auto& schema = read_context.schema;
     Reset(projection, schema, request);
     const auto& where_clauses = request.where_clauses();
     if (where_clauses.empty()) {
       return Status::OK();
     }
+    auto key = DocPgExprExecutorCache::BuildKey(where_clauses, request.col_refs());
+    if (!key.empty()) {
+      filter_cache_ = read_context.pg_expr_executor_cache();
+      auto executor = filter_cache_->Take(key);
+      if (executor) {
+        filter_.emplace(std::move(*executor));
+      }
+      filter_key_ = std::move(key);
+      if (filter_) {
+        return Status::OK();
+      }
+    }
     DocPgExprExecutorBuilder builder(schema);
     for (const auto& exp : where_clauses) {
       RETURN_NOT_OK(builder.AddWhere(exp));
@@ -327,6 +346,9 @@ class FilteringIterator {
 
   std::unique_ptr<YQLRowwiseIteratorIf>& iterator_holder_;
   boost::optional<DocPgExprExecutor> filter_;
+  // When set, filter_ is returned to this cache after the scan.
+  DocPgExprExecutorCachePtr filter_cache_;
+  std::string filter_key_;
 };
 
 struct IndexState {
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/rocksdb_writer.h"
 
+#include <optional>
+
 #include "yb/common/row_mark.h"
 
 #include "yb/docdb/conflict_resolution.h"
@@ -31,6 +33,7 @@
 #include "yb/util/debug-util.h"
 #include "yb/util/fast_varint.h"
 #include "yb/util/flags.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/pb_util.h"
 
 DEFINE_UNKNOWN_bool(enable_transaction_sealing, false,
@@ -66,6 +69,27 @@ struct FixedSliceParts {
   const Slice* parts;
 };
 
+// Forwards records to the underlying handler and adds them to the intents cache.
+class IntentsCachingHandler : public rocksdb::DirectWriteHandler {
+ public:
+  IntentsCachingHandler(rocksdb::DirectWriteHandler* handler, TransactionIntentsCache* cache)
+      : handler_(*handler), cache_(*cache) {}
+
+  std::pair<Slice, Slice> Put(const SliceParts& key, const SliceParts& value) override {
+    cache_.Add(key, value);
+    return handler_.Put(key, value);
+  }
+
+  void SingleDelete(const Slice& key) override {
+    LOG(DFATAL) << "Unexpected delete while writing intents: " << key.ToDebugHexString();
+    handler_.SingleDelete(key);
+  }
+
+ private:
+  rocksdb::DirectWriteHandler& handler_;
+  TransactionIntentsCache& cache_;
+};
+
 // Main intent data::
 // Prefix + DocPath + IntentType + DocHybridTime -> TxnId + value of the intent
 // Reverse index by txn id:
@@ -179,6 +203,51 @@ Status NonTransactionalWriter::Apply(rocksdb::DirectWriteHandler* handler) {
   return Status::OK();
 }
 
+TransactionIntentsCache::TransactionIntentsCache(
+    size_t max_size_bytes, std::shared_ptr<MemTracker> mem_tracker)
+    : max_size_bytes_(max_size_bytes), mem_tracker_(std::move(mem_tracker)) {
+}
+
+TransactionIntentsCache::~TransactionIntentsCache() {
+  if (mem_tracker_) {
+    mem_tracker_->Release(size_bytes_);
+  }
+}
+
+void TransactionIntentsCache::Add(const SliceParts& key, const SliceParts& value) {
+  if (overflowed_) {
+    return;
+  }
+  const auto key_size = key.SumSizes();
+  const auto value_size = value.SumSizes();
+  const auto record_size = key_size + value_size;
+  if (size_bytes_ + record_size > max_size_bytes_ ||
+      (mem_tracker_ && !mem_tracker_->TryConsume(record_size))) {
+    Overflow();
+    return;
+  }
+  size_bytes_ += record_size;
+  std::string key_str(key_size, 0);
+  key.CopyAllTo(key_str.data());
+  std::string value_str(value_size, 0);
+  value.CopyAllTo(value_str.data());
+  records_.insert_or_assign(std::move(key_str), std::move(value_str));
+}
+
+void TransactionIntentsCache::Overflow() {
+  overflowed_ = true;
+  records_.clear();
+  if (mem_tracker_) {
+    mem_tracker_->Release(size_bytes_);
+  }
+  size_bytes_ = 0;
+}
+
+const std::string* TransactionIntentsCache::Find(const Slice& key) const {
+  auto it = records_.find(key.ToBuffer());
+  return it != records_.end() ? &it->second : nullptr;
+}
+
 TransactionalWriter::TransactionalWriter(
     std::reference_wrapper<const LWKeyValueWriteBatchPB> put_batch,
     HybridTime hybrid_time,
@@ -210,6 +279,10 @@ Status TransactionalWriter::Apply(rocksdb::DirectWriteHandler* handler) {
   VLOG(4) << "PrepareTransactionWriteBatch(), write_id = " << write_id_;
 
   row_mark_ = GetRowMarkTypeFromPB(put_batch_);
+  std::optional<IntentsCachingHandler> caching_handler;
+  if (intents_cache_) {
+    handler = &caching_handler.emplace(handler, intents_cache_);
+  }
   handler_ = handler;
 
   if (metadata_to_store_) {
@@ -386,8 +459,10 @@ IntentsWriterContext::IntentsWriterContext(const TransactionId& transaction_id)
 
 IntentsWriter::IntentsWriter(const Slice& start_key,
                              rocksdb::DB* intents_db,
-                             IntentsWriterContext* context)
-    : start_key_(start_key), intents_db_(intents_db), context_(*context) {
+                             IntentsWriterContext* context,
+                             const TransactionIntentsCache* intents_cache)
+    : start_key_(start_key), intents_db_(intents_db), context_(*context),
+      intents_cache_(intents_cache) {
   AppendTransactionKeyPrefix(context_.transaction_id(), &txn_reverse_index_prefix_);
   txn_reverse_index_prefix_.AppendKeyEntryType(dockv::KeyEntryType::kMaxByte);
   reverse_index_upperbound_ = txn_reverse_index_prefix_.AsSlice();
@@ -400,7 +475,9 @@ Status IntentsWriter::Apply(rocksdb::DirectWriteHandler* handler) {
   Slice key_prefix = txn_reverse_index_prefix_.AsSlice();
   key_prefix.remove_suffix(1);
 
-  DocHybridTimeBuffer doc_ht_buffer;
+  if (intents_cache_) {
+    return ApplyFromCache(key_prefix, handler);
+  }
 
   reverse_index_iter_.Seek(start_key_.empty() ? key_prefix : start_key_);
 
@@ -414,21 +491,7 @@ Status IntentsWriter::Apply(rocksdb::DirectWriteHandler* handler) {
       break;
     }
 
-    auto reverse_index_value = reverse_index_iter_.value();
-
-    bool metadata = key_slice.size() == 1 + TransactionId::StaticSize();
-    // At this point, txn_reverse_index_prefix is a prefix of key_slice. If key_slice is equal to
-    // txn_reverse_index_prefix in size, then they are identical, and we are seeked to transaction
-    // metadata. Otherwise, we're seeked to an intent entry in the index which we may process.
-    if (!metadata) {
-      if (!reverse_index_value.empty() && reverse_index_value[0] == KeyEntryTypeAsChar::kBitSet) {
-        CHECK(!FLAGS_TEST_fail_on_replicated_batch_idx_set_in_txn_record);
-        reverse_index_value.remove_prefix(1);
-        RETURN_NOT_OK(OneWayBitmap::Skip(&reverse_index_value));
-      }
-    }
-
-    if (VERIFY_RESULT(context_.Entry(key_slice, reverse_index_value, metadata, handler))) {
+    if (VERIFY_RESULT(ProcessEntry(key_slice, reverse_index_iter_.value(), handler))) {
       return Status::OK();
     }
 
@@ -441,6 +504,47 @@ Status IntentsWriter::Apply(rocksdb::DirectWriteHandler* handler) {
   return Status::OK();
 }
 
+Status IntentsWriter::ApplyFromCache(
+    const Slice& key_prefix, rocksdb::DirectWriteHandler* handler) {
+  const auto& records = intents_cache_->records();
+  auto it = records.lower_bound((start_key_.empty() ? key_prefix : start_key_).ToBuffer());
+
+  context_.Start(it != records.end() ? boost::make_optional(Slice(it->first)) : boost::none);
+
+  for (; it != records.end(); ++it) {
+    const Slice key_slice(it->first);
+
+    if (!key_slice.starts_with(key_prefix)) {
+      break;
+    }
+
+    if (VERIFY_RESULT(ProcessEntry(key_slice, it->second, handler))) {
+      return Status::OK();
+    }
+  }
+
+  context_.Complete(handler);
+
+  return Status::OK();
+}
+
+Result<bool> IntentsWriter::ProcessEntry(
+    const Slice& key, Slice reverse_index_value, rocksdb::DirectWriteHandler* handler) {
+  bool metadata = key.size() == 1 + TransactionId::StaticSize();
+  // At this point, txn_reverse_index_prefix is a prefix of key. If key is equal to
+  // txn_reverse_index_prefix in size, then they are identical, and we are seeked to transaction
+  // metadata. Otherwise, we're seeked to an intent entry in the index which we may process.
+  if (!metadata) {
+    if (!reverse_index_value.empty() && reverse_index_value[0] == KeyEntryTypeAsChar::kBitSet) {
+      CHECK(!FLAGS_TEST_fail_on_replicated_batch_idx_set_in_txn_record);
+      reverse_index_value.remove_prefix(1);
+      RETURN_NOT_OK(OneWayBitmap::Skip(&reverse_index_value));
+    }
+  }
+
+  return context_.Entry(key, reverse_index_value, metadata, handler);
+}
+
 ApplyIntentsContext::ApplyIntentsContext(
     const TransactionId& transaction_id,
     const ApplyTransactionState* apply_state,
@@ -508,8 +612,19 @@ Result<bool> ApplyIntentsContext::Entry(
   }
 
   DocHybridTimeBuffer doc_ht_buffer;
-  intent_iter_.Seek(value);
-  if (!intent_iter_.Valid() || intent_iter_.key() != value) {
+  Slice intent_value;
+  if (intents_cache_) {
+    auto* cached_value = intents_cache_->Find(value);
+    if (cached_value) {
+      intent_value = *cached_value;
+    }
+  } else {
+    intent_iter_.Seek(value);
+    if (intent_iter_.Valid() && intent_iter_.key() == value) {
+      intent_value = intent_iter_.value();
+    }
+  }
+  if (intent_value.empty()) {
     Slice temp_slice = value;
     auto value_doc_ht = DocHybridTime::DecodeFromEnd(&temp_slice);
     temp_slice = key;
@@ -524,7 +639,7 @@ Result<bool> ApplyIntentsContext::Entry(
   if (intent.types.Test(dockv::IntentType::kStrongWrite)) {
     const Slice transaction_id_slice = transaction_id().AsSlice();
     auto decoded_value = VERIFY_RESULT(dockv::DecodeIntentValue(
-        intent_iter_.value(), &transaction_id_slice));
+        intent_value, &transaction_id_slice));
 
     // Write id should match to one that were calculated during append of intents.
     // Doing it just for sanity check.
@@ -534,7 +649,7 @@ Result<bool> ApplyIntentsContext::Entry(
         Format("Unexpected write id. Expected: $0, found: $1, raw value: $2",
                write_id_,
                decoded_value.write_id,
-               intent_iter_.value().ToDebugHexString()));
+               intent_value.ToDebugHexString()));
     write_id_ = decoded_value.write_id;
 
     // Intents for row locks should be ignored (i.e. should not be written as regular records).
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+
 #include "yb/common/doc_hybrid_time.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/common/transaction.h"
@@ -26,6 +29,9 @@
 #include "yb/rocksdb/write_batch.h"
 
 namespace yb {
+
+class MemTracker;
+
 namespace docdb {
 
 class NonTransactionalWriter : public rocksdb::DirectWriter {
@@ -59,6 +65,41 @@ class DocHybridTimeBuffer {
   std::array<char, 1 + kMaxBytesPerEncodedHybridTime> buffer_;
 };
 
+// In memory copy of the intents DB records written by a single transaction on a tablet, i.e.
+// intents, reverse index entries and transaction metadata, kept in the intents DB order.
+// It allows to apply a small transaction without reading its intents back from the intents DB.
+// Records are charged to the specified mem tracker. Once the total size exceeds the limit, or the
+// mem tracker or one of its ancestors could not accommodate a record, the cache is cleared and
+// marked as overflowed, so the transaction is applied from the intents DB.
+// Not thread safe, transactional batches of a tablet are written sequentially.
+class TransactionIntentsCache {
+ public:
+  TransactionIntentsCache(size_t max_size_bytes, std::shared_ptr<MemTracker> mem_tracker);
+  ~TransactionIntentsCache();
+
+  void Add(const SliceParts& key, const SliceParts& value);
+
+  bool overflowed() const {
+    return overflowed_;
+  }
+
+  const std::map<std::string, std::string>& records() const {
+    return records_;
+  }
+
+  // Returns value of the record with specified key, or nullptr if there is no such record.
+  const std::string* Find(const Slice& key) const;
+
+ private:
+  void Overflow();
+
+  const size_t max_size_bytes_;
+  const std::shared_ptr<MemTracker> mem_tracker_;
+  size_t size_bytes_ = 0;
+  bool overflowed_ = false;
+  std::map<std::string, std::string> records_;
+};
+
 class TransactionalWriter : public rocksdb::DirectWriter {
  public:
   TransactionalWriter(
@@ -80,6 +121,11 @@ class TransactionalWriter : public rocksdb::DirectWriter {
     metadata_to_store_ = value;
   }
 
+  // Records written by this writer are also added to the specified cache.
+  void SetIntentsCache(TransactionIntentsCache* value) {
+    intents_cache_ = value;
+  }
+
   Status operator()(
       dockv::AncestorDocKey ancestor_doc_key, dockv::FullDocKey full_doc_key, Slice value_slice,
       dockv::KeyBytes* key, dockv::LastKey last_key);
@@ -100,6 +146,7 @@ class TransactionalWriter : public rocksdb::DirectWriter {
   IntraTxnWriteId intra_txn_write_id_;
   IntraTxnWriteId write_id_ = 0;
   const LWTransactionMetadataPB* metadata_to_store_ = nullptr;
+  TransactionIntentsCache* intents_cache_ = nullptr;
 
   // TODO(dtxn) weak & strong intent in one batch.
   // TODO(dtxn) extract part of code knowing about intents structure to lower level.
@@ -164,16 +211,26 @@ class IntentsWriterContext {
 
 class IntentsWriter : public rocksdb::DirectWriter {
  public:
+  // When intents_cache is specified, reverse index entries are taken from it instead of the
+  // intents DB.
   IntentsWriter(const Slice& start_key,
                 rocksdb::DB* intents_db,
-                IntentsWriterContext* context);
+                IntentsWriterContext* context,
+                const TransactionIntentsCache* intents_cache = nullptr);
 
   Status Apply(rocksdb::DirectWriteHandler* handler) override;
 
  private:
+  // Passes reverse index entry to the context. Returns true if iteration should be interrupted.
+  Result<bool> ProcessEntry(
+      const Slice& key, Slice reverse_index_value, rocksdb::DirectWriteHandler* handler);
+
+  Status ApplyFromCache(const Slice& key_prefix, rocksdb::DirectWriteHandler* handler);
+
   Slice start_key_;
   rocksdb::DB* intents_db_;
   IntentsWriterContext& context_;
+  const TransactionIntentsCache* intents_cache_;
   dockv::KeyBytes txn_reverse_index_prefix_;
   Slice reverse_index_upperbound_;
   BoundedRocksDbIterator reverse_index_iter_;
@@ -202,6 +259,11 @@ class ApplyIntentsContext : public IntentsWriterContext {
     frontiers_ = frontiers;
   }
 
+  // Intent values are taken from the specified cache instead of the intents DB.
+  void SetIntentsCache(const TransactionIntentsCache* intents_cache) {
+    intents_cache_ = intents_cache;
+  }
+
  private:
   Result<bool> StoreApplyState(const Slice& key, rocksdb::DirectWriteHandler* handler);
 
@@ -215,6 +277,7 @@ class ApplyIntentsContext : public IntentsWriterContext {
   SchemaVersion min_schema_version_ = std::numeric_limits<SchemaVersion>::max();
   SchemaVersion max_schema_version_ = std::numeric_limits<SchemaVersion>::min();
   ConsensusFrontiers* frontiers_;
+  const TransactionIntentsCache* intents_cache_ = nullptr;
 };
 
 class RemoveIntentsContext : public IntentsWriterContext {
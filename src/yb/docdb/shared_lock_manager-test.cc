@@ -164,6 +164,72 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Emulates write pattern of the hot tablet: every write takes weak lock on the common prefix
+// (e.g. table or colocation id) and strong lock on its own row. Weak locks on the common prefix
+// don't conflict, so every writer should make progress, and all locks should be released at the
+// end. Also reports lock throughput.
+TEST_F(SharedLockManagerTest, HotTabletWritePerformance) {
+  const auto kThreads = 16;
+  const auto kRowsPerThread = 1000;
+  const auto kTestTime = 5s;
+  const RefCntPrefix kTableKey("table"s);
+
+  auto row_key = [](size_t thread_idx, size_t row) {
+    return RefCntPrefix(Format("table_row_$0_$1", thread_idx, row));
+  };
+
+  std::atomic<bool> stop_requested{false};
+  std::atomic<size_t> failed_batches{0};
+  std::vector<size_t> thread_batches(kThreads);
+  std::vector<std::thread> threads;
+  while (threads.size() != kThreads) {
+    size_t thread_idx = threads.size();
+    threads.emplace_back(
+        [this, &stop_requested, &failed_batches, &kTableKey, &row_key,
+         batches = &thread_batches[thread_idx], thread_idx] {
+      while (!stop_requested.load(std::memory_order_acquire)) {
+        LockBatch lb(&lm_, {
+            {kTableKey, IntentTypeSet({IntentType::kWeakWrite})},
+            {row_key(thread_idx, *batches % kRowsPerThread),
+             IntentTypeSet({IntentType::kStrongWrite})}},
+            CoarseTimePoint::max());
+        if (!lb.status().ok()) {
+          failed_batches.fetch_add(1, std::memory_order_acq_rel);
+        }
+        ++*batches;
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(kTestTime);
+  stop_requested.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  size_t total_batches = 0;
+  for (auto batches : thread_batches) {
+    ASSERT_GT(batches, 0U);
+    total_batches += batches;
+  }
+  ASSERT_EQ(failed_batches.load(), 0U);
+  LOG(INFO) << "Locked " << total_batches << " batches, "
+            << total_batches / ToSeconds(kTestTime) << " batches/s";
+
+  // All locks were released, so strong locks on the common prefix and on every row are taken
+  // without waiting.
+  const auto kStrongIntents = IntentTypeSet({IntentType::kStrongWrite, IntentType::kStrongRead});
+  LockBatch table_lb(&lm_, {{kTableKey, kStrongIntents}}, CoarseMonoClock::now());
+  ASSERT_OK(table_lb.status());
+  for (size_t thread_idx = 0; thread_idx != kThreads; ++thread_idx) {
+    for (size_t row = 0; row != std::min<size_t>(thread_batches[thread_idx], kRowsPerThread);
+         ++row) {
+      LockBatch lb(&lm_, {{row_key(thread_idx, row), kStrongIntents}}, CoarseMonoClock::now());
+      ASSERT_OK(lb.status());
+    }
+  }
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{
     .name = "test_pool"s,
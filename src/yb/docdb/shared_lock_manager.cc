@@ -24,6 +24,8 @@
 
 #include "yb/docdb/lock_batch.h"
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/enums.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
@@ -132,14 +134,21 @@ bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
   return false;
 }
 
-struct LockedBatchEntry {
+struct LockTableShard;
+
+// Aligned to cache line, so lock state of different keys does not share cache lines.
+struct CACHELINE_ALIGNED LockedBatchEntry {
+  explicit LockedBatchEntry(LockTableShard* shard_) : shard(shard_) {}
+
+  // Shard of the lock table that owns this entry.
+  LockTableShard* const shard;
+
   // Taken only for short duration, with no blocking wait.
   mutable std::mutex mutex;
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and covers this field for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the shard mutex is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -159,34 +168,51 @@ struct LockedBatchEntry {
   }
 };
 
+// Lock entries are distributed among independent shards by key hash, so concurrent batches that
+// lock different keys rarely contend on the same mutex.
+// Lock state of the entry itself is updated with atomic operations, the shard mutex is taken only
+// to find or create the entry and to maintain its ref count.
+struct CACHELINE_ALIGNED LockTableShard {
+  typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
+
+  // Protects the fields below. Should be taken only for very short duration, with no blocking wait.
+  std::mutex mutex;
+
+  LockEntryMap locks;
+  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries;
+  std::vector<LockedBatchEntry*> free_lock_entries;
+};
+
 class SharedLockManager::Impl {
  public:
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
-  typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
+  static constexpr size_t kNumShards = 64;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  LockTableShard& ShardForKey(const RefCntPrefix& key) {
+    return shards_[RefCntPrefixHash()(key) % kNumShards];
+  }
+
+  // Make sure the entries exist in the lock table and return pointers so we can access
+  // them without holding the shard lock. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<LockTableShard, kNumShards> shards_;
 };
 
 std::string SharedLockManager::ToString(const LockState& state) {
@@ -306,16 +332,28 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  // Consecutive keys of the batch usually belong to different shards, but keep the shard locked
+  // while it does not change.
+  LockTableShard* locked_shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardForKey(key_and_intent_type.key);
+    if (&shard != locked_shard) {
+      // Never hold more than one shard mutex at a time.
+      if (locked_shard) {
+        lock.unlock();
+      }
+      lock = std::unique_lock<std::mutex>(shard.mutex);
+      locked_shard = &shard;
+    }
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>(&shard));
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -334,11 +372,21 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  LockTableShard* locked_shard = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (const auto& item : key_to_intent_type) {
+    auto& shard = *item.locked->shard;
+    if (&shard != locked_shard) {
+      // Never hold more than one shard mutex at a time.
+      if (locked_shard) {
+        lock.unlock();
+      }
+      lock = std::unique_lock<std::mutex>(shard.mutex);
+      locked_shard = &shard;
+    }
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -7775,6 +7775,67 @@ TEST_F(CDCSDKYsqlTest, YB_DISABLE_TEST_IN_TSAN(TestSnapshotNoData)) {
   ASSERT_GT(change_resp.cdc_sdk_proto_records_size(), 1000);
 }
 
+TEST_F(CDCSDKYsqlTest, YB_DISABLE_TEST_IN_TSAN(TestBulkSnapshot)) {
+  FLAGS_cdc_snapshot_batch_size = 10;
+  ASSERT_OK(SetUpWithParams(1, 1, false));
+  auto table = ASSERT_RESULT(CreateTable(&test_cluster_, kNamespaceName, kTableName));
+  google::protobuf::RepeatedPtrField<master::TabletLocationsPB> tablets;
+  ASSERT_OK(test_client()->GetTablets(table, 0, &tablets, nullptr));
+  ASSERT_EQ(tablets.size(), 1);
+  CDCStreamId stream_id = ASSERT_RESULT(CreateDBStream(IMPLICIT));
+  auto set_resp = ASSERT_RESULT(SetCDCCheckpoint(stream_id, tablets));
+  ASSERT_FALSE(set_resp.has_error());
+
+  constexpr int kNumRows = 1000;
+  ASSERT_OK(WriteRows(1 /* start */, kNumRows + 1 /* end */, &test_cluster_));
+
+  GetChangesResponsePB change_resp = ASSERT_RESULT(GetChangesFromCDCSnapshot(stream_id, tablets));
+  std::unordered_set<int32_t> keys;
+  int num_batches = 0;
+  while (true) {
+    GetChangesRequestPB change_req;
+    const auto& checkpoint = change_resp.cdc_sdk_checkpoint();
+    PrepareChangeRequest(
+        &change_req, stream_id, tablets, 0, checkpoint.index(), checkpoint.term(),
+        checkpoint.key(), checkpoint.write_id(), checkpoint.snapshot_time());
+    change_req.set_bulk_snapshot(true);
+    change_resp.Clear();
+    RpcController get_changes_rpc;
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &get_changes_rpc));
+    ASSERT_FALSE(change_resp.has_error());
+    ++num_batches;
+
+    // Snapshot rows are returned in the bulk batch, not as READ records.
+    for (const auto& record : change_resp.cdc_sdk_proto_records()) {
+      ASSERT_NE(record.row_message().op(), RowMessage::READ);
+    }
+    if (change_resp.has_bulk_snapshot_batch()) {
+      // Column names and types are sent once per batch, rows carry column values only.
+      const auto& batch = change_resp.bulk_snapshot_batch();
+      ASSERT_EQ(batch.columns_size(), 2);
+      ASSERT_EQ(batch.columns(0).name(), kKeyColumnName);
+      ASSERT_EQ(batch.columns(1).name(), kValueColumnName);
+      ASSERT_GT(batch.rows_size(), 0);
+      for (const auto& row : batch.rows()) {
+        ASSERT_EQ(row.values_size(), batch.columns_size());
+        for (const auto& value : row.values()) {
+          ASSERT_FALSE(value.has_column_name());
+          ASSERT_FALSE(value.has_column_type());
+        }
+        ASSERT_TRUE(keys.insert(row.values(0).datum_int32()).second);
+      }
+    }
+    if (change_resp.cdc_sdk_checkpoint().key().empty() &&
+        change_resp.cdc_sdk_checkpoint().write_id() == 0 &&
+        change_resp.cdc_sdk_checkpoint().snapshot_time() == 0) {
+      break;
+    }
+  }
+  ASSERT_EQ(keys.size(), static_cast<size_t>(kNumRows));
+  // Bulk batches are not limited by cdc_snapshot_batch_size.
+  ASSERT_LT(num_batches, kNumRows / FLAGS_cdc_snapshot_batch_size);
+}
+
 TEST_F(CDCSDKYsqlTest, YB_DISABLE_TEST_IN_TSAN(TestAddManyColocatedTablesOnNamesapceWithStream)) {
   ASSERT_OK(SetUpWithParams(3 /* replication_factor */, 2 /* num_masters */, true /* colocated */));
 
@@ -103,6 +103,7 @@ DECLARE_int32(tablet_report_limit);
 DECLARE_uint64(TEST_inject_latency_during_tablet_report_ms);
 DECLARE_int32(heartbeat_rpc_timeout_ms);
 DECLARE_int32(catalog_manager_report_batch_size);
+DECLARE_int32(catalog_manager_report_parallelism);
 DECLARE_int32(tablet_report_limit);
 
 DEFINE_NON_RUNTIME_int32(num_test_tablets, 60, "Number of tablets for stress test");
@@ -443,6 +444,33 @@ TEST_F(CreateSmallHBTableStressTest, TestRestartMasterDuringFullHeartbeat) {
   }
 }
 
+// Full reports sent to a new master leader are processed by several threads, one range of tables
+// per thread.
+TEST_F(CreateTableStressTest, TestParallelFullReportAfterMasterRestart) {
+  DontVerifyClusterBeforeNextTearDown();
+  constexpr int kNumTables = 4;
+  const int num_tablets_per_table = FLAGS_num_test_tablets / kNumTables;
+
+  std::vector<YBTableName> table_names;
+  for (int i = 0; i != kNumTables; ++i) {
+    table_names.emplace_back(YQL_DATABASE_CQL, "my_keyspace", Format("test_table_$0", i));
+    ASSERT_NO_FATALS(CreateBigTable(table_names.back(), num_tablets_per_table));
+  }
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_catalog_manager_report_parallelism) = kNumTables;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_catalog_manager_report_batch_size) = 1;
+
+  // Restart the master, so all tablet servers send full reports to the new catalog manager.
+  ASSERT_OK(cluster_->mini_master()->Restart());
+  ASSERT_OK(cluster_->mini_master()->master()->WaitUntilCatalogManagerIsLeaderAndReadyForTests());
+
+  for (const auto& table_name : table_names) {
+    master::GetTableLocationsResponsePB resp;
+    ASSERT_OK(WaitForRunningTabletCount(cluster_->mini_master(), table_name,
+                                        num_tablets_per_table, &resp));
+  }
+}
+
 TEST_F(CreateTableStressTest, TestHeartbeatDeadline) {
   DontVerifyClusterBeforeNextTearDown();
 
@@ -41,6 +41,7 @@
 #include "yb/client/transaction_rpc.h"
 #include "yb/client/yb_op.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/raft_consensus.h"
 
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/join.h"
@@ -57,6 +58,7 @@
 #include "yb/master/cdc_consumer_registry_service.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/tablet/mvcc.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/xcluster_consumer.h"
@@ -121,6 +123,8 @@ DECLARE_string(certs_dir);
 DECLARE_string(certs_for_cdc_dir);
 DECLARE_bool(TEST_fail_setup_system_universe_replication);
 DECLARE_bool(TEST_enable_replicate_transaction_status_table);
+DECLARE_uint32(xcluster_max_parallel_write_rpcs);
+DECLARE_string(TEST_xcluster_fail_write_to_tablet);
 
 namespace yb {
 
@@ -2593,6 +2597,90 @@ TEST_P(XClusterTest, ApplyOperationsRandomFailures) {
   ASSERT_OK(DeleteUniverseReplication(kUniverseId, producer_client(), producer_cluster()));
 }
 
+// A failed write to one consumer tablet is reported only after the writes to other tablets that
+// are still in flight complete, and the batch is retried until all its writes succeed.
+TEST_P(XClusterTest, ParallelWritesPartialFailure) {
+  constexpr uint32_t kNumConsumerTablets = 4;
+  auto tables = ASSERT_RESULT(SetUpWithParams({kNumConsumerTablets}, {1}, 1));
+  // tables contains both producer and consumer universe tables (alternately).
+  ASSERT_OK(SetupUniverseReplication({tables[0]}));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  // Accumulate the rows, so the next batch writes to all consumer tablets at once.
+  FLAGS_TEST_cdc_skip_replication_poll = true;
+  SleepFor(MonoDelta::FromSeconds(5));
+  WriteWorkload(0, 100, producer_client(), tables[0]->name());
+
+  auto consumer_peers = ListTableActiveTabletPeers(consumer_cluster(), tables[1]->id());
+  ASSERT_EQ(consumer_peers.size(), kNumConsumerTablets);
+  const auto& paused_peer = consumer_peers[0];
+  paused_peer->raft_consensus()->TEST_PauseApply(true);
+  FLAGS_TEST_xcluster_fail_write_to_tablet = consumer_peers[1]->tablet_id();
+  SetAtomicFlag(kNumConsumerTablets, &FLAGS_xcluster_max_parallel_write_rpcs);
+  auto successful_writes = GetSuccessfulWriteOps(consumer_cluster());
+  FLAGS_TEST_cdc_skip_replication_poll = false;
+
+  ASSERT_OK(WaitFor([&paused_peer] {
+    return paused_peer->tablet()->mvcc_manager()->HasPendingOperations();
+  }, 30s * kTimeMultiplier, "Wait for write to paused tablet"));
+  ASSERT_OK(WaitFor([&] {
+    return GetSuccessfulWriteOps(consumer_cluster()) == successful_writes + 2;
+  }, 30s * kTimeMultiplier, "Wait for writes to other tablets"));
+
+  // The batch is not retried while the write to the paused tablet is in flight.
+  SleepFor(MonoDelta::FromSeconds(2));
+  ASSERT_EQ(GetSuccessfulWriteOps(consumer_cluster()), successful_writes + 2);
+
+  paused_peer->raft_consensus()->TEST_PauseApply(false);
+  ASSERT_OK(WaitFor([&] {
+    return GetSuccessfulWriteOps(consumer_cluster()) > successful_writes + 3;
+  }, 30s * kTimeMultiplier, "Wait for batch retry"));
+
+  FLAGS_TEST_xcluster_fail_write_to_tablet = "";
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name(), 60 /* timeout_secs */));
+  ASSERT_OK(DeleteUniverseReplication());
+}
+
+// Shutdown of the output client aborts all its write RPCs that are in flight.
+TEST_P(XClusterTest, ParallelWritesShutdown) {
+  constexpr uint32_t kNumConsumerTablets = 4;
+  auto tables = ASSERT_RESULT(SetUpWithParams({kNumConsumerTablets}, {1}, 1));
+  // tables contains both producer and consumer universe tables (alternately).
+  ASSERT_OK(SetupUniverseReplication({tables[0]}));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), 1));
+
+  FLAGS_TEST_cdc_skip_replication_poll = true;
+  SleepFor(MonoDelta::FromSeconds(5));
+  WriteWorkload(0, 100, producer_client(), tables[0]->name());
+
+  auto consumer_peers = ListTableActiveTabletPeers(consumer_cluster(), tables[1]->id());
+  ASSERT_EQ(consumer_peers.size(), kNumConsumerTablets);
+  for (const auto& peer : consumer_peers) {
+    peer->raft_consensus()->TEST_PauseApply(true);
+  }
+  SetAtomicFlag(kNumConsumerTablets, &FLAGS_xcluster_max_parallel_write_rpcs);
+  FLAGS_TEST_cdc_skip_replication_poll = false;
+
+  ASSERT_OK(WaitFor([&consumer_peers] {
+    for (const auto& peer : consumer_peers) {
+      if (!peer->tablet()->mvcc_manager()->HasPendingOperations()) {
+        return false;
+      }
+    }
+    return true;
+  }, 30s * kTimeMultiplier, "Wait for writes to all consumer tablets"));
+  ASSERT_EQ(GetAbortedWriteOps(consumer_cluster()), 0U);
+
+  ASSERT_OK(DeleteUniverseReplication());
+  ASSERT_OK(WaitFor([this] {
+    return GetAbortedWriteOps(consumer_cluster()) == kNumConsumerTablets;
+  }, 30s * kTimeMultiplier, "Wait for writes to be aborted"));
+
+  for (const auto& peer : consumer_peers) {
+    peer->raft_consensus()->TEST_PauseApply(false);
+  }
+}
+
 TEST_P(XClusterTest, TestInsertDeleteWorkloadWithRestart) {
   // Good test for batching, make sure we can handle operations on the same key with different
   // hybrid times. Then, do a restart and make sure we can successfully bootstrap the batched data.
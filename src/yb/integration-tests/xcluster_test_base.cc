@@ -501,6 +501,18 @@ uint32_t XClusterTestBase::GetSuccessfulWriteOps(MiniCluster* cluster) {
   return size;
 }
 
+uint32_t XClusterTestBase::GetAbortedWriteOps(MiniCluster* cluster) {
+  uint32_t size = 0;
+  for (const auto& mini_tserver : cluster->mini_tablet_servers()) {
+    auto* tserver = mini_tserver->server();
+    XClusterConsumer* xcluster_consumer;
+    if (tserver && (xcluster_consumer = tserver->GetXClusterConsumer())) {
+      size += xcluster_consumer->GetNumAbortedWriteRpcs();
+    }
+  }
+  return size;
+}
+
 Status XClusterTestBase::DeleteUniverseReplication(const std::string& universe_id) {
   return DeleteUniverseReplication(universe_id, consumer_client(), consumer_cluster());
 }
@@ -192,6 +192,8 @@ class XClusterTestBase : public YBTest {
 
   uint32_t GetSuccessfulWriteOps(MiniCluster* cluster);
 
+  uint32_t GetAbortedWriteOps(MiniCluster* cluster);
+
   Status DeleteUniverseReplication(const std::string& universe_id = kUniverseId);
 
   Status DeleteUniverseReplication(
@@ -13,6 +13,8 @@
 #include <gtest/gtest.h>
 
 #include "yb/master/catalog_entity_info.h"
+#include "yb/master/master_client.pb.h"
+#include "yb/master/ts_descriptor.h"
 #include "yb/util/test_util.h"
 
 namespace yb {
@@ -118,5 +120,68 @@ TEST_F(CatalogEntityInfoTest, TestTabletInfoCommit) {
   }
 }
 
+// Verify that a locations snapshot is dropped once the tablet metadata, its replicas or
+// registrations of their tablet servers change.
+TEST_F(CatalogEntityInfoTest, TestTabletLocationsSnapshot) {
+  scoped_refptr<TabletInfo> tablet(new TabletInfo(nullptr, "123"));
+  ASSERT_EQ(nullptr, tablet->GetLocationsSnapshot());
+
+  NodeInstancePB instance;
+  instance.set_permanent_uuid("ts-uuid");
+  TSDescriptor ts_desc(instance.permanent_uuid());
+  ASSERT_OK(ts_desc.Register(instance, TSRegistrationPB(), CloudInfoPB(), nullptr));
+
+  auto set_snapshot = [&tablet, &ts_desc] {
+    auto snapshot = std::make_shared<TabletLocationsSnapshot>();
+    snapshot->metadata_version = tablet->metadata().version();
+    snapshot->replica_locations_version = tablet->replica_locations_version();
+    snapshot->replicas.push_back(TabletLocationsSnapshot::Replica {
+      .ts_desc = &ts_desc,
+      .ts_registration_version = ts_desc.registration_version(),
+    });
+    snapshot->locations = std::make_shared<TabletLocationsPB>();
+    tablet->SetLocationsSnapshot(snapshot);
+    return snapshot;
+  };
+
+  auto snapshot = set_snapshot();
+  ASSERT_EQ(snapshot, tablet->GetLocationsSnapshot());
+
+  {
+    auto l = tablet->LockForWrite();
+    l.mutable_data()->set_state(SysTabletsEntryPB::RUNNING, "running");
+    // Not committed mutations don't affect the snapshot.
+    ASSERT_EQ(snapshot, tablet->GetLocationsSnapshot());
+    l.Commit();
+  }
+  ASSERT_EQ(nullptr, tablet->GetLocationsSnapshot());
+
+  snapshot = set_snapshot();
+  ASSERT_EQ(snapshot, tablet->GetLocationsSnapshot());
+  auto replica_locations = std::make_shared<TabletReplicaMap>();
+  auto& replica = (*replica_locations)[instance.permanent_uuid()];
+  replica.ts_desc = &ts_desc;
+  replica.role = PeerRole::FOLLOWER;
+  tablet->SetReplicaLocations(replica_locations);
+  ASSERT_EQ(nullptr, tablet->GetLocationsSnapshot());
+
+  // Changes that are not part of the locations keep the snapshot.
+  snapshot = set_snapshot();
+  tablet->SetReplicaLocations(std::make_shared<TabletReplicaMap>(*replica_locations));
+  tablet->UpdateReplicaInfo(
+      instance.permanent_uuid(), TabletReplicaDriveInfo(), TabletLeaderLeaseInfo());
+  tablet->UpdateReplicaLocations(replica);
+  ASSERT_EQ(snapshot, tablet->GetLocationsSnapshot());
+
+  replica.role = PeerRole::LEADER;
+  tablet->UpdateReplicaLocations(replica);
+  ASSERT_EQ(nullptr, tablet->GetLocationsSnapshot());
+
+  snapshot = set_snapshot();
+  ASSERT_EQ(snapshot, tablet->GetLocationsSnapshot());
+  ASSERT_OK(ts_desc.Register(instance, TSRegistrationPB(), CloudInfoPB(), nullptr));
+  ASSERT_EQ(nullptr, tablet->GetLocationsSnapshot());
+}
+
 } // namespace master
 } // namespace yb
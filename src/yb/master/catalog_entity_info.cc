@@ -163,12 +163,39 @@ TabletInfo::TabletInfo(const scoped_refptr<TableInfo>& table, TabletId tablet_id
 TabletInfo::~TabletInfo() {
 }
 
+namespace {
+
+// Returns true if replica maps differ in fields that are part of the tablet locations.
+bool ReplicaLocationsDiffer(const TabletReplicaMap& lhs, const TabletReplicaMap& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return true;
+  }
+  for (const auto& [ts_uuid, replica] : lhs) {
+    auto it = rhs.find(ts_uuid);
+    if (it == rhs.end() || it->second.ts_desc != replica.ts_desc ||
+        it->second.role != replica.role || it->second.member_type != replica.member_type) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
 void TabletInfo::SetReplicaLocations(
     std::shared_ptr<TabletReplicaMap> replica_locations) {
   std::lock_guard<simple_spinlock> l(lock_);
   LeaderChangeReporter leader_change_reporter(this);
   last_update_time_ = MonoTime::Now();
+  // The same map could be modified in place, so it can't be compared with itself.
+  const auto changed = replica_locations == replica_locations_ ||
+                       ReplicaLocationsDiffer(*replica_locations_, *replica_locations);
   replica_locations_ = replica_locations;
+  // Incremented after the replacement, so a reader that observed the new version also observes
+  // the new replica locations.
+  if (changed) {
+    replica_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
 }
 
 Status TabletInfo::CheckRunning() const {
@@ -276,7 +303,30 @@ void TabletInfo::UpdateReplicaLocations(const TabletReplica& replica) {
         replica.ts_desc->permanent_uuid(), replica, replica_locations_);
     return;
   }
+  const auto changed = it->second.role != replica.role ||
+                       it->second.member_type != replica.member_type;
   it->second.UpdateFrom(replica);
+  if (changed) {
+    replica_locations_version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+std::shared_ptr<const TabletLocationsSnapshot> TabletInfo::GetLocationsSnapshot() const {
+  auto snapshot = std::atomic_load_explicit(&locations_snapshot_, std::memory_order_acquire);
+  if (!snapshot || snapshot->metadata_version != metadata_.version() ||
+      snapshot->replica_locations_version != replica_locations_version()) {
+    return nullptr;
+  }
+  for (const auto& replica : snapshot->replicas) {
+    if (replica.ts_desc->registration_version() != replica.ts_registration_version) {
+      return nullptr;
+    }
+  }
+  return snapshot;
+}
+
+void TabletInfo::SetLocationsSnapshot(std::shared_ptr<const TabletLocationsSnapshot> snapshot) {
+  std::atomic_store_explicit(&locations_snapshot_, std::move(snapshot), std::memory_order_release);
 }
 
 void TabletInfo::UpdateReplicaInfo(const std::string& ts_uuid,
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <shared_mutex>
 #include <mutex>
 #include <vector>
@@ -234,6 +235,23 @@ struct PersistentTabletInfo : public Persistent<SysTabletsEntryPB, SysRowEntryTy
   void set_state(SysTabletsEntryPB::State state, const std::string& msg);
 };
 
+// Locations of a tablet, built from a particular version of its metadata, replica locations and
+// registrations of the tablet servers hosting them. Immutable once published, so it could be
+// validated and served without taking any tablet or tablet server locks.
+struct TabletLocationsSnapshot {
+  struct Replica {
+    TSDescriptor* ts_desc;
+    uint64_t ts_registration_version;
+  };
+
+  // Version of the tablet metadata CowObject the locations were built from.
+  uint64_t metadata_version;
+  // See TabletInfo::replica_locations_version().
+  uint64_t replica_locations_version;
+  std::vector<Replica> replicas;
+  std::shared_ptr<const TabletLocationsPB> locations;
+};
+
 // The information about a single tablet which exists in the cluster,
 // including its state and locations.
 //
@@ -273,6 +291,18 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // Replaces a replica in replica_locations_ map if it exists. Otherwise, it adds it to the map.
   void UpdateReplicaLocations(const TabletReplica& replica);
 
+  // Incremented when replicas are added or removed, or their role or member type changes, i.e.
+  // when the replica locations change in a way visible in the tablet locations.
+  uint64_t replica_locations_version() const {
+    return replica_locations_version_.load(std::memory_order_acquire);
+  }
+
+  // Returns the last published locations snapshot if it still matches the tablet metadata, the
+  // replica locations and the registrations of their tablet servers. Otherwise returns null.
+  // Does not take any locks.
+  std::shared_ptr<const TabletLocationsSnapshot> GetLocationsSnapshot() const;
+  void SetLocationsSnapshot(std::shared_ptr<const TabletLocationsSnapshot> snapshot);
+
   // Updates a replica in replica_locations_ map if it exists.
   void UpdateReplicaInfo(const std::string& ts_uuid,
                          const TabletReplicaDriveInfo& drive_info,
@@ -356,6 +386,11 @@ class TabletInfo : public RefCountedThreadSafe<TabletInfo>,
   // Reported schema version (in-memory only).
   std::unordered_map<TableId, uint32_t> reported_schema_version_ GUARDED_BY(lock_) = {};
 
+  std::atomic<uint64_t> replica_locations_version_{0};
+
+  // Accessed with std::atomic_load/atomic_store.
+  std::shared_ptr<const TabletLocationsSnapshot> locations_snapshot_;
+
   // The protege UUID to use for the initial leader election (in-memory only).
   std::string initial_leader_election_protege_ GUARDED_BY(lock_);
 
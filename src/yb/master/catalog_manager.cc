@@ -252,6 +252,12 @@ DEFINE_RUNTIME_int32(catalog_manager_report_batch_size, 1,
     "The max number of tablets evaluated in the heartbeat as a single SysCatalog update.");
 TAG_FLAG(catalog_manager_report_batch_size, advanced);
 
+DEFINE_NON_RUNTIME_int32(catalog_manager_report_parallelism, 1,
+    "Max number of threads used to process tablet reports. When greater than 1, tablets of "
+    "different tables from the same report are processed concurrently, which speeds up handling "
+    "of full tablet reports after master leader failover.");
+TAG_FLAG(catalog_manager_report_parallelism, advanced);
+
 // TODO: Is this code even useful?
 DEFINE_RUNTIME_int32(master_failover_catchup_timeout_ms, 30 * 1000 * yb::kTimeMultiplier,  // 30 sec
     "Amount of time to give a newly-elected leader master to load"
@@ -260,6 +266,24 @@ DEFINE_RUNTIME_int32(master_failover_catchup_timeout_ms, 30 * 1000 * yb::kTimeMu
 TAG_FLAG(master_failover_catchup_timeout_ms, advanced);
 TAG_FLAG(master_failover_catchup_timeout_ms, experimental);
 
+DEFINE_RUNTIME_bool(master_parallel_sys_catalog_load, true,
+    "Whether a new master leader reads tables, tablets, namespaces and other sys catalog entries "
+    "concurrently while loading them into memory.");
+TAG_FLAG(master_parallel_sys_catalog_load, advanced);
+
+DEFINE_RUNTIME_uint32(master_sys_catalog_load_queue_size, 10000,
+    "With master_parallel_sys_catalog_load, max number of parsed sys catalog entries of one type "
+    "that are queued for loading into memory. Bounds the memory used by entries that are read "
+    "ahead of loading.");
+TAG_FLAG(master_sys_catalog_load_queue_size, advanced);
+
+DEFINE_RUNTIME_bool(master_use_tablet_locations_snapshot, true,
+    "Serve tablet locations from an immutable per tablet snapshot, that is rebuilt only after the "
+    "tablet metadata or its replicas change, instead of taking tablet and tablet server locks for "
+    "every lookup. Snapshots keep a copy of the locations of every looked up tablet in master "
+    "memory, roughly 1-2KB per tablet with 3 replicas.");
+TAG_FLAG(master_use_tablet_locations_snapshot, advanced);
+
 DEFINE_RUNTIME_bool(master_tombstone_evicted_tablet_replicas, true,
     "Whether the Master should tombstone (delete) tablet replicas that "
     "are no longer part of the latest reported raft config.");
@@ -946,6 +970,12 @@ CatalogManager::CatalogManager(Master* master)
                .Build(&leader_initialization_pool_));
   CHECK_OK(ThreadPoolBuilder("CatalogManagerBGTasks").Build(&background_tasks_thread_pool_));
   CHECK_OK(ThreadPoolBuilder("async-tasks").Build(&async_task_pool_));
+  CHECK_OK(ThreadPoolBuilder("sys-catalog-load").Build(&sys_catalog_load_pool_));
+  if (FLAGS_catalog_manager_report_parallelism > 1) {
+    CHECK_OK(ThreadPoolBuilder("tablet-report")
+                 .set_max_threads(FLAGS_catalog_manager_report_parallelism)
+                 .Build(&tablet_report_pool_));
+  }
 
   sys_catalog_.reset(new SysCatalogTable(
       master_, master_->metric_registry(),
@@ -1346,6 +1376,53 @@ Status CatalogManager::Load(
   return Status::OK();
 }
 
+Status CatalogManager::LoadAll(const TitledLoaders& loaders) {
+  if (!FLAGS_master_parallel_sys_catalog_load) {
+    for (const auto& [title, loader] : loaders) {
+      LOG_WITH_PREFIX(INFO) << __func__ << ": Loading " << title << " into memory.";
+      RETURN_NOT_OK_PREPEND(
+          sys_catalog_->Visit(loader.get()), "Failed while visiting " + title + " in sys catalog");
+    }
+    return Status::OK();
+  }
+
+  // Scanning and parsing the entries is the expensive part for large catalogs, and it does not
+  // depend on other loaders. So readers run concurrently, while entries are applied in order.
+  // Every reader waits when its queue is full, so parsed entries do not pile up in memory.
+  // Readers are started in the order of loaders, and the pool runs tasks in FIFO order, so the
+  // loader being applied always has its reader running.
+  LOG_WITH_PREFIX(INFO) << __func__ << ": Reading " << loaders.size() << " entry types";
+  CountDownLatch latch(loaders.size());
+  for (const auto& [title, loader] : loaders) {
+    auto* visitor = loader.get();
+    auto status = sys_catalog_load_pool_->SubmitFunc([this, visitor, &latch] {
+      visitor->FinishReading(sys_catalog_->ReadEntries(visitor));
+      latch.CountDown();
+    });
+    if (!status.ok()) {
+      visitor->FinishReading(status);
+      latch.CountDown();
+    }
+  }
+
+  Status result;
+  for (const auto& [title, loader] : loaders) {
+    LOG_WITH_PREFIX(INFO) << __func__ << ": Loading " << title << " into memory.";
+    result = loader->ApplyReadEntries();
+    if (!result.ok()) {
+      result = result.CloneAndPrepend("Failed while visiting " + title + " in sys catalog");
+      break;
+    }
+  }
+  if (!result.ok()) {
+    for (const auto& [title, loader] : loaders) {
+      loader->AbortReading();
+    }
+  }
+  latch.Wait();
+  return result;
+}
+
 Status CatalogManager::RunLoaders(int64_t term, SysCatalogLoadingState* state) {
   // Clear the table and tablet state.
   table_names_map_.clear();
@@ -1404,14 +1481,22 @@ Status CatalogManager::RunLoaders(int64_t term, SysCatalogLoadingState* state) {
   // Clear the hidden tablets vector.
   hidden_tablets_.clear();
 
-  RETURN_NOT_OK(Load<TableLoader>("tables", state, term));
-  RETURN_NOT_OK(Load<TabletLoader>("tablets", state, term));
-  RETURN_NOT_OK(Load<NamespaceLoader>("namespaces", state, term));
-  RETURN_NOT_OK(Load<UDTypeLoader>("user-defined types", state, term));
-  RETURN_NOT_OK(Load<ClusterConfigLoader>("cluster configuration", state, term));
-  RETURN_NOT_OK(Load<RedisConfigLoader>("Redis config", state, term));
-  RETURN_NOT_OK(Load<XClusterSafeTimeLoader>("XCluster safe time", state, term));
-  RETURN_NOT_OK(Load<XClusterConfigLoader>("xcluster configuration", state, term));
+  {
+    // Order matters, e.g. tablets refer to tables loaded before them.
+    TitledLoaders loaders;
+    loaders.emplace_back("tables", std::make_unique<TableLoader>(this, state, term));
+    loaders.emplace_back("tablets", std::make_unique<TabletLoader>(this, state, term));
+    loaders.emplace_back("namespaces", std::make_unique<NamespaceLoader>(this, state, term));
+    loaders.emplace_back("user-defined types", std::make_unique<UDTypeLoader>(this, state, term));
+    loaders.emplace_back(
+        "cluster configuration", std::make_unique<ClusterConfigLoader>(this, state, term));
+    loaders.emplace_back("Redis config", std::make_unique<RedisConfigLoader>(this, state, term));
+    loaders.emplace_back(
+        "XCluster safe time", std::make_unique<XClusterSafeTimeLoader>(this, state, term));
+    loaders.emplace_back(
+        "xcluster configuration", std::make_unique<XClusterConfigLoader>(this, state, term));
+    RETURN_NOT_OK(LoadAll(loaders));
+  }
 
   if (!transaction_tables_config_) {
     RETURN_NOT_OK(InitializeTransactionTablesConfig(term));
@@ -2103,6 +2188,12 @@ void CatalogManager::CompleteShutdown() {
   if (async_task_pool_) {
     async_task_pool_->Shutdown();
   }
+  if (tablet_report_pool_) {
+    tablet_report_pool_->Shutdown();
+  }
+  if (sys_catalog_load_pool_) {
+    sys_catalog_load_pool_->Shutdown();
+  }
 
   // Mark all outstanding table tasks as aborted and wait for them to fail.
   //
@@ -7775,13 +7866,16 @@ bool CatalogManager::ProcessCommittedConsensusState(
     // replica is reporting the same consensus configuration we already know about, but we
     // haven't yet heard from all the tservers in the config, update the in-memory
     // ReplicaLocations.
-    LOG(INFO) << "Tablet server " << ts_desc->permanent_uuid() << " sent "
-              << (is_incremental ? "incremental" : "full tablet")
-              << " report for " << tablet->tablet_id()
-              << ", prev state op id: " << prev_cstate.config().opid_index()
-              << ", prev state term: " << prev_cstate.current_term()
-              << ", prev state has_leader_uuid: " << prev_cstate.has_leader_uuid()
-              << ". Consensus state: " << cstate.ShortDebugString();
+    // Full reports carry every tablet of the tablet server, so don't log unchanged ones.
+    if (is_incremental || VLOG_IS_ON(1)) {
+      LOG(INFO) << "Tablet server " << ts_desc->permanent_uuid() << " sent "
+                << (is_incremental ? "incremental" : "full tablet")
+                << " report for " << tablet->tablet_id()
+                << ", prev state op id: " << prev_cstate.config().opid_index()
+                << ", prev state term: " << prev_cstate.current_term()
+                << ", prev state has_leader_uuid: " << prev_cstate.has_leader_uuid()
+                << ". Consensus state: " << cstate.ShortDebugString();
+    }
     if (GetAtomicFlag(&FLAGS_enable_register_ts_from_raft) &&
         ReplicaMapDiffersFromConsensusState(tablet, cstate)) {
       LOG(INFO) << Format("Tablet replica map differs from reported consensus state. Replica map: "
@@ -8113,6 +8207,109 @@ Status CatalogManager::ProcessTabletReportBatch(
   return Status::OK();
 }
 
+Status CatalogManager::ProcessTabletReportBatches(
+    TSDescriptor* ts_desc,
+    bool is_incremental,
+    ReportedTablets::iterator begin,
+    ReportedTablets::iterator end,
+    CoarseTimePoint safe_deadline,
+    TabletReportUpdatesPB* full_report_update) {
+  // Process tablets by batches.
+  for (auto tablet_iter = begin; tablet_iter != end;) {
+    auto batch_begin = tablet_iter;
+    tablet_iter += std::min<size_t>(end - tablet_iter, FLAGS_catalog_manager_report_batch_size);
+
+    // Keeps track of all RPCs that should be sent when we're done with a single batch.
+    std::vector<RetryingTSRpcTaskPtr> rpcs;
+    auto status = ProcessTabletReportBatch(
+        ts_desc, is_incremental, batch_begin, tablet_iter, full_report_update, &rpcs);
+    if (!status.ok()) {
+      for (auto& rpc : rpcs) {
+        rpc->AbortAndReturnPrevState(status);
+      }
+      return status;
+    }
+
+    // 13. Send all queued RPCs.
+    for (auto& rpc : rpcs) {
+      DCHECK(rpc->table());
+      rpc->table()->AddTask(rpc);
+      WARN_NOT_OK(ScheduleTask(rpc), Substitute("Failed to send $0", rpc->description()));
+    }
+    rpcs.clear();
+
+    // 14. Check deadline. Need to exit before processing all batches if we're close to timing out.
+    if (ts_desc->HasCapability(CAPABILITY_TabletReportLimit) &&
+        tablet_iter != end) {
+      // [TESTING] Inject latency before processing a batch to test deadline.
+      if (PREDICT_FALSE(FLAGS_TEST_inject_latency_during_tablet_report_ms > 0)) {
+        LOG(INFO) << "Sleeping in CatalogManager::ProcessTabletReport for "
+                  << FLAGS_TEST_inject_latency_during_tablet_report_ms << " ms";
+        SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_inject_latency_during_tablet_report_ms));
+      }
+
+      // Return from here at configured safe heartbeat deadline to give the response packet time.
+      if (safe_deadline < CoarseMonoClock::Now()) {
+        LOG(INFO) << "Reached Heartbeat deadline. Returning early after processing "
+                  << full_report_update->tablets_size() << " tablets";
+        full_report_update->set_processing_truncated(true);
+        return Status::OK();
+      }
+    }
+  } // Loop to process the next batch until fully iterated.
+
+  return Status::OK();
+}
+
+Status CatalogManager::ProcessTabletReportInParallel(
+    TSDescriptor* ts_desc,
+    bool is_incremental,
+    ReportedTablets* reported_tablets,
+    int parallelism,
+    CoarseTimePoint safe_deadline,
+    TabletReportUpdatesPB* full_report_update) {
+  // Split tablets, that are ordered by table, into at most 'parallelism' ranges. Tablets of the
+  // same table always go to the same range.
+  const size_t range_size =
+      (reported_tablets->size() + parallelism - 1) / static_cast<size_t>(parallelism);
+  std::vector<ReportedTablets::iterator> bounds = {reported_tablets->begin()};
+  for (auto it = reported_tablets->begin(); it != reported_tablets->end();) {
+    it += std::min<size_t>(reported_tablets->end() - it, range_size);
+    while (it != reported_tablets->end() &&
+           it->info->table()->id() == std::prev(it)->info->table()->id()) {
+      ++it;
+    }
+    bounds.push_back(it);
+  }
+
+  const auto num_ranges = bounds.size() - 1;
+  std::vector<TabletReportUpdatesPB> updates(num_ranges);
+  std::vector<Status> statuses(num_ranges);
+  CountDownLatch latch(num_ranges);
+  for (size_t i = 0; i != num_ranges; ++i) {
+    auto task = [this, ts_desc, is_incremental, &bounds, &updates, &statuses, &latch,
+                 safe_deadline, i] {
+      statuses[i] = ProcessTabletReportBatches(
+          ts_desc, is_incremental, bounds[i], bounds[i + 1], safe_deadline, &updates[i]);
+      latch.CountDown();
+    };
+    // The last range is processed by the RPC thread itself.
+    if (i + 1 == num_ranges || !tablet_report_pool_->SubmitFunc(task).ok()) {
+      task();
+    }
+  }
+  latch.Wait();
+
+  for (size_t i = 0; i != num_ranges; ++i) {
+    RETURN_NOT_OK(statuses[i]);
+    full_report_update->mutable_tablets()->MergeFrom(updates[i].tablets());
+    if (updates[i].processing_truncated()) {
+      full_report_update->set_processing_truncated(true);
+    }
+  }
+  return Status::OK();
+}
+
 Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
                                            const TabletReportPB& full_report,
                                            TabletReportUpdatesPB* full_report_update,
@@ -8195,9 +8392,23 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     }
   }
 
-  std::sort(reported_tablets.begin(), reported_tablets.end(), [](const auto& lhs, const auto& rhs) {
-    return lhs.tablet_id < rhs.tablet_id;
-  });
+  const auto parallelism = tablet_report_pool_ ? FLAGS_catalog_manager_report_parallelism : 1;
+  if (parallelism > 1) {
+    // Group tablets by table, so ranges processed concurrently don't wait for each other on
+    // table locks.
+    std::sort(reported_tablets.begin(), reported_tablets.end(),
+              [](const auto& lhs, const auto& rhs) {
+      const auto& lhs_table_id = lhs.info->table()->id();
+      const auto& rhs_table_id = rhs.info->table()->id();
+      return lhs_table_id < rhs_table_id ||
+             (lhs_table_id == rhs_table_id && lhs.tablet_id < rhs.tablet_id);
+    });
+  } else {
+    std::sort(reported_tablets.begin(), reported_tablets.end(),
+              [](const auto& lhs, const auto& rhs) {
+      return lhs.tablet_id < rhs.tablet_id;
+    });
+  }
 
   // Process any delete requests from orphaned tablets, identified above.
   for (const auto& tablet_id : orphaned_tablets) {
@@ -8210,53 +8421,22 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   }
 
   // Calculate the deadline for this expensive loop coming up.
-  const auto safe_deadline = rpc->GetClientDeadline() -
-    (FLAGS_heartbeat_rpc_timeout_ms * 1ms * FLAGS_heartbeat_safe_deadline_ratio);
-
-  // Process tablets by batches.
-  for (auto tablet_iter = reported_tablets.begin(); tablet_iter != reported_tablets.end();) {
-    auto batch_begin = tablet_iter;
-    tablet_iter += std::min<size_t>(
-        reported_tablets.end() - tablet_iter, FLAGS_catalog_manager_report_batch_size);
-
-    // Keeps track of all RPCs that should be sent when we're done with a single batch.
-    std::vector<RetryingTSRpcTaskPtr> rpcs;
-    auto status = ProcessTabletReportBatch(
-        ts_desc, full_report.is_incremental(), batch_begin, tablet_iter, full_report_update, &rpcs);
-    if (!status.ok()) {
-      for (auto& rpc : rpcs) {
-        rpc->AbortAndReturnPrevState(status);
-      }
-      return status;
-    }
-
-    // 13. Send all queued RPCs.
-    for (auto& rpc : rpcs) {
-      DCHECK(rpc->table());
-      rpc->table()->AddTask(rpc);
-      WARN_NOT_OK(ScheduleTask(rpc), Substitute("Failed to send $0", rpc->description()));
-    }
-    rpcs.clear();
-
-    // 14. Check deadline. Need to exit before processing all batches if we're close to timing out.
-    if (ts_desc->HasCapability(CAPABILITY_TabletReportLimit) &&
-        tablet_iter != reported_tablets.end()) {
-      // [TESTING] Inject latency before processing a batch to test deadline.
-      if (PREDICT_FALSE(FLAGS_TEST_inject_latency_during_tablet_report_ms > 0)) {
-        LOG(INFO) << "Sleeping in CatalogManager::ProcessTabletReport for "
-                  << FLAGS_TEST_inject_latency_during_tablet_report_ms << " ms";
-        SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_inject_latency_during_tablet_report_ms));
-      }
-
-      // Return from here at configured safe heartbeat deadline to give the response packet time.
-      if (safe_deadline < CoarseMonoClock::Now()) {
-        LOG(INFO) << "Reached Heartbeat deadline. Returning early after processing "
-                  << full_report_update->tablets_size() << " tablets";
-        full_report_update->set_processing_truncated(true);
-        return Status::OK();
-      }
-    }
-  } // Loop to process the next batch until fully iterated.
+  const CoarseTimePoint safe_deadline = rpc->GetClientDeadline() -
+    std::chrono::duration_cast<CoarseDuration>(
+        FLAGS_heartbeat_rpc_timeout_ms * 1ms * FLAGS_heartbeat_safe_deadline_ratio);
+
+  if (parallelism > 1 && reported_tablets.size() > 1) {
+    RETURN_NOT_OK(ProcessTabletReportInParallel(
+        ts_desc, full_report.is_incremental(), &reported_tablets, parallelism, safe_deadline,
+        full_report_update));
+  } else {
+    RETURN_NOT_OK(ProcessTabletReportBatches(
+        ts_desc, full_report.is_incremental(), reported_tablets.begin(), reported_tablets.end(),
+        safe_deadline, full_report_update));
+  }
+  if (full_report_update->processing_truncated()) {
+    return Status::OK();
+  }
 
   if (!full_report.is_incremental()) {
     // A full report may take multiple heartbeats.
@@ -11603,8 +11783,19 @@ Status CatalogManager::BuildLocationsForTablet(
   if (system_tablets_.find(tablet->id()) != system_tablets_.end()) {
     return BuildLocationsForSystemTablet(tablet, locs_pb, include_inactive, partitions_only);
   }
+  const auto use_snapshot =
+      !partitions_only && GetAtomicFlag(&FLAGS_master_use_tablet_locations_snapshot);
+  if (use_snapshot) {
+    auto snapshot = tablet->GetLocationsSnapshot();
+    if (snapshot) {
+      locs_pb->MergeFrom(*snapshot->locations);
+      return Status::OK();
+    }
+  }
+
   std::shared_ptr<const TabletReplicaMap> locs;
   consensus::ConsensusStatePB cstate;
+  std::shared_ptr<TabletLocationsSnapshot> snapshot;
   {
     auto l_tablet = tablet->LockForRead();
     if (l_tablet->is_hidden() && !include_inactive) {
@@ -11621,6 +11812,9 @@ Status CatalogManager::BuildLocationsForTablet(
       return STATUS_FORMAT(ServiceUnavailable, "Tablet $0 not running", tablet->id());
     }
     InitializeTabletLocationsPB(tablet->tablet_id(), l_tablet->pb, locs_pb);
+    // Read the version before the replica locations, so the snapshot is invalidated if they change
+    // in between.
+    const auto replica_locations_version = tablet->replica_locations_version();
     locs = tablet->GetReplicaLocations();
     locs_pb->set_stale(locs->empty());
     if (partitions_only) {
@@ -11638,6 +11832,15 @@ Status CatalogManager::BuildLocationsForTablet(
     if (locs->empty() && l_tablet->pb.has_committed_consensus_state()) {
       cstate = l_tablet->pb.committed_consensus_state();
     }
+    // Hidden tablets are returned only for include_inactive, and table ids of tablets with
+    // hosted_tables_mapped_by_parent_id are not part of the metadata, so don't snapshot them.
+    if (use_snapshot && !locs->empty() && !l_tablet->is_hidden() &&
+        !l_tablet->pb.hosted_tables_mapped_by_parent_id()) {
+      snapshot = std::make_shared<TabletLocationsSnapshot>();
+      snapshot->metadata_version = tablet->metadata().version();
+      snapshot->replica_locations_version = replica_locations_version;
+      snapshot->replicas.reserve(locs->size());
+    }
     locs_pb->mutable_split_tablet_ids()->Reserve(tablet_pb.split_tablet_ids().size());
     for (const auto& split_tablet_id : tablet_pb.split_tablet_ids()) {
       *locs_pb->add_split_tablet_ids() = split_tablet_id;
@@ -11657,6 +11860,12 @@ Status CatalogManager::BuildLocationsForTablet(
       TabletLocationsPB_ReplicaPB* replica_pb = locs_pb->add_replicas();
       replica_pb->set_role(replica.second.role);
       replica_pb->set_member_type(replica.second.member_type);
+      if (snapshot) {
+        snapshot->replicas.push_back(TabletLocationsSnapshot::Replica {
+          .ts_desc = replica.second.ts_desc,
+          .ts_registration_version = replica.second.ts_desc->registration_version(),
+        });
+      }
       auto tsinfo_pb = replica.second.ts_desc->GetTSInformationPB();
 
       TSInfoPB* out_ts_info = replica_pb->mutable_ts_info();
@@ -11665,6 +11874,13 @@ Status CatalogManager::BuildLocationsForTablet(
       out_ts_info->set_placement_uuid(tsinfo_pb->registration().common().placement_uuid());
       *out_ts_info->mutable_capabilities() = tsinfo_pb->registration().capabilities();
     }
+    if (snapshot) {
+      auto locations = std::make_shared<TabletLocationsPB>(*locs_pb);
+      locations->clear_expected_live_replicas();
+      locations->clear_expected_read_replicas();
+      snapshot->locations = std::move(locations);
+      tablet->SetLocationsSnapshot(std::move(snapshot));
+    }
   } else if (cstate.IsInitialized()) {
     // If the locations were not cached.
     // TODO: Why would this ever happen? See KUDU-759.
@@ -11734,10 +11950,16 @@ Status CatalogManager::GetTableLocations(
     resp->set_creating(true);
   }
 
-  auto l = table->LockForRead();
-  RETURN_NOT_OK(CatalogManagerUtil::CheckIfTableDeletedOrNotVisibleToClient(l, resp));
-
-  vector<scoped_refptr<TabletInfo>> tablets = table->GetTabletsInRange(req);
+  vector<scoped_refptr<TabletInfo>> tablets;
+  {
+    // Don't hold the table lock while building the locations, so lookups don't block table
+    // mutations, and other lookups don't queue behind a pending commit.
+    auto l = table->LockForRead();
+    RETURN_NOT_OK(CatalogManagerUtil::CheckIfTableDeletedOrNotVisibleToClient(l, resp));
+    tablets = table->GetTabletsInRange(req);
+    resp->set_table_type(l->pb.table_type());
+    resp->set_partition_list_version(l->pb.partition_list_version());
+  }
   IncludeInactive include_inactive(req->has_include_inactive() && req->include_inactive());
   PartitionsOnly partitions_only(req->partitions_only());
   bool require_tablets_runnings = req->require_tablets_running();
@@ -11762,9 +11984,6 @@ Status CatalogManager::GetTableLocations(
     }
   }
 
-  resp->set_table_type(l->pb.table_type());
-  resp->set_partition_list_version(l->pb.partition_list_version());
-
   return Status::OK();
 }
 
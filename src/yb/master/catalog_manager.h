@@ -1853,6 +1853,13 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   template <class Loader>
   Status Load(const std::string& title, SysCatalogLoadingState* state, const int64_t term);
 
+  using TitledLoaders = std::vector<std::pair<std::string, std::unique_ptr<VisitorBase>>>;
+
+  // Loads sys catalog entries of all loaders, one loader after another. When
+  // master_parallel_sys_catalog_load is set, entries of all loaders are read and parsed
+  // concurrently, ahead of loading them by at most master_sys_catalog_load_queue_size entries.
+  Status LoadAll(const TitledLoaders& loaders) REQUIRES(mutex_);
+
   void Started();
 
   void SysCatalogLoaded(int64_t term, const SysCatalogLoadingState& state);
@@ -2038,6 +2045,14 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
   // Thread pool to do the async RPC task work.
   std::unique_ptr<ThreadPool> async_task_pool_;
 
+  // Thread pool to process tablet reports concurrently, null if catalog_manager_report_parallelism
+  // is not greater than 1.
+  std::unique_ptr<ThreadPool> tablet_report_pool_;
+
+  // Thread pool to read sys catalog entries concurrently on leader election. Dedicated, because
+  // other pools could run tasks waiting for mutex_, that is held while loading.
+  std::unique_ptr<ThreadPool> sys_catalog_load_pool_;
+
   // This field is updated when a node becomes leader master,
   // waits for all outstanding uncommitted metadata (table and tablet metadata)
   // in the sys catalog to commit, and then reads that metadata into in-memory
@@ -2268,6 +2283,27 @@ class CatalogManager : public tserver::TabletPeerLookupIf,
       TabletReportUpdatesPB* full_report_update,
       std::vector<RetryingTSRpcTaskPtr>* rpcs);
 
+  // Process tablets by batches of catalog_manager_report_batch_size, stopping at safe_deadline.
+  // Sets processing_truncated in full_report_update if not all tablets were processed.
+  Status ProcessTabletReportBatches(
+      TSDescriptor* ts_desc,
+      bool is_incremental,
+      ReportedTablets::iterator begin,
+      ReportedTablets::iterator end,
+      CoarseTimePoint safe_deadline,
+      TabletReportUpdatesPB* full_report_update);
+
+  // Same as ProcessTabletReportBatches for all of reported_tablets, but splits them into ranges
+  // of different tables, that are processed concurrently using tablet_report_pool_.
+  // reported_tablets should be ordered by table id.
+  Status ProcessTabletReportInParallel(
+      TSDescriptor* ts_desc,
+      bool is_incremental,
+      ReportedTablets* reported_tablets,
+      int parallelism,
+      CoarseTimePoint safe_deadline,
+      TabletReportUpdatesPB* full_report_update);
+
   size_t GetNumLiveTServersForPlacement(const PlacementId& placement_id);
 
   TSDescriptorVector GetAllLiveNotBlacklistedTServers() const;
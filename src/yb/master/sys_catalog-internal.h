@@ -13,6 +13,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+
 #include "yb/qlexpr/ql_expr.h"
 
 #include "yb/docdb/doc_read_context.h"
@@ -22,8 +29,11 @@
 #include "yb/master/sys_catalog_writer.h"
 #include "yb/master/sys_catalog_constants.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/pb_util.h"
 
+DECLARE_uint32(master_sys_catalog_load_queue_size);
+
 namespace yb {
 namespace master {
 
@@ -36,6 +46,22 @@ class VisitorBase {
 
   virtual Status Visit(Slice id, Slice data) = 0;
 
+  // Parses the entry and queues it for ApplyReadEntries, waiting while the queue is full. Does not
+  // touch state shared with other visitors, so visitors of different entry types could read their
+  // entries concurrently, while already read entries are applied.
+  virtual Status ReadEntry(Slice id, Slice data) = 0;
+
+  // Called by the reader after the last ReadEntry, with the status of reading.
+  virtual void FinishReading(const Status& status) = 0;
+
+  // Visits entries queued by ReadEntry, in the order they were read, until reading is finished.
+  // Returns the status of reading when it failed.
+  virtual Status ApplyReadEntries() = 0;
+
+  // Makes the reader fail instead of waiting for the queue space, used when entries are not going
+  // to be applied.
+  virtual void AbortReading() = 0;
+
  protected:
 };
 
@@ -54,6 +80,59 @@ class Visitor : public VisitorBase {
     return Visit(id.ToBuffer(), metadata);
   }
 
+  Status ReadEntry(Slice id, Slice data) override {
+    ReadEntryType entry(id.ToBuffer(), DataType());
+    RETURN_NOT_OK_PREPEND(
+        pb_util::ParseFromArray(&entry.second, data.data(), data.size()),
+        "Unable to parse metadata field for item id: " + entry.first);
+    std::unique_lock lock(read_mutex_);
+    read_cond_.wait(lock, [this] {
+      return read_aborted_ ||
+             read_entries_.size() < std::max<size_t>(FLAGS_master_sys_catalog_load_queue_size, 1);
+    });
+    if (read_aborted_) {
+      return STATUS(Aborted, "Reading of sys catalog entries was aborted");
+    }
+    read_entries_.push_back(std::move(entry));
+    read_cond_.notify_all();
+    return Status::OK();
+  }
+
+  void FinishReading(const Status& status) override {
+    std::lock_guard lock(read_mutex_);
+    read_status_ = status;
+    read_finished_ = true;
+    read_cond_.notify_all();
+  }
+
+  Status ApplyReadEntries() override {
+    for (;;) {
+      // Take all queued entries, so the reader could refill the queue while they are visited.
+      // So at most twice the queue size of parsed entries is kept in memory.
+      std::deque<ReadEntryType> entries;
+      {
+        std::unique_lock lock(read_mutex_);
+        read_cond_.wait(lock, [this] { return read_finished_ || !read_entries_.empty(); });
+        if (read_entries_.empty()) {
+          return read_status_;
+        }
+        entries.swap(read_entries_);
+        read_cond_.notify_all();
+      }
+      // Release entries as soon as they are visited.
+      while (!entries.empty()) {
+        RETURN_NOT_OK(Visit(entries.front().first, entries.front().second));
+        entries.pop_front();
+      }
+    }
+  }
+
+  void AbortReading() override {
+    std::lock_guard lock(read_mutex_);
+    read_aborted_ = true;
+    read_cond_.notify_all();
+  }
+
   int entry_type() const { return PersistentDataEntryClass::type(); }
 
  protected:
@@ -61,6 +140,16 @@ class Visitor : public VisitorBase {
       const std::string& id, const typename PersistentDataEntryClass::data_type& metadata) = 0;
 
  private:
+  using DataType = typename PersistentDataEntryClass::data_type;
+  using ReadEntryType = std::pair<std::string, DataType>;
+
+  std::mutex read_mutex_;
+  std::condition_variable read_cond_;
+  std::deque<ReadEntryType> read_entries_ GUARDED_BY(read_mutex_);
+  bool read_finished_ GUARDED_BY(read_mutex_) = false;
+  bool read_aborted_ GUARDED_BY(read_mutex_) = false;
+  Status read_status_ GUARDED_BY(read_mutex_);
+
   DISALLOW_COPY_AND_ASSIGN(Visitor);
 };
 
@@ -31,6 +31,7 @@
 //
 
 #include <algorithm>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -47,8 +48,10 @@
 #include "yb/master/sys_catalog.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/flags.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/status.h"
+#include "yb/util/stopwatch.h"
 
 using namespace std::literals;
 
@@ -59,6 +62,12 @@ using std::unique_ptr;
 using std::vector;
 
 DECLARE_string(cluster_uuid);
+DECLARE_uint32(master_sys_catalog_load_queue_size);
+
+DEFINE_NON_RUNTIME_int32(sys_catalog_load_benchmark_num_tables, 1000,
+                         "Number of tables in the synthetic catalog of LoadBenchmark.");
+DEFINE_NON_RUNTIME_int32(sys_catalog_load_benchmark_tablets_per_table, 10,
+                         "Number of tablets per table in the synthetic catalog of LoadBenchmark.");
 
 namespace yb {
 namespace master {
@@ -247,6 +256,96 @@ TEST_F(SysCatalogTest, TestSysCatalogTabletsOperations) {
   }
 }
 
+// Compares visiting tables and then tablets, with reading them concurrently while applying them
+// through bounded queues, like a new master leader does with master_parallel_sys_catalog_load.
+// Use --sys_catalog_load_benchmark_num_tables=100000 for a catalog with 100k tables and 1M tablets.
+TEST_F(SysCatalogTest, LoadBenchmark) {
+  constexpr size_t kWriteBatchSize = 1000;
+  const auto num_tables = FLAGS_sys_catalog_load_benchmark_num_tables;
+  const auto tablets_per_table = FLAGS_sys_catalog_load_benchmark_tablets_per_table;
+
+  std::vector<TableInfoPtr> tables;
+  std::vector<TabletInfoPtr> tablets;
+  auto flush = [this, &tables, &tablets]() -> Status {
+    std::vector<TableInfo*> table_ptrs;
+    std::vector<TabletInfo*> tablet_ptrs;
+    for (const auto& table : tables) {
+      table_ptrs.push_back(table.get());
+    }
+    for (const auto& tablet : tablets) {
+      tablet_ptrs.push_back(tablet.get());
+    }
+    RETURN_NOT_OK(sys_catalog_->Upsert(kLeaderTerm, table_ptrs, tablet_ptrs));
+    for (const auto& table : tables) {
+      table->mutable_metadata()->CommitMutation();
+    }
+    for (const auto& tablet : tablets) {
+      tablet->mutable_metadata()->CommitMutation();
+    }
+    tables.clear();
+    tablets.clear();
+    return Status::OK();
+  };
+
+  LOG_TIMING(INFO, "writing synthetic catalog") {
+    for (int t = 0; t != num_tables; ++t) {
+      tables.push_back(CreateUncommittedTable(Format("table_$0", t)));
+      for (int i = 0; i != tablets_per_table; ++i) {
+        tablets.push_back(
+            CreateUncommittedTablet(tables.back().get(), Format("tablet_$0_$1", t, i)));
+      }
+      if (tables.size() + tablets.size() >= kWriteBatchSize) {
+        ASSERT_OK(flush());
+      }
+    }
+    ASSERT_OK(flush());
+  }
+
+  TestTableLoader serial_table_loader;
+  TestTabletLoader serial_tablet_loader;
+  auto start = MonoTime::Now();
+  ASSERT_OK(sys_catalog_->Visit(&serial_table_loader));
+  ASSERT_OK(sys_catalog_->Visit(&serial_tablet_loader));
+  const auto serial_time = MonoTime::Now() - start;
+
+  // Small queue, so readers wait for the entries to be applied.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_master_sys_catalog_load_queue_size) = 100;
+  TestTableLoader parallel_table_loader;
+  TestTabletLoader parallel_tablet_loader;
+  start = MonoTime::Now();
+  auto read_entries = [this](VisitorBase* loader) {
+    return std::async(std::launch::async, [this, loader] {
+      loader->FinishReading(sys_catalog_->ReadEntries(loader));
+    });
+  };
+  auto tables_read = read_entries(&parallel_table_loader);
+  auto tablets_read = read_entries(&parallel_tablet_loader);
+  ASSERT_OK(parallel_table_loader.ApplyReadEntries());
+  ASSERT_OK(parallel_tablet_loader.ApplyReadEntries());
+  tables_read.get();
+  tablets_read.get();
+  const auto parallel_time = MonoTime::Now() - start;
+
+  LOG(INFO) << "Loaded " << serial_table_loader.tables.size() << " tables and "
+            << serial_tablet_loader.tablets.size() << " tablets, serial: " << serial_time
+            << ", parallel: " << parallel_time;
+  ASSERT_EQ(serial_table_loader.tables.size(), static_cast<size_t>(num_tables));
+  ASSERT_EQ(serial_tablet_loader.tablets.size(),
+            static_cast<size_t>(num_tables * tablets_per_table));
+  ASSERT_EQ(parallel_table_loader.tables.size(), serial_table_loader.tables.size());
+  ASSERT_EQ(parallel_tablet_loader.tablets.size(), serial_tablet_loader.tablets.size());
+  for (const auto& [id, table] : serial_table_loader.tables) {
+    auto it = parallel_table_loader.tables.find(id);
+    ASSERT_NE(it, parallel_table_loader.tables.end()) << id;
+    ASSERT_TRUE(PbEquals(table->LockForRead()->pb, it->second->LockForRead()->pb)) << id;
+  }
+  for (const auto& [id, tablet] : serial_tablet_loader.tablets) {
+    auto it = parallel_tablet_loader.tablets.find(id);
+    ASSERT_NE(it, parallel_tablet_loader.tablets.end()) << id;
+    ASSERT_TRUE(PbEquals(tablet->LockForRead()->pb, it->second->LockForRead()->pb)) << id;
+  }
+}
+
 // Test the sys-catalog tables basic operations (add, update, delete, visit)
 TEST_F(SysCatalogTest, TestSysCatalogPlacementOperations) {
   unique_ptr<TestClusterConfigLoader> loader(new TestClusterConfigLoader());
@@ -830,7 +830,20 @@ void SysCatalogTable::InitLocalRaftPeerPB() {
 
 Status SysCatalogTable::Visit(VisitorBase* visitor) {
   TRACE_EVENT0("master", "Visitor::VisitAll");
+  return EnumerateEntries(visitor->entry_type(), [visitor](const Slice& id, const Slice& data) {
+    return visitor->Visit(id, data);
+  });
+}
 
+Status SysCatalogTable::ReadEntries(VisitorBase* visitor) {
+  TRACE_EVENT0("master", "Visitor::ReadEntries");
+  return EnumerateEntries(visitor->entry_type(), [visitor](const Slice& id, const Slice& data) {
+    return visitor->ReadEntry(id, data);
+  });
+}
+
+Status SysCatalogTable::EnumerateEntries(
+    int entry_type, const std::function<Status(const Slice&, const Slice&)>& callback) {
   auto tablet = tablet_peer()->shared_tablet();
   if (!tablet) {
     return STATUS(ShutdownInProgress, "SysConfig is shutting down.");
@@ -839,14 +852,15 @@ Status SysCatalogTable::Visit(VisitorBase* visitor) {
   auto start = CoarseMonoClock::Now();
 
   uint64_t count = 0;
-  RETURN_NOT_OK(EnumerateSysCatalog(tablet.get(), doc_read_context_->schema, visitor->entry_type(),
-                                    [visitor, &count](const Slice& id, const Slice& data) {
+  RETURN_NOT_OK(EnumerateSysCatalog(tablet.get(), doc_read_context_->schema, entry_type,
+                                    [&callback, &count](const Slice& id, const Slice& data) {
     ++count;
-    return visitor->Visit(id, data);
+    return callback(id, data);
   }));
 
   auto duration = CoarseMonoClock::Now() - start;
-  string id = Format("num_entries_with_type_$0_loaded", std::to_string(visitor->entry_type()));
+  std::lock_guard lock(visitor_duration_metrics_mutex_);
+  string id = Format("num_entries_with_type_$0_loaded", std::to_string(entry_type));
   if (visitor_duration_metrics_.find(id) == visitor_duration_metrics_.end()) {
     string description = id + " metric for SysCatalogTable::Visit";
     std::unique_ptr<GaugePrototype<uint64>> counter_gauge =
@@ -858,7 +872,7 @@ Status SysCatalogTable::Visit(VisitorBase* visitor) {
   }
   visitor_duration_metrics_[id]->IncrementBy(count);
 
-  id = Format("duration_ms_loading_entries_with_type_$0", std::to_string(visitor->entry_type()));
+  id = Format("duration_ms_loading_entries_with_type_$0", std::to_string(entry_type));
   if (visitor_duration_metrics_.find(id) == visitor_duration_metrics_.end()) {
     string description = id + " metric for SysCatalogTable::Visit";
     std::unique_ptr<GaugePrototype<uint64>> duration_gauge =
@@ -31,6 +31,8 @@
 //
 #pragma once
 
+#include <functional>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -44,6 +46,7 @@
 #include "yb/docdb/docdb_fwd.h"
 
 #include "yb/gutil/callback.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/master/master_fwd.h"
 #include "yb/master/sys_catalog_constants.h"
@@ -187,6 +190,10 @@ class SysCatalogTable {
 
   Status Visit(VisitorBase* visitor);
 
+  // Reads all entries of the visitor's type with VisitorBase::ReadEntry. Safe to invoke
+  // concurrently for visitors of different entry types.
+  Status ReadEntries(VisitorBase* visitor);
+
   // Read the global ysql catalog version info from the pg_yb_catalog_version catalog table.
   Status ReadYsqlCatalogVersion(const TableId& ysql_catalog_table_id,
                                 uint64_t* catalog_version,
@@ -273,6 +280,10 @@ class SysCatalogTable {
       uint32_t* schema_version);
 
  private:
+  // Invokes callback for all entries of entry_type, updating the visitor metrics.
+  Status EnumerateEntries(
+      int entry_type, const std::function<Status(const Slice&, const Slice&)>& callback);
+
   friend class CatalogManager;
 
   inline std::unique_ptr<SysCatalogWriter> NewWriter(int64_t leader_term);
@@ -365,7 +376,9 @@ class SysCatalogTable {
 
   scoped_refptr<Counter> peer_write_count;
 
-  std::unordered_map<std::string, scoped_refptr<AtomicGauge<uint64>>> visitor_duration_metrics_;
+  std::mutex visitor_duration_metrics_mutex_;
+  std::unordered_map<std::string, scoped_refptr<AtomicGauge<uint64>>> visitor_duration_metrics_
+      GUARDED_BY(visitor_duration_metrics_mutex_);
 
   std::shared_ptr<tserver::TabletMemoryManager> mem_manager_;
 
@@ -123,6 +123,7 @@ Status TSDescriptor::RegisterUnlocked(
   ts_information_->mutable_registration()->CopyFrom(registration);
   ts_information_->mutable_tserver_instance()->set_permanent_uuid(permanent_uuid_);
   ts_information_->mutable_tserver_instance()->set_instance_seqno(latest_seqno);
+  registration_version_.fetch_add(1, std::memory_order_acq_rel);
 
   placement_id_ = generate_placement_id(registration.common().cloud_info());
 
@@ -137,6 +137,12 @@ class TSDescriptor {
   // Returns TSInformationPB for this TSDescriptor.
   const std::shared_ptr<TSInformationPB> GetTSInformationPB() const;
 
+  // Incremented every time the tablet server registers, i.e. when the value returned by
+  // GetTSInformationPB changes. Does not take the lock.
+  uint64_t registration_version() const {
+    return registration_version_.load(std::memory_order_acquire);
+  }
+
   // Helper function to tell if this TS matches the cloud information provided. For now, we have
   // no wildcard functionality, so it will have to explicitly match each individual component.
   // Later, this might be extended to say if this TS is part of some wildcard expression for cloud
@@ -399,6 +405,7 @@ class TSDescriptor {
   int leader_count_;
 
   std::shared_ptr<TSInformationPB> ts_information_;
+  std::atomic<uint64_t> registration_version_{0};
   std::string placement_id_;
 
   // The (read replica) cluster uuid to which this tserver belongs.
@@ -35,6 +35,8 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <set>
 #include <string>
 #include <thread>
@@ -52,6 +54,7 @@
 #include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/db/memtable_list.h"
 #include "yb/rocksdb/db/merge_helper.h"
+#include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
@@ -62,6 +65,7 @@
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/internal_iterator.h"
 #include "yb/rocksdb/table/table_builder.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/log_buffer.h"
@@ -442,8 +446,119 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::GenSampledSubcompactions() {
+  // Number of samples taken from every input file per subcompaction.
+  constexpr size_t kSamplesPerSubcompaction = 8;
+
+  auto* c = compact_->compaction;
+  auto* cfd = c->column_family_data();
+  const auto max_subcompactions = c->mutable_cf_options()->max_subcompactions;
+  if (max_subcompactions <= 1) {
+    return;
+  }
+  const auto min_input_size = std::max<uint64_t>(db_options_.min_subcompaction_input_size, 1);
+  const auto subcompactions = std::min<uint64_t>(
+      max_subcompactions, c->CalculateTotalInputSize() / min_input_size);
+  if (subcompactions <= 1) {
+    return;
+  }
+
+  struct Sample {
+    std::string boundary;
+    // Approximate size of the input data represented by this sample.
+    uint64_t size;
+  };
+  std::vector<Sample> samples;
+  const auto& aligner = *db_options_.subcompaction_boundary_aligner;
+  for (size_t lvl_idx = 0; lvl_idx < c->num_input_levels(); lvl_idx++) {
+    const LevelFilesBrief* flevel = c->input_levels(lvl_idx);
+    for (size_t i = 0; i < flevel->num_files; i++) {
+      const auto& fd = flevel->files[i].fd;
+      auto trwh = cfd->table_cache()->GetTableReader(
+          env_options_, cfd->internal_comparator(), fd, kDefaultQueryId, /* no_io= */ false,
+          cfd->internal_stats()->GetFileReadHist(c->level(lvl_idx)), /* skip_filters= */ true);
+      if (!trwh.ok()) {
+        RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+             "[%s] [JOB %d] Failed to open file %" PRIu64 " to sample its keys: %s",
+             cfd->GetName().c_str(), job_id_, fd.GetNumber(), trwh.status().ToString().c_str());
+        continue;
+      }
+      auto keys = trwh->table_reader->GetSampleKeys(subcompactions * kSamplesPerSubcompaction);
+      if (!keys.ok() || keys->empty()) {
+        continue;
+      }
+      const auto size_per_key = fd.GetTotalFileSize() / keys->size();
+      for (const auto& key : *keys) {
+        if (key.size() < kLastInternalComponentSize) {
+          continue;
+        }
+        auto boundary = aligner(ExtractUserKey(key));
+        if (!boundary.empty()) {
+          samples.push_back(Sample{std::move(boundary), size_per_key});
+        }
+      }
+    }
+  }
+
+  const Comparator* ucmp = cfd->user_comparator();
+  std::sort(samples.begin(), samples.end(), [ucmp](const Sample& lhs, const Sample& rhs) {
+    return ucmp->Compare(lhs.boundary, rhs.boundary) < 0;
+  });
+  uint64_t total_size = 0;
+  std::vector<Sample> unique_samples;
+  for (auto& sample : samples) {
+    total_size += sample.size;
+    if (!unique_samples.empty() &&
+        ucmp->Compare(unique_samples.back().boundary, sample.boundary) == 0) {
+      unique_samples.back().size += sample.size;
+    } else {
+      unique_samples.push_back(std::move(sample));
+    }
+  }
+
+  // Greedily add samples to the subcompaction until the sum of their sizes becomes >= the
+  // expected mean size of a subcompaction. Next sample becomes the start of the next subcompaction.
+  const double mean = total_size * 1.0 / subcompactions;
+  std::vector<uint64_t> sizes;
+  uint64_t sum = 0;
+  for (size_t i = 0; i + 1 < unique_samples.size() && sizes.size() + 1 < subcompactions; ++i) {
+    sum += unique_samples[i].size;
+    if (sum >= mean) {
+      sampled_boundaries_.push_back(std::move(unique_samples[i + 1].boundary));
+      sizes.push_back(sum);
+      sum = 0;
+    }
+  }
+  if (sampled_boundaries_.empty()) {
+    return;
+  }
+  sizes.push_back(total_size - std::accumulate(sizes.begin(), sizes.end(), uint64_t(0)));
+
+  boundaries_.assign(sampled_boundaries_.begin(), sampled_boundaries_.end());
+  sizes_ = std::move(sizes);
+  compact_->sub_compact_states.clear();
+  for (size_t i = 0; i <= boundaries_.size(); i++) {
+    Slice* start = i == 0 ? nullptr : &boundaries_[i - 1];
+    Slice* end = i == boundaries_.size() ? nullptr : &boundaries_[i];
+    compact_->sub_compact_states.emplace_back(
+        c, db_options_.boundary_extractor.get(), start, end, sizes_[i]);
+  }
+  RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
+       "[%s] [JOB %d] Compaction split into %zu subcompactions",
+       cfd->GetName().c_str(), job_id_, compact_->sub_compact_states.size());
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   TEST_SYNC_POINT("CompactionJob::Run():Start");
+  // Sampling reads index blocks of the input files, so it is done here instead of Prepare,
+  // which is called with DB mutex held.
+  if (db_options_.subcompaction_boundary_aligner &&
+      compact_->sub_compact_states.size() == 1 &&
+      compact_->compaction->column_family_data()->ioptions()->compaction_style ==
+          kCompactionStyleUniversal &&
+      compact_->compaction->output_level() == 0) {
+    GenSampledSubcompactions();
+  }
   log_buffer_->FlushBufferToLog();
   LogCompaction();
 
@@ -714,8 +829,11 @@ void CompactionJob::ProcessKeyValueCompaction(
 
   // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
   // filter.
+  // Subcompactions could use different history cutoffs, the largest one is persisted.
   if (sub_compact->context) {
-    largest_user_frontier_ = sub_compact->context->GetLargestUserFrontier();
+    auto frontier = sub_compact->context->GetLargestUserFrontier();
+    std::lock_guard lock(largest_user_frontier_mutex_);
+    UserFrontier::Update(frontier.get(), UpdateUserValueType::kLargest, &largest_user_frontier_);
   }
 
   sub_compact->num_input_records = c_iter_stats.num_input_records;
@@ -28,6 +28,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -103,6 +104,9 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Splits the compaction into subcompactions using boundaries sampled from the input files.
+  // REQUIRED: mutex not held
+  void GenSampledSubcompactions();
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -178,7 +182,11 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Storage for boundaries_ produced by GenSampledSubcompactions.
+  std::vector<std::string> sampled_boundaries_;
 
+  // Protects largest_user_frontier_ while subcompactions are running.
+  std::mutex largest_user_frontier_mutex_;
   UserFrontierPtr largest_user_frontier_;
 };
 
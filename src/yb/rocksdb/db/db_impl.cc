@@ -118,12 +118,14 @@
 #include "yb/util/enums.h"
 #include "yb/util/status_log.h"
 #include "yb/util/stats/iostats_context_imp.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/sync_point.h"
 
 using std::unique_ptr;
 using std::shared_ptr;
 
 using namespace std::literals;
+using namespace yb::size_literals;
 
 DEFINE_UNKNOWN_bool(dump_dbimpl_info, false, "Dump RocksDB info during constructor.");
 DEFINE_UNKNOWN_bool(flush_rocksdb_on_shutdown, true,
@@ -156,6 +158,11 @@ DEFINE_UNKNOWN_int32(automatic_compaction_extra_priority, 50,
              "enabled. This deprioritizes manual compactions including those induced by the "
              "tserver (e.g. post-split compactions). Suggested value between 0 and 50.");
 
+DEFINE_RUNTIME_int32(compaction_read_amp_reduction_max_extra_priority, 0,
+    "Compaction gets 1 extra priority per every input file it removes per GB of input, i.e. "
+    "compactions that reduce read amplification more per compacted byte run first. The extra "
+    "priority is capped by this value, 0 disables it.");
+
 DECLARE_bool(enable_automatic_tablet_splitting);
 
 DEFINE_UNKNOWN_bool(rocksdb_use_logging_iterator, false,
@@ -458,9 +465,28 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_automatic_compaction_extra_priority;
     }
 
+    const auto max_read_amp_priority = FLAGS_compaction_read_amp_reduction_max_extra_priority;
+    if (max_read_amp_priority > 0) {
+      result += ReadAmpReductionPriority(max_read_amp_priority);
+    }
+
     return result;
   }
 
+  int ReadAmpReductionPriority(int max_priority) const {
+    uint64_t num_input_files = 0;
+    for (size_t i = 0; i < compaction_->num_input_levels(); i++) {
+      num_input_files += compaction_->num_input_files(i);
+    }
+    if (num_input_files <= 1) {
+      return 0;
+    }
+    // Merging N files into one saves N - 1 file lookups for reads of the compacted key range.
+    const uint64_t input_size = std::max<uint64_t>(compaction_->CalculateTotalInputSize(), 1);
+    const uint64_t files_removed_per_gb = (num_input_files - 1) * 1_GB / input_size;
+    return static_cast<int>(std::min<uint64_t>(files_removed_per_gb, max_priority));
+  }
+
   void SetTaskInfo() {
     size_t levels = compaction_->num_input_levels();
     uint64_t file_count = 0;
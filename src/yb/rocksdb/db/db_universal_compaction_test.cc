@@ -1465,6 +1465,56 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, SampledSubcompactions) {
+  // Keys with the same prefix should be processed by the same subcompaction.
+  constexpr size_t kGroupPrefixSize = 7;
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 2000;
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 4;
+  options.min_subcompaction_input_size = 1;
+  options.subcompaction_boundary_aligner =
+      std::make_shared<SubcompactionBoundaryAligner>([](Slice user_key) {
+        return user_key.size() < kGroupPrefixSize
+            ? std::string() : user_key.Prefix(kGroupPrefixSize).ToBuffer();
+      });
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1_KB;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  for (int num = 0; num < kNumFiles; ++num) {
+    for (int i = num; i < kNumFiles * kKeysPerFile; i += kNumFiles) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, 100)));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumSortedRuns(0), kNumFiles);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  // Every subcompaction produces its own output file.
+  ASSERT_GT(files.size(), 1U);
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  for (size_t i = 1; i < files.size(); ++i) {
+    ASSERT_NE(Slice(files[i - 1].largest.key).Prefix(kGroupPrefixSize),
+              Slice(files[i].smallest.key).Prefix(kGroupPrefixSize));
+  }
+
+  for (int i = 0; i < kNumFiles * kKeysPerFile; ++i) {
+    ASSERT_NE(Get(Key(i)), "NOT_FOUND");
+  }
+}
+
 }  // namespace rocksdb
 
 
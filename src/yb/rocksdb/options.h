@@ -829,6 +829,10 @@ using IteratorReplacer =
 using CompactionContextFactory = std::function<CompactionContextPtr(
     CompactionFeed* feed, const CompactionContextOptions& options)>;
 
+// Converts user key sampled from compaction input into subcompaction boundary.
+// Returns empty string if the key could not be used as a boundary.
+using SubcompactionBoundaryAligner = std::function<std::string(Slice user_key)>;
+
 struct DBOptions {
   // Some functions that make it easier to optimize RocksDB
 
@@ -1328,6 +1332,16 @@ struct DBOptions {
 
   std::shared_ptr<CompactionContextFactory> compaction_context_factory;
 
+  // When set, single level universal compactions are split into up to max_subcompactions
+  // subcompactions, using boundaries sampled from the indexes of the input files.
+  // Aligner is responsible for making sure that records which should be processed together by the
+  // compaction context, for instance records of the same row, are not split between
+  // subcompactions.
+  std::shared_ptr<SubcompactionBoundaryAligner> subcompaction_boundary_aligner;
+
+  // Min size of the compaction input per subcompaction with sampled boundaries.
+  uint64_t min_subcompaction_input_size = 0;
+
   // Function that returns max file size for compaction.
   // Supported only for level0 of universal style compactions.
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction;
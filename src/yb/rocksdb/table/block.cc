@@ -686,6 +686,24 @@ yb::Result<Slice> Block::GetRestartKey(
   return Slice(key_ptr, key_size);
 }
 
+yb::Result<std::vector<std::string>> Block::GetSampleKeys(
+    const KeyValueEncodingFormat key_value_encoding_format, const size_t max_keys) const {
+  std::vector<std::string> result;
+  const size_t num_restarts = NumRestarts();
+  const auto num_keys = std::min(max_keys, num_restarts);
+  if (num_keys == 0 || size_ == kMinBlockSize) {
+    return result;
+  }
+  result.reserve(num_keys);
+  for (size_t i = 0; i != num_keys; ++i) {
+    // Take restart point from the middle of i-th out of num_keys equal parts of the block.
+    const auto restart_idx = static_cast<uint32_t>((2 * i + 1) * num_restarts / (2 * num_keys));
+    result.push_back(
+        VERIFY_RESULT(GetRestartKey(restart_idx, key_value_encoding_format)).ToBuffer());
+  }
+  return result;
+}
+
 yb::Result<std::string> Block::GetMiddleKey(
     const KeyValueEncodingFormat key_value_encoding_format, const Comparator* cmp,
     const MiddlePointPolicy middle_entry_policy) const {
@@ -28,6 +28,9 @@
 #include <malloc.h>
 #endif
 
+#include <string>
+#include <vector>
+
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
@@ -124,6 +127,10 @@ class Block {
       MiddlePointPolicy middle_entry_policy = MiddlePointPolicy::kMiddleLow
   ) const;
 
+  // Returns keys of up to max_keys restart points evenly distributed across this block.
+  yb::Result<std::vector<std::string>> GetSampleKeys(
+      KeyValueEncodingFormat key_value_encoding_format, size_t max_keys) const;
+
  private:
   // Returns key for corresponding restart block.
   yb::Result<Slice> GetRestartKey(
@@ -657,6 +657,11 @@ HybridTime MvccManager::LastReplicatedHybridTime() const {
   return last_replicated_;
 }
 
+bool MvccManager::HasPendingOperations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !queue_.empty();
+}
+
 // Using NO_THREAD_SAFETY_ANALYSIS here because we're only reading op_trace_ here and it is set
 // in the constructor.
 MvccManager::InvariantViolationLoggingHelper MvccManager::InvariantViolationLogPrefix() const {
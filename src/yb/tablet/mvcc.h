@@ -146,6 +146,9 @@ class MvccManager {
   // Returns time of last replicated operation.
   HybridTime LastReplicatedHybridTime() const EXCLUDES(mutex_);
 
+  // Returns true if there are operations that were added but not yet replicated or aborted.
+  bool HasPendingOperations() const EXCLUDES(mutex_);
+
   class MvccOpTrace;
 
   void TEST_DumpTrace(std::ostream* out);
@@ -54,6 +54,10 @@ Status UpdateTxnOperation::DoReplicated(int64_t leader_term, Status* complete_st
   VLOG_WITH_PREFIX(2) << "Replicated";
 
   auto tablet = VERIFY_RESULT(tablet_safe());
+  if (tablet->witness()) {
+    // Witness does not have transaction intents and state, see Tablet::SetWitness.
+    return Status::OK();
+  }
   auto transaction_participant = tablet->transaction_participant();
   if (transaction_participant) {
     TransactionParticipant::ReplicatedData data = {
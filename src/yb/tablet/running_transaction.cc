@@ -19,6 +19,7 @@
 #include "yb/common/pgsql_error.h"
 
 #include "yb/tablet/transaction_participant_context.h"
+#include "yb/tablet/transaction_status_batcher.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
@@ -242,6 +243,16 @@ void RunningTransaction::SendStatusRequest(
     LOG(WARNING) << "Shutting down. Cannot get GetTransactionStatus: " << metadata_;
     return;
   }
+  auto callback = std::bind(
+      &RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self);
+  if (context_.status_batcher_ && TransactionStatusBatcher::IsEnabled()) {
+    context_.rpcs_.RegisterAndStart(
+        context_.status_batcher_->GetTransactionStatus(
+            TransactionRpcDeadline(), metadata_.status_tablet, metadata_.transaction_id,
+            external_transaction(), std::move(callback)),
+        &get_status_handle_);
+    return;
+  }
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
@@ -253,7 +264,7 @@ void RunningTransaction::SendStatusRequest(
           nullptr /* tablet */,
           client,
           &req,
-          std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self)),
+          std::move(callback)),
       &get_status_handle_);
 }
 
@@ -62,8 +62,10 @@ typedef std::shared_ptr<RunningTransaction> RunningTransactionPtr;
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            TransactionStatusBatcher* status_batcher)
+      : participant_context_(*participant_context), applier_(*applier),
+        status_batcher_(status_batcher) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -96,6 +98,8 @@ class RunningTransactionContext {
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
+  // Tablet server wide status batcher, could be null.
+  TransactionStatusBatcher* const status_batcher_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
@@ -516,7 +516,7 @@ Tablet::Tablet(const TabletInitData& data)
       (is_sys_catalog_ || transactional)) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
         data.transaction_participant_context, this, DCHECK_NOTNULL(tablet_metrics_entity_),
-        data.parent_mem_tracker);
+        data.parent_mem_tracker, data.tablet_options.transaction_status_batcher.get());
     if (data.waiting_txn_registry) {
       transaction_participant_->SetWaitQueue(std::make_unique<docdb::WaitQueue>(
         transaction_participant_.get(), metadata_->fs_manager()->uuid(), data.waiting_txn_registry,
@@ -764,6 +764,7 @@ Status Tablet::OpenKeyValueTablet() {
       retention_policy_, &key_bounds_,
       std::bind(&Tablet::DeleteMarkerRetentionTime, this, _1),
       metadata_.get());
+  rocksdb_options.subcompaction_boundary_aligner = docdb::CreateSubcompactionBoundaryAligner();
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
     {
@@ -817,6 +818,7 @@ Status Tablet::OpenKeyValueTablet() {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
     rocksdb::Options intents_rocksdb_options(rocksdb_options);
     intents_rocksdb_options.compaction_context_factory = {};
+    intents_rocksdb_options.subcompaction_boundary_aligner = {};
     docdb::SetLogPrefix(&intents_rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
 
     intents_rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
@@ -1244,6 +1246,9 @@ Result<std::unique_ptr<docdb::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
 
 Status Tablet::ApplyRowOperations(
     WriteOperation* operation, AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+  if (witness()) {
+    return Status::OK();
+  }
   AtomicFlagSleepMs(&FLAGS_TEST_inject_sleep_before_applying_write_batch_ms);
   const auto& write_request =
       operation->consensus_round() && operation->consensus_round()->replicate_msg()
@@ -1333,6 +1338,9 @@ Status Tablet::WriteTransactionalBatch(
   if (store_metadata) {
     writer.SetMetadataToStore(&put_batch.transaction());
   }
+  if (last_batch_data.intents_cache && !last_batch_data.intents_cache->overflowed()) {
+    writer.SetIntentsCache(last_batch_data.intents_cache.get());
+  }
   rocksdb::WriteBatch write_batch;
   write_batch.SetDirectWriter(&writer);
   RequestScope request_scope = VERIFY_RESULT(RequestScope::Create(transaction_participant_.get()));
@@ -1508,7 +1516,8 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
 
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, tablet_options_.read_latency_histogram.get());
 
   docdb::RedisReadOperation doc_op(redis_read_request, doc_db(), deadline, read_time);
   RETURN_NOT_OK(doc_op.Execute());
@@ -1543,7 +1552,8 @@ Status Tablet::HandleQLReadRequest(
     WriteBuffer* rows_data) {
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, tablet_options_.read_latency_histogram.get());
 
   bool schema_version_compatible = IsSchemaVersionCompatible(
       metadata()->schema_version(), ql_read_request.schema_version(),
@@ -1636,7 +1646,8 @@ Status Tablet::HandlePgsqlReadRequest(
   TRACE(LogPrefix());
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation(deadline);
   RETURN_NOT_OK(scoped_read_operation);
-  ScopedTabletMetricsTracker metrics_tracker(metrics_->ql_read_latency);
+  ScopedTabletMetricsTracker metrics_tracker(
+      metrics_->ql_read_latency, tablet_options_.read_latency_histogram.get());
 
   const shared_ptr<tablet::TableInfo> table_info =
       VERIFY_RESULT(metadata_->GetTableInfo(pgsql_read_request.table_id()));
@@ -1925,8 +1936,10 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   docdb::ApplyIntentsContext context(
       data.transaction_id, data.apply_state, data.aborted, data.commit_ht, data.log_ht,
       &key_bounds_, intents_db_.get());
+  context.SetIntentsCache(data.intents_cache.get());
   docdb::IntentsWriter intents_writer(
-      data.apply_state ? data.apply_state->key : Slice(), intents_db_.get(), &context);
+      data.apply_state ? data.apply_state->key : Slice(), intents_db_.get(), &context,
+      data.intents_cache.get());
   rocksdb::WriteBatch regular_write_batch;
   regular_write_batch.SetDirectWriter(&intents_writer);
   // data.hybrid_time contains transaction commit time.
@@ -637,6 +637,16 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     ht_lease_provider_ = std::move(provider);
   }
 
+  // Witness replica keeps only the Raft log, so replicated writes are not applied to DocDB.
+  // See consensus::RaftPeerPB::witness.
+  void SetWitness(bool witness) {
+    witness_.store(witness, std::memory_order_release);
+  }
+
+  bool witness() const {
+    return witness_.load(std::memory_order_acquire);
+  }
+
   void SetMemTableFlushFilterFactory(std::function<rocksdb::MemTableFilter()> factory) {
     std::lock_guard<std::mutex> lock(flush_filter_mutex_);
     mem_table_flush_filter_factory_ = std::move(factory);
@@ -992,6 +1002,8 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   std::unique_ptr<rocksdb::DB> intents_db_;
   std::atomic<bool> rocksdb_shutdown_requested_{false};
 
+  std::atomic<bool> witness_{false};
+
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
@@ -52,6 +52,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/log_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/retryable_requests.h"
 
@@ -552,6 +553,9 @@ class TabletBootstrap {
     }
 
     const bool has_blocks = VERIFY_RESULT(OpenTablet());
+    // A witness only keeps the log, so replayed writes must not be applied to its regular DB.
+    tablet_->SetWitness(
+        consensus::IsWitness(meta_->fs_manager()->uuid(), cmeta_->committed_config()));
 
     if (FLAGS_TEST_dump_docdb_before_tablet_bootstrap) {
       LOG_WITH_PREFIX(INFO) << "DEBUG: DocDB dump before tablet bootstrap:";
@@ -58,6 +58,7 @@ class TransactionCoordinatorContext;
 class TransactionParticipant;
 class TransactionParticipantContext;
 class TransactionStatePB;
+class TransactionStatusBatcher;
 class TruncateOperation;
 class TruncatePB;
 class UpdateTxnOperation;
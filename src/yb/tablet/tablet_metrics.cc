@@ -31,6 +31,7 @@
 //
 #include "yb/tablet/tablet_metrics.h"
 
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/metrics.h"
 
 // Tablet-specific metrics.
@@ -176,11 +177,16 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
 }
 #undef MINIT
 
-ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(scoped_refptr<Histogram> latency)
-    : latency_(latency), start_time_(MonoTime::Now()) {}
+ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(
+    scoped_refptr<Histogram> latency, HdrHistogram* aggregated_latency)
+    : latency_(latency), aggregated_latency_(aggregated_latency), start_time_(MonoTime::Now()) {}
 
 ScopedTabletMetricsTracker::~ScopedTabletMetricsTracker() {
-  latency_->Increment(MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds());
+  const auto latency_us = MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds();
+  latency_->Increment(latency_us);
+  if (aggregated_latency_) {
+    aggregated_latency_->Increment(latency_us);
+  }
 }
 } // namespace tablet
 } // namespace yb
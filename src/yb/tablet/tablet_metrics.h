@@ -41,6 +41,7 @@ namespace yb {
 class Counter;
 template<class T>
 class AtomicGauge;
+class HdrHistogram;
 class Histogram;
 class MetricEntity;
 
@@ -79,11 +80,14 @@ struct TabletMetrics {
 
 class ScopedTabletMetricsTracker {
  public:
-  explicit ScopedTabletMetricsTracker(scoped_refptr<Histogram> latency);
+  // aggregated_latency, when not null, also receives the latency.
+  explicit ScopedTabletMetricsTracker(
+      scoped_refptr<Histogram> latency, HdrHistogram* aggregated_latency = nullptr);
   ~ScopedTabletMetricsTracker();
 
  private:
   scoped_refptr<Histogram> latency_;
+  HdrHistogram* aggregated_latency_;
   MonoTime start_time_;
 };
 
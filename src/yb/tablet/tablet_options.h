@@ -44,6 +44,7 @@ namespace yb {
 
 class AutoFlagsManager;
 class Env;
+class HdrHistogram;
 class MemTracker;
 class MetricRegistry;
 
@@ -60,6 +61,9 @@ struct TabletOptions {
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
   std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
   std::shared_ptr<rocksdb::RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
+  std::shared_ptr<TransactionStatusBatcher> transaction_status_batcher;
+  // When set, receives read latencies of all tablets, used to adjust the compaction I/O budget.
+  std::shared_ptr<HdrHistogram> read_latency_histogram;
 };
 
 using TransactionManagerProvider = std::function<client::TransactionManager&()>;
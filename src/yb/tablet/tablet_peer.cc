@@ -47,6 +47,7 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/retryable_requests.h"
 #include "yb/consensus/state_change_context.h"
@@ -396,6 +397,22 @@ void TabletPeer::MajorityReplicated() {
 
 void TabletPeer::ChangeConfigReplicated(const RaftConfigPB& config) {
   tablet_->mvcc_manager()->SetLeaderOnlyMode(config.peers_size() == 1);
+  tablet_->SetWitness(consensus::IsWitness(permanent_uuid(), config));
+}
+
+bool TabletPeer::FollowerReadLeasesEnabled() {
+  return tablet_->metadata()->schema()->table_properties().follower_read_leases();
+}
+
+bool TabletPeer::CanServeStrongReadAsFollower() const {
+  auto consensus = shared_raft_consensus();
+  if (!consensus || !consensus->HasFollowerReadLease()) {
+    return false;
+  }
+  // The leader could already have committed operations that were received by this follower,
+  // so they should be applied before a strongly consistent read could be served here.
+  auto tablet = shared_tablet();
+  return tablet && !tablet->mvcc_manager()->HasPendingOperations();
 }
 
 uint64_t TabletPeer::NumSSTFiles() {
@@ -993,6 +1010,15 @@ Result<int64_t> TabletPeer::GetEarliestNeededLogIndex(std::string* details) cons
     *details += Format("Last committed op id: $0\n", last_committed_op_id);
   }
 
+  if (tablet->witness()) {
+    // Witness does not flush anything, but its log could be required to catch up other peers.
+    auto all_replicated_index = consensus_->WitnessAllReplicatedIndex();
+    min_index = std::min(min_index, all_replicated_index);
+    if (details) {
+      *details += Format("Witness all replicated index: $0\n", all_replicated_index);
+    }
+  }
+
   if (tablet_->table_type() != TableType::TRANSACTION_STATUS_TABLE_TYPE) {
     tablet_->FlushIntentsDbIfNecessary(latest_log_entry_op_id);
     auto max_persistent_op_id = VERIFY_RESULT(
@@ -356,6 +356,10 @@ class TabletPeer : public std::enable_shared_from_this<TabletPeer>,
 
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus(bool allow_stale = false) const;
+
+  // Returns true if this replica is a follower that holds a read lease granted by the leader and
+  // has applied all operations it received, so it could serve a strongly consistent read.
+  bool CanServeStrongReadAsFollower() const;
   Result<HybridTime> LeaderSafeTime() const override;
 
   HybridTime HtLeaseExpiration() const override;
@@ -541,6 +545,7 @@ class TabletPeer : public std::enable_shared_from_this<TabletPeer>,
   void MajorityReplicated() override;
   void ChangeConfigReplicated(const consensus::RaftConfigPB& config) override;
   uint64_t NumSSTFiles() override;
+  bool FollowerReadLeasesEnabled() override;
   void ListenNumSSTFilesChanged(std::function<void()> listener) override;
   rpc::Scheduler& scheduler() const override;
   Status CheckOperationAllowed(
@@ -30,6 +30,7 @@
 #include "yb/consensus/consensus_util.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/rocksdb_writer.h"
 #include "yb/docdb/transaction_dump.h"
 
 #include "yb/rpc/poller.h"
@@ -57,6 +58,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/operation_counter.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/tsan_util.h"
@@ -66,6 +68,7 @@ using std::vector;
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_UNKNOWN_uint64(transaction_min_running_check_delay_ms, 50,
               "When transaction with minimal start hybrid time is updated at transaction "
@@ -96,6 +99,17 @@ DEFINE_UNKNOWN_uint64(transactions_status_poll_interval_ms, 500 * yb::kTimeMulti
 DEFINE_UNKNOWN_bool(transactions_poll_check_aborted, true,
     "Check aborted transactions during poll.");
 
+DEFINE_RUNTIME_uint64(transaction_intents_cache_max_bytes, 0,
+    "Max size of the in memory copy of intents written by a transaction on a tablet. Intents of "
+    "transactions that fit into this limit are applied to regular DB without reading them from "
+    "intents DB. 0 disables caching of intents.");
+
+DEFINE_NON_RUNTIME_int64(transaction_intents_cache_total_max_bytes, 256_MB,
+    "Max total size of in memory copies of transaction intents on a tablet server. When it, or "
+    "the memory limit of any parent memory tracker, is reached, intents of the transaction are "
+    "no longer cached and it is applied from intents DB. Negative value means no limit besides "
+    "the parent memory trackers.");
+
 DEFINE_NON_RUNTIME_int32(wait_queue_poll_interval_ms, 100,
     "The interval duration between wait queue polls to fetch transaction statuses of "
     "active blockers.");
@@ -110,6 +124,10 @@ METRIC_DEFINE_simple_counter(
 METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running, "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_counter(
+    tablet, transactions_applied_from_intents_cache,
+    "Total number of transactions applied using in memory copy of intents",
+    yb::MetricUnit::kTransactions);
 METRIC_DEFINE_simple_gauge_uint64(
     tablet, aborted_transactions_pending_cleanup,
     "Total number of aborted transactions running in participant",
@@ -141,8 +159,9 @@ class TransactionParticipant::Impl
  public:
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
        const scoped_refptr<MetricEntity>& entity,
-       const std::shared_ptr<MemTracker>& tablets_mem_tracker)
-      : RunningTransactionContext(context, applier),
+       const std::shared_ptr<MemTracker>& tablets_mem_tracker,
+       TransactionStatusBatcher* status_batcher)
+      : RunningTransactionContext(context, applier, status_batcher),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)),
@@ -150,12 +169,16 @@ class TransactionParticipant::Impl
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    metric_transactions_applied_from_intents_cache_ =
+        METRIC_transactions_applied_from_intents_cache.Instantiate(entity);
     metric_aborted_transactions_pending_cleanup_ =
         METRIC_aborted_transactions_pending_cleanup.Instantiate(entity, 0);
     auto parent_mem_tracker = MemTracker::FindOrCreateTracker(
         kParentMemTrackerId, tablets_mem_tracker);
     mem_tracker_ = MemTracker::CreateTracker(Format("$0-$1", kParentMemTrackerId,
         participant_context_.tablet_id()), parent_mem_tracker);
+    intents_cache_mem_tracker_ = MemTracker::FindOrCreateTracker(
+        FLAGS_transaction_intents_cache_total_max_bytes, "intents_cache", parent_mem_tracker);
   }
 
   ~Impl() {
@@ -259,8 +282,16 @@ class TransactionParticipant::Impl
       return STATUS(InvalidArgument, Format("For external transaction $0, status tablet is empty",
                                              metadata.transaction_id));
     }
+    TransactionalBatchData last_batch_data;
+    // Intents could be cached only for transactions that were created by this write, so all of
+    // their intents pass through the cache. Transactions loaded from intents DB are not cached.
+    auto intents_cache_max_bytes = FLAGS_transaction_intents_cache_max_bytes;
+    if (intents_cache_max_bytes && !metadata.external_transaction) {
+      last_batch_data.intents_cache = std::make_shared<docdb::TransactionIntentsCache>(
+          intents_cache_max_bytes, intents_cache_mem_tracker_);
+    }
     transactions_.insert(std::make_shared<RunningTransaction>(
-        metadata, TransactionalBatchData(), OneWayBitmap(), metadata.start_time, this));
+        metadata, std::move(last_batch_data), OneWayBitmap(), metadata.start_time, this));
     mem_tracker_->Consume(kRunningTransactionSize);
     TransactionsModifiedUnlocked(&min_running_notifier);
     return true;
@@ -689,6 +720,7 @@ class TransactionParticipant::Impl
     }
 
     bool was_previously_committed = false;
+    std::shared_ptr<const docdb::TransactionIntentsCache> intents_cache;
 
     {
       // It is our last chance to load transaction metadata, if missing.
@@ -720,6 +752,10 @@ class TransactionParticipant::Impl
         CHECK(transactions_.modify(lock_and_iterator.iterator, [&data](auto& txn) {
           txn->SetLocalCommitData(data.commit_ht, data.aborted);
         }));
+        const auto& cache = lock_and_iterator.transaction().last_batch_data().intents_cache;
+        if (cache && !cache->overflowed() && !data.apply_state) {
+          intents_cache = cache;
+        }
         if (!lock_and_iterator.transaction().external_transaction()) {
           LOG_IF_WITH_PREFIX(DFATAL, data.log_ht < last_safe_time_)
               << "Apply transaction before last safe time " << data.transaction_id
@@ -738,7 +774,15 @@ class TransactionParticipant::Impl
         // TODO(wait-queues): Consider signaling before replicating the transaction update.
         wait_queue_->SignalCommitted(data.transaction_id, data.commit_ht);
       }
-      auto apply_state = CHECK_RESULT(applier_.ApplyIntents(data));
+      docdb::ApplyTransactionState apply_state;
+      if (intents_cache) {
+        auto cached_data = data;
+        cached_data.intents_cache = std::move(intents_cache);
+        apply_state = CHECK_RESULT(applier_.ApplyIntents(cached_data));
+        metric_transactions_applied_from_intents_cache_->Increment();
+      } else {
+        apply_state = CHECK_RESULT(applier_.ApplyIntents(data));
+      }
 
       VLOG_WITH_PREFIX(4) << "TXN: " << data.transaction_id << ": apply state: "
                           << apply_state.ToString();
@@ -1859,6 +1903,7 @@ class TransactionParticipant::Impl
   scoped_refptr<AtomicGauge<uint64_t>> metric_transactions_running_;
   scoped_refptr<AtomicGauge<uint64_t>> metric_aborted_transactions_pending_cleanup_;
   scoped_refptr<Counter> metric_transaction_not_found_;
+  scoped_refptr<Counter> metric_transactions_applied_from_intents_cache_;
 
   TransactionLoader loader_;
   std::atomic<bool> closing_{false};
@@ -1886,13 +1931,16 @@ class TransactionParticipant::Impl
   std::unique_ptr<docdb::WaitQueue> wait_queue_;
 
   std::shared_ptr<MemTracker> mem_tracker_ GUARDED_BY(mutex_);
+  // Server wide tracker for in memory copies of transaction intents.
+  std::shared_ptr<MemTracker> intents_cache_mem_tracker_;
 };
 
 TransactionParticipant::TransactionParticipant(
     TransactionParticipantContext* context, TransactionIntentApplier* applier,
     const scoped_refptr<MetricEntity>& entity,
-    const std::shared_ptr<MemTracker>& tablets_mem_tracker)
-    : impl_(new Impl(context, applier, entity, tablets_mem_tracker)) {
+    const std::shared_ptr<MemTracker>& tablets_mem_tracker,
+    TransactionStatusBatcher* status_batcher)
+    : impl_(new Impl(context, applier, entity, tablets_mem_tracker, status_batcher)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -79,6 +79,8 @@ struct TransactionApplyData {
   // Owned by running transaction if non-null.
   const docdb::ApplyTransactionState* apply_state = nullptr;
   bool is_external = false;
+  // In memory copy of the transaction intents, used to apply them without reading intents DB.
+  std::shared_ptr<const docdb::TransactionIntentsCache> intents_cache;
 
   std::string ToString() const;
 };
@@ -100,6 +102,10 @@ struct TransactionalBatchData {
   // Hybrid time of last replicated write in transaction.
   HybridTime hybrid_time;
 
+  // Cache that receives intents DB records written by the transaction, null if intents are not
+  // cached for it.
+  std::shared_ptr<docdb::TransactionIntentsCache> intents_cache;
+
   std::string ToString() const {
     return YB_STRUCT_TO_STRING(next_write_id, hybrid_time);
   }
@@ -112,7 +118,8 @@ class TransactionParticipant : public TransactionStatusManager {
  public:
   TransactionParticipant(
       TransactionParticipantContext* context, TransactionIntentApplier* applier,
-      const scoped_refptr<MetricEntity>& entity, const std::shared_ptr<MemTracker>& parent);
+      const scoped_refptr<MetricEntity>& entity, const std::shared_ptr<MemTracker>& parent,
+      TransactionStatusBatcher* status_batcher = nullptr);
   virtual ~TransactionParticipant();
 
   void SetWaitQueue(std::unique_ptr<docdb::WaitQueue> wait_queue);
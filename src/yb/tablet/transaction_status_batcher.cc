@@ -0,0 +1,529 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/server/clock.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status_format.h"
+
+METRIC_DEFINE_counter(server, transaction_status_batcher_requests,
+                      "Transaction Status Batcher Requests",
+                      yb::MetricUnit::kRequests,
+                      "Total number of transaction status requests issued by transaction "
+                      "participants through the tablet server wide status batcher");
+METRIC_DEFINE_counter(server, transaction_status_batcher_rpcs,
+                      "Transaction Status Batcher RPCs",
+                      yb::MetricUnit::kRequests,
+                      "Total number of GetTransactionStatus RPCs sent by the status batcher");
+METRIC_DEFINE_counter(server, transaction_status_batcher_cache_hits,
+                      "Transaction Status Batcher Cache Hits",
+                      yb::MetricUnit::kRequests,
+                      "Total number of transaction status requests served from the cache of final "
+                      "transaction statuses");
+
+DEFINE_RUNTIME_bool(enable_transaction_status_batching, false,
+                    "If set, transaction participants of all tablets on the tablet server resolve "
+                    "transaction statuses through a shared batcher, that coalesces requests for "
+                    "the same status tablet and caches committed and aborted statuses.");
+
+DEFINE_RUNTIME_uint32(transaction_status_batcher_cache_size, 100000,
+                      "Max number of final transaction statuses cached by the transaction status "
+                      "batcher. 0 disables the cache.");
+
+DEFINE_RUNTIME_uint32(transaction_status_batcher_max_in_flight_rpcs, 4,
+                      "Max number of GetTransactionStatus RPCs that the transaction status batcher "
+                      "sends concurrently to a single status tablet.");
+
+DECLARE_int32(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+using Response = tserver::GetTransactionStatusResponsePB;
+
+// Extracts entry with specified index from multi transaction response.
+Response ExtractEntry(const Response& response, int idx) {
+  Response result;
+  if (response.has_propagated_hybrid_time()) {
+    result.set_propagated_hybrid_time(response.propagated_hybrid_time());
+  }
+  result.add_status(response.status(idx));
+  if (idx < response.status_hybrid_time().size()) {
+    result.add_status_hybrid_time(response.status_hybrid_time(idx));
+  }
+  if (idx < response.num_replicated_batches().size()) {
+    result.add_num_replicated_batches(response.num_replicated_batches(idx));
+  }
+  if (idx < response.coordinator_safe_time().size()) {
+    result.add_coordinator_safe_time(response.coordinator_safe_time(idx));
+  }
+  if (idx < response.aborted_subtxn_set().size()) {
+    *result.add_aborted_subtxn_set() = response.aborted_subtxn_set(idx);
+  }
+  return result;
+}
+
+// Whether entry contains final status, that is durable at the coordinator and could be reused by
+// any later request.
+bool IsFinal(const Response& entry, IsExternalTransaction external_transaction) {
+  switch (entry.status(0)) {
+    case TransactionStatus::COMMITTED:
+      return entry.status_hybrid_time().size() == 1 && entry.aborted_subtxn_set().size() == 1;
+    case TransactionStatus::ABORTED:
+      // Aborted status of an external transaction could be changed to committed later.
+      if (external_transaction) {
+        return false;
+      }
+      // Coordinator reports unknown transactions as aborted, together with its safe time. Such
+      // transaction could be committed, if its record was not replicated yet, or could be managed
+      // by another status tablet. Only transactions that the coordinator knows to be aborted are
+      // reported without safe time.
+      return entry.coordinator_safe_time().empty() || entry.coordinator_safe_time(0) == 0;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+class TransactionStatusBatcher::Impl : public std::enable_shared_from_this<Impl> {
+ public:
+  class StatusCommand : public rpc::RpcCommand {
+   public:
+    StatusCommand(
+        std::shared_ptr<Impl> impl, CoarseTimePoint deadline, const TabletId& status_tablet,
+        const TransactionId& transaction_id, IsExternalTransaction external_transaction,
+        client::GetTransactionStatusCallback callback)
+        : impl_(std::move(impl)), deadline_(deadline), status_tablet_(status_tablet),
+          transaction_id_(transaction_id), external_transaction_(external_transaction),
+          callback_(std::move(callback)) {
+    }
+
+    void SendRpc() override {
+      impl_->Enqueue(std::static_pointer_cast<StatusCommand>(shared_from_this()));
+    }
+
+    std::string ToString() const override {
+      return Format("StatusCommand { status_tablet: $0 transaction: $1 }",
+                    status_tablet_, transaction_id_);
+    }
+
+    void Finished(const Status& status) override {
+      Complete(status, Response());
+    }
+
+    void Abort() override {
+      impl_->Abort(this);
+    }
+
+    CoarseTimePoint deadline() const override {
+      return deadline_;
+    }
+
+    const TabletId& status_tablet() const {
+      return status_tablet_;
+    }
+
+    const TransactionId& transaction_id() const {
+      return transaction_id_;
+    }
+
+    IsExternalTransaction external_transaction() const {
+      return external_transaction_;
+    }
+
+    bool completed() const {
+      return completed_.load(std::memory_order_acquire);
+    }
+
+    // Invokes callback if it was not invoked yet. The callback is released right after invocation,
+    // so the command does not keep the caller state alive while it is referenced by an RPC.
+    void Complete(const Status& status, const Response& response) {
+      if (completed_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+      }
+      auto callback = std::move(callback_);
+      callback(status, response);
+    }
+
+   private:
+    const std::shared_ptr<Impl> impl_;
+    const CoarseTimePoint deadline_;
+    const TabletId status_tablet_;
+    const TransactionId transaction_id_;
+    const IsExternalTransaction external_transaction_;
+    client::GetTransactionStatusCallback callback_;
+    std::atomic<bool> completed_{false};
+  };
+
+  using StatusCommandPtr = std::shared_ptr<StatusCommand>;
+
+  Impl(std::shared_future<client::YBClient*> client_future, const server::ClockPtr& clock,
+       MetricEntity* metric_entity)
+      : client_future_(std::move(client_future)),
+        clock_(clock),
+        requests_(METRIC_transaction_status_batcher_requests.Instantiate(metric_entity)),
+        rpcs_sent_(METRIC_transaction_status_batcher_rpcs.Instantiate(metric_entity)),
+        cache_hits_(METRIC_transaction_status_batcher_cache_hits.Instantiate(metric_entity)) {
+  }
+
+  ~Impl() {
+    Shutdown();
+  }
+
+  void Enqueue(StatusCommandPtr command) {
+    IncrementCounter(requests_);
+    std::unique_lock lock(mutex_);
+    if (shutting_down_) {
+      lock.unlock();
+      command->Complete(STATUS(Aborted, "Transaction status batcher is shutting down"), Response());
+      return;
+    }
+    auto cache_it = cache_.find(CacheKey(command->status_tablet(), command->transaction_id()));
+    if (cache_it != cache_.end()) {
+      auto response = cache_it->second;
+      lock.unlock();
+      IncrementCounter(cache_hits_);
+      command->Complete(Status::OK(), response);
+      return;
+    }
+    const auto& status_tablet = command->status_tablet();
+    auto& queue = queues_[status_tablet];
+    queue.pending.push_back(std::move(command));
+    if (queue.in_flight >= MaxInFlightRpcs()) {
+      return;
+    }
+    auto request = PrepareRequestUnlocked(&queue, status_tablet);
+    lock.unlock();
+    Send(std::move(request));
+  }
+
+  void Abort(StatusCommand* command) {
+    {
+      std::lock_guard lock(mutex_);
+      auto it = queues_.find(command->status_tablet());
+      if (it != queues_.end()) {
+        auto& pending = it->second.pending;
+        pending.erase(
+            std::remove_if(pending.begin(), pending.end(),
+                           [command](const auto& entry) { return entry.get() == command; }),
+            pending.end());
+      }
+    }
+    // A command that is already part of an RPC is completed right away, the RPC response will be
+    // ignored for it.
+    command->Complete(STATUS(Aborted, "Transaction status request aborted"), Response());
+  }
+
+  void Shutdown() {
+    std::vector<StatusCommandPtr> pending;
+    {
+      std::lock_guard lock(mutex_);
+      if (shutting_down_) {
+        return;
+      }
+      shutting_down_ = true;
+      for (auto& tablet_and_queue : queues_) {
+        auto& queue = tablet_and_queue.second;
+        pending.insert(pending.end(), queue.pending.begin(), queue.pending.end());
+        queue.pending.clear();
+      }
+    }
+    for (const auto& command : pending) {
+      command->Complete(STATUS(Aborted, "Transaction status batcher is shutting down"), Response());
+    }
+    rpcs_.Shutdown();
+  }
+
+ private:
+  struct TransactionWaiters {
+    TransactionId transaction_id;
+    std::vector<StatusCommandPtr> commands;
+  };
+
+  struct StatusTabletQueue {
+    // Number of RPCs sent to the status tablet that are not completed yet.
+    size_t in_flight = 0;
+    std::deque<StatusCommandPtr> pending;
+  };
+
+  struct Request {
+    TabletId status_tablet;
+    std::vector<TransactionWaiters> transactions;
+    rpc::Rpcs::Handle handle;
+  };
+
+  using RequestPtr = std::shared_ptr<Request>;
+
+  using CacheKey = std::pair<TabletId, TransactionId>;
+
+  static size_t MaxInFlightRpcs() {
+    return std::max<size_t>(FLAGS_transaction_status_batcher_max_in_flight_rpcs, 1);
+  }
+
+  // Moves pending commands for up to max_transactions_in_status_request distinct transactions to
+  // the new request. Returns nullptr if there is nothing to send.
+  RequestPtr PrepareRequestUnlocked(StatusTabletQueue* queue, const TabletId& status_tablet)
+      REQUIRES(mutex_) {
+    const auto max_transactions = std::max<size_t>(FLAGS_max_transactions_in_status_request, 1);
+    auto request = std::make_shared<Request>();
+    request->status_tablet = status_tablet;
+    request->handle = rpcs_.InvalidHandle();
+    std::unordered_map<TransactionId, size_t, TransactionIdHash> transaction_idx;
+    std::deque<StatusCommandPtr> left;
+    for (auto& command : queue->pending) {
+      if (command->completed()) {
+        continue;
+      }
+      auto it = transaction_idx.find(command->transaction_id());
+      if (it == transaction_idx.end()) {
+        if (request->transactions.size() >= max_transactions) {
+          left.push_back(std::move(command));
+          continue;
+        }
+        it = transaction_idx.emplace(
+            command->transaction_id(), request->transactions.size()).first;
+        request->transactions.push_back(TransactionWaiters {
+          .transaction_id = command->transaction_id(),
+          .commands = {},
+        });
+      }
+      request->transactions[it->second].commands.push_back(std::move(command));
+    }
+    queue->pending = std::move(left);
+    if (request->transactions.empty()) {
+      return nullptr;
+    }
+    ++queue->in_flight;
+    return request;
+  }
+
+  void Send(RequestPtr request) {
+    if (!request) {
+      return;
+    }
+    auto* client = client_future_.get();
+    if (!client) {
+      RequestDone(request, STATUS(Aborted, "Client is not available"), Response());
+      return;
+    }
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(request->status_tablet);
+    req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    // Use the earliest deadline, so no request waits for the response past its own deadline.
+    // Requests with later deadlines are sent again if this RPC times out.
+    auto deadline = CoarseTimePoint::max();
+    for (const auto& transaction : request->transactions) {
+      const auto& id = transaction.transaction_id;
+      req.add_transaction_id()->assign(pointer_cast<const char*>(id.data()), id.size());
+      for (const auto& command : transaction.commands) {
+        deadline = std::min(deadline, command->deadline());
+      }
+    }
+    VLOG(4) << "Sending status request for " << request->transactions.size()
+            << " transactions to " << request->status_tablet;
+    IncrementCounter(rpcs_sent_);
+    auto* handle = &request->handle;
+    auto started = rpcs_.RegisterAndStart(
+        client::GetTransactionStatus(
+            deadline, nullptr /* tablet */, client, &req,
+            [self = shared_from_this(), request](
+                const Status& status, const Response& response) {
+              self->RequestDone(request, status, response);
+            }),
+        handle);
+    if (!started) {
+      RequestDone(request, STATUS(Aborted, "Transaction status batcher is shutting down"),
+                  Response());
+    }
+  }
+
+  void RequestDone(const RequestPtr& request, const Status& status, const Response& response) {
+    rpcs_.Unregister(&request->handle);
+
+    const auto num_transactions = request->transactions.size();
+    const auto num_statuses = static_cast<size_t>(response.status().size());
+    std::vector<StatusCommandPtr> requeue;
+    std::vector<std::pair<TransactionWaiters*, Response>> ready;
+    Status failure = status;
+    if (failure.ok() && num_statuses != num_transactions && num_statuses != 1) {
+      failure = STATUS_FORMAT(
+          IllegalState, "Wrong number of statuses, expected $0, found: $1",
+          num_transactions, response.ShortDebugString());
+      LOG(DFATAL) << failure;
+    }
+    std::vector<StatusCommandPtr> timed_out;
+    if (failure.IsTimedOut()) {
+      // Status request has no side effects, so requests with later deadlines are sent again.
+      const auto now = CoarseMonoClock::now();
+      for (const auto& transaction : request->transactions) {
+        for (const auto& command : transaction.commands) {
+          (command->deadline() > now ? requeue : timed_out).push_back(command);
+        }
+      }
+    } else if (failure.ok()) {
+      // Node with old software version always returns one status. The remaining transactions are
+      // requested again.
+      for (size_t i = 0; i != num_transactions; ++i) {
+        auto& transaction = request->transactions[i];
+        if (i < num_statuses) {
+          ready.emplace_back(&transaction, ExtractEntry(response, narrow_cast<int>(i)));
+        } else {
+          requeue.insert(requeue.end(), transaction.commands.begin(), transaction.commands.end());
+        }
+      }
+    }
+
+    RequestPtr next_request;
+    std::vector<StatusCommandPtr> aborted;
+    {
+      std::lock_guard lock(mutex_);
+      for (const auto& [transaction, entry] : ready) {
+        if (IsFinal(entry, AnyExternal(*transaction))) {
+          AddToCacheUnlocked(
+              CacheKey(request->status_tablet, transaction->transaction_id), entry);
+        }
+      }
+      auto it = queues_.find(request->status_tablet);
+      if (it != queues_.end()) {
+        auto& queue = it->second;
+        --queue.in_flight;
+        if (shutting_down_) {
+          aborted = std::move(requeue);
+        } else {
+          queue.pending.insert(queue.pending.begin(), requeue.begin(), requeue.end());
+          next_request = PrepareRequestUnlocked(&queue, request->status_tablet);
+        }
+        if (!queue.in_flight && queue.pending.empty()) {
+          queues_.erase(it);
+        }
+      }
+    }
+    Send(std::move(next_request));
+
+    for (const auto& command : aborted) {
+      command->Complete(STATUS(Aborted, "Transaction status batcher is shutting down"), Response());
+    }
+    if (failure.IsTimedOut()) {
+      for (const auto& command : timed_out) {
+        command->Complete(failure, response);
+      }
+      return;
+    }
+    if (!failure.ok()) {
+      for (const auto& transaction : request->transactions) {
+        for (const auto& command : transaction.commands) {
+          command->Complete(failure, response);
+        }
+      }
+      return;
+    }
+    for (const auto& [transaction, entry] : ready) {
+      for (const auto& command : transaction->commands) {
+        command->Complete(Status::OK(), entry);
+      }
+    }
+  }
+
+  static IsExternalTransaction AnyExternal(const TransactionWaiters& transaction) {
+    for (const auto& command : transaction.commands) {
+      if (command->external_transaction()) {
+        return IsExternalTransaction::kTrue;
+      }
+    }
+    return IsExternalTransaction::kFalse;
+  }
+
+  void AddToCacheUnlocked(const CacheKey& key, const Response& entry) REQUIRES(mutex_) {
+    const auto max_size = FLAGS_transaction_status_batcher_cache_size;
+    if (max_size == 0) {
+      return;
+    }
+    auto stored = entry;
+    // Propagated hybrid time is meaningful only for the response it was received with.
+    stored.clear_propagated_hybrid_time();
+    if (!cache_.emplace(key, std::move(stored)).second) {
+      return;
+    }
+    cache_order_.push_back(key);
+    while (cache_order_.size() > max_size) {
+      cache_.erase(cache_order_.front());
+      cache_order_.pop_front();
+    }
+  }
+
+  const std::shared_future<client::YBClient*> client_future_;
+  const server::ClockPtr clock_;
+
+  std::mutex mutex_;
+  bool shutting_down_ GUARDED_BY(mutex_) = false;
+  std::unordered_map<TabletId, StatusTabletQueue> queues_ GUARDED_BY(mutex_);
+  // Final statuses by status tablet and transaction.
+  std::unordered_map<CacheKey, Response, boost::hash<CacheKey>> cache_ GUARDED_BY(mutex_);
+  // Cached transactions in insertion order, used to evict the oldest entries.
+  std::deque<CacheKey> cache_order_ GUARDED_BY(mutex_);
+
+  rpc::Rpcs rpcs_;
+
+  scoped_refptr<Counter> requests_;
+  scoped_refptr<Counter> rpcs_sent_;
+  scoped_refptr<Counter> cache_hits_;
+};
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    std::shared_future<client::YBClient*> client_future, const server::ClockPtr& clock,
+    MetricEntity* metric_entity)
+    : impl_(std::make_shared<Impl>(std::move(client_future), clock, metric_entity)) {
+}
+
+TransactionStatusBatcher::~TransactionStatusBatcher() {
+  impl_->Shutdown();
+}
+
+bool TransactionStatusBatcher::IsEnabled() {
+  return GetAtomicFlag(&FLAGS_enable_transaction_status_batching);
+}
+
+rpc::RpcCommandPtr TransactionStatusBatcher::GetTransactionStatus(
+    CoarseTimePoint deadline, const TabletId& status_tablet, const TransactionId& transaction_id,
+    IsExternalTransaction external_transaction, client::GetTransactionStatusCallback callback) {
+  return std::make_shared<Impl::StatusCommand>(
+      impl_, deadline, status_tablet, transaction_id, external_transaction, std::move(callback));
+}
+
+void TransactionStatusBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <future>
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/entity_ids_types.h"
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/server/server_fwd.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+class MetricEntity;
+
+namespace tablet {
+
+// Resolves transaction statuses on behalf of all transaction participants of the tablet server.
+//
+// Up to transaction_status_batcher_max_in_flight_rpcs GetTransactionStatus RPCs are sent to a
+// single status tablet concurrently. Status requests issued while this limit is reached are
+// accumulated and sent in the next RPC, so concurrent lookups from different tablets are batched,
+// and lookups of the same transaction share a single entry. Requests are never attached to an RPC
+// that was already sent, so the coordinator always answers after the request was issued, the same
+// as for a dedicated RPC. An RPC uses the earliest deadline of its requests, requests with later
+// deadlines are sent again if it times out.
+//
+// Final statuses, i.e. committed with commit time and aborted transactions known to the
+// coordinator, are cached by status tablet and transaction id and served without RPC.
+class TransactionStatusBatcher {
+ public:
+  TransactionStatusBatcher(
+      std::shared_future<client::YBClient*> client_future, const server::ClockPtr& clock,
+      MetricEntity* metric_entity);
+  ~TransactionStatusBatcher();
+
+  // Whether participants should resolve statuses through the batcher.
+  static bool IsEnabled();
+
+  // Drop in replacement for client::GetTransactionStatus for a single transaction.
+  // The response passed to the callback contains exactly one entry.
+  // Aborted status of external transactions is not final, so it is not cached for them.
+  MUST_USE_RESULT rpc::RpcCommandPtr GetTransactionStatus(
+      CoarseTimePoint deadline, const TabletId& status_tablet, const TransactionId& transaction_id,
+      IsExternalTransaction external_transaction, client::GetTransactionStatusCallback callback);
+
+  void Shutdown();
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
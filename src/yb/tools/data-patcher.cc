@@ -609,7 +609,7 @@ Status ChangeTimeInWalDir(
   // Set up the new header and footer.
   log::LogSegmentHeaderPB header;
   header.set_major_version(log::kLogMajorVersion);
-  header.set_minor_version(log::kLogMinorVersion);
+  header.set_minor_version(log::kLogMinorVersionWithoutCompression);
   header.set_sequence_number(1);
   header.set_unused_tablet_id("TABLET ID");
   header.mutable_deprecated_schema();
@@ -0,0 +1,201 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/compaction_io_controller.h"
+
+#include <algorithm>
+
+#include "yb/gutil/strings/human_readable.h"
+
+#include "yb/rocksdb/rate_limiter.h"
+
+#include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_peer.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+DEFINE_NON_RUNTIME_bool(enable_adaptive_compaction_rate_limit, false,
+                        "If set and the flush and compaction rate limiter is shared by the tablet "
+                        "server, its budget is adjusted depending on foreground read latency and "
+                        "on the number of SST files of tablets. "
+                        "rocksdb_compact_flush_rate_limit_bytes_per_sec is used as the max budget.");
+
+DEFINE_NON_RUNTIME_uint32(adaptive_compaction_rate_limit_interval_ms, 1000,
+                          "Interval between adjustments of the compaction I/O budget.");
+
+DEFINE_RUNTIME_uint32(adaptive_compaction_min_rate_percentage, 10,
+                      "Compaction I/O budget is never lowered below this percentage of "
+                      "rocksdb_compact_flush_rate_limit_bytes_per_sec.");
+
+DEFINE_RUNTIME_uint32(adaptive_compaction_rate_step_percentage, 10,
+                      "Percentage of rocksdb_compact_flush_rate_limit_bytes_per_sec the compaction "
+                      "I/O budget is changed by in a single adjustment.");
+
+DEFINE_RUNTIME_uint64(adaptive_compaction_read_latency_p99_target_us, 10000,
+                      "Compaction I/O budget is lowered when p99 of foreground read latency is "
+                      "above this value. 0 to ignore read latency.");
+
+DEFINE_RUNTIME_uint64(adaptive_compaction_min_read_samples, 100,
+                      "Min number of reads since the previous adjustment required to take read "
+                      "latency into account.");
+
+DEFINE_RUNTIME_uint32(adaptive_compaction_sst_files_stall_risk_percentage, 50,
+                      "Compaction I/O budget is raised regardless of read latency when a tablet has "
+                      "more SST files than this percentage of sst_files_soft_limit.");
+
+DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
+DECLARE_uint64(sst_files_soft_limit);
+
+METRIC_DEFINE_gauge_int64(server, compaction_io_budget,
+                          "Compaction I/O Budget",
+                          yb::MetricUnit::kBytes,
+                          "Flush and compaction bytes per second currently allowed by the adaptive "
+                          "compaction rate limiter.");
+METRIC_DEFINE_gauge_uint64(server, compaction_io_read_latency_p99,
+                           "Compaction I/O Controller Read Latency p99",
+                           yb::MetricUnit::kMicroseconds,
+                           "p99 of foreground read latency observed by the adaptive compaction "
+                           "rate limiter in its last round.");
+METRIC_DEFINE_gauge_uint64(server, compaction_io_max_sst_files,
+                           "Compaction I/O Controller Max SST Files",
+                           yb::MetricUnit::kFiles,
+                           "Max number of SST files of a tablet observed by the adaptive compaction "
+                           "rate limiter in its last round.");
+METRIC_DEFINE_counter(server, compaction_io_budget_increases,
+                      "Compaction I/O Budget Increases",
+                      yb::MetricUnit::kUnits,
+                      "Number of times the adaptive compaction rate limiter raised the budget.");
+METRIC_DEFINE_counter(server, compaction_io_budget_decreases,
+                      "Compaction I/O Budget Decreases",
+                      yb::MetricUnit::kUnits,
+                      "Number of times the adaptive compaction rate limiter lowered the budget.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Reads slower than a minute are recorded as a minute.
+constexpr uint64_t kMaxTrackedReadLatencyUs = 60'000'000;
+
+} // namespace
+
+CompactionIoController::CompactionIoController(
+    std::shared_ptr<rocksdb::RateLimiter> rate_limiter,
+    const scoped_refptr<MetricEntity>& metrics,
+    const std::function<std::vector<tablet::TabletPeerPtr>()>& peers_fn)
+    : rate_limiter_(std::move(rate_limiter)),
+      peers_fn_(peers_fn),
+      read_latency_histogram_(std::make_shared<HdrHistogram>(kMaxTrackedReadLatencyUs, 2)),
+      budget_(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec),
+      budget_gauge_(METRIC_compaction_io_budget.Instantiate(metrics, budget_)),
+      read_latency_p99_(METRIC_compaction_io_read_latency_p99.Instantiate(metrics, 0)),
+      max_sst_files_(METRIC_compaction_io_max_sst_files.Instantiate(metrics, 0)),
+      budget_increases_(METRIC_compaction_io_budget_increases.Instantiate(metrics)),
+      budget_decreases_(METRIC_compaction_io_budget_decreases.Instantiate(metrics)) {
+  background_task_ = std::make_unique<BackgroundTask>(
+      std::function<void()>([this]() { AdjustBudget(); }),
+      "tablet manager",
+      "compaction io controller bgtask",
+      std::chrono::milliseconds(FLAGS_adaptive_compaction_rate_limit_interval_ms));
+}
+
+CompactionIoController::~CompactionIoController() = default;
+
+bool CompactionIoController::IsEnabled() {
+  return FLAGS_enable_adaptive_compaction_rate_limit;
+}
+
+Status CompactionIoController::Init() {
+  return background_task_->Init();
+}
+
+void CompactionIoController::Shutdown() {
+  background_task_->Shutdown();
+}
+
+void CompactionIoController::AdjustBudget() {
+  const auto max_budget = FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec;
+  if (max_budget <= 0) {
+    return;
+  }
+  const auto min_budget = std::max<int64_t>(
+      max_budget * std::min<uint32_t>(FLAGS_adaptive_compaction_min_rate_percentage, 100) / 100,
+      1);
+  const auto step = std::max<int64_t>(
+      max_budget * FLAGS_adaptive_compaction_rate_step_percentage / 100, 1);
+
+  uint64_t read_latency_p99 = 0;
+  if (read_latency_histogram_->CurrentCount() >= FLAGS_adaptive_compaction_min_read_samples) {
+    read_latency_p99 = read_latency_histogram_->ValueAtPercentile(99);
+  }
+  read_latency_histogram_->ResetPercentiles();
+  const auto max_sst_files = MaxSstFiles();
+  read_latency_p99_->set_value(read_latency_p99);
+  max_sst_files_->set_value(max_sst_files);
+
+  // Write rejection is worse than slow reads, so falling behind with compactions always wins.
+  const auto stall_risk =
+      max_sst_files * 100 >
+          FLAGS_sst_files_soft_limit * FLAGS_adaptive_compaction_sst_files_stall_risk_percentage;
+  const auto latency_target = FLAGS_adaptive_compaction_read_latency_p99_target_us;
+  const auto slow_reads = latency_target && read_latency_p99 > latency_target;
+
+  auto new_budget = std::clamp(budget_, min_budget, max_budget);
+  if (stall_risk || !slow_reads) {
+    new_budget = std::min(new_budget + step, max_budget);
+  } else {
+    new_budget = std::max(new_budget - step, min_budget);
+  }
+  VLOG(2) << "Compaction I/O round, read p99: " << read_latency_p99 << "us, max SST files: "
+          << max_sst_files << ", budget: " << budget_ << " => " << new_budget;
+
+  if (new_budget == budget_) {
+    return;
+  }
+  if (new_budget > budget_) {
+    IncrementCounter(budget_increases_);
+  } else {
+    IncrementCounter(budget_decreases_);
+  }
+  SetBudget(new_budget);
+}
+
+int64_t CompactionIoController::budget() const {
+  return budget_gauge_->value();
+}
+
+uint64_t CompactionIoController::MaxSstFiles() const {
+  uint64_t result = 0;
+  for (const auto& peer : peers_fn_()) {
+    const auto tablet = peer->shared_tablet();
+    if (tablet) {
+      result = std::max(result, tablet->GetCurrentVersionNumSSTFiles());
+    }
+  }
+  return result;
+}
+
+void CompactionIoController::SetBudget(int64_t budget) {
+  VLOG(1) << "Compaction I/O budget: " << HumanReadableNumBytes::ToString(budget_) << "/s => "
+          << HumanReadableNumBytes::ToString(budget) << "/s";
+  budget_ = budget;
+  rate_limiter_->SetBytesPerSecond(budget);
+  budget_gauge_->set_value(budget);
+}
+
+} // namespace tserver
+} // namespace yb
@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "yb/tablet/tablet_fwd.h"
+
+#include "yb/util/background_task.h"
+#include "yb/util/metrics_fwd.h"
+
+namespace rocksdb {
+class RateLimiter;
+}
+
+namespace yb {
+
+class HdrHistogram;
+
+namespace tserver {
+
+// Adjusts the flush and compaction I/O budget of the tablet server wide rate limiter.
+//
+// Every adaptive_compaction_rate_limit_interval_ms the controller looks at:
+// - p99 of foreground read latency of all tablets since the previous round;
+// - the max number of SST files in the regular DB of a tablet, i.e. the risk of write rejection
+//   because of sst_files_soft_limit.
+// The budget is increased when compactions fall behind or reads are fast enough, and decreased
+// when read p99 is above adaptive_compaction_read_latency_p99_target_us. It always stays between
+// adaptive_compaction_min_rate_percentage of rocksdb_compact_flush_rate_limit_bytes_per_sec and
+// rocksdb_compact_flush_rate_limit_bytes_per_sec itself.
+class CompactionIoController {
+ public:
+  CompactionIoController(
+      std::shared_ptr<rocksdb::RateLimiter> rate_limiter,
+      const scoped_refptr<MetricEntity>& metrics,
+      const std::function<std::vector<tablet::TabletPeerPtr>()>& peers_fn);
+
+  ~CompactionIoController();
+
+  // Whether the tablet server should adjust its compaction I/O budget.
+  static bool IsEnabled();
+
+  Status Init();
+  void Shutdown();
+
+  // Histogram that receives foreground read latencies of all tablets, in microseconds.
+  const std::shared_ptr<HdrHistogram>& read_latency_histogram() const {
+    return read_latency_histogram_;
+  }
+
+  // Runs a single adjustment round. Invoked periodically by the background task.
+  void AdjustBudget();
+
+  int64_t budget() const;
+
+ private:
+  uint64_t MaxSstFiles() const;
+
+  void SetBudget(int64_t budget);
+
+  const std::shared_ptr<rocksdb::RateLimiter> rate_limiter_;
+  const std::function<std::vector<tablet::TabletPeerPtr>()> peers_fn_;
+  const std::shared_ptr<HdrHistogram> read_latency_histogram_;
+
+  // Only accessed from AdjustBudget, i.e. from the background task thread.
+  int64_t budget_;
+
+  std::unique_ptr<BackgroundTask> background_task_;
+
+  scoped_refptr<AtomicGauge<int64_t>> budget_gauge_;
+  scoped_refptr<AtomicGauge<uint64_t>> read_latency_p99_;
+  scoped_refptr<AtomicGauge<uint64_t>> max_sst_files_;
+  scoped_refptr<Counter> budget_increases_;
+  scoped_refptr<Counter> budget_decreases_;
+};
+
+} // namespace tserver
+} // namespace yb
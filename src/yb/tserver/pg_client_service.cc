@@ -46,6 +46,7 @@
 #include "yb/tserver/pg_response_cache.h"
 #include "yb/tserver/pg_sequence_cache.h"
 #include "yb/tserver/pg_table_cache.h"
+#include "yb/tserver/pg_write_coalescer.h"
 #include "yb/tserver/tablet_server_interface.h"
 #include "yb/tserver/tserver_service.pb.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -204,6 +205,7 @@ class PgClientServiceImpl::Impl {
         xcluster_context_(xcluster_context),
         pg_node_level_mutation_counter_(pg_node_level_mutation_counter),
         response_cache_(metric_entity),
+        write_coalescer_(client_future, clock, metric_entity),
         instance_id_(Uuid::Generate()) {
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
@@ -226,7 +228,7 @@ class PgClientServiceImpl::Impl {
     auto session = std::make_shared<LockablePgClientSession>(
         FLAGS_pg_client_session_expiration_ms * 1ms, session_id, &client(), clock_,
         transaction_pool_provider_, &table_cache_, xcluster_context_,
-        pg_node_level_mutation_counter_, &response_cache_, &sequence_cache_);
+        pg_node_level_mutation_counter_, &response_cache_, &sequence_cache_, &write_coalescer_);
     resp->set_session_id(session_id);
     if (FLAGS_pg_client_use_shared_memory) {
       resp->set_instance_id(instance_id_.data(), instance_id_.size());
@@ -609,6 +611,8 @@ class PgClientServiceImpl::Impl {
 
   PgSequenceCache sequence_cache_;
 
+  PgWriteCoalescer write_coalescer_;
+
   const Uuid instance_id_;
 };
 
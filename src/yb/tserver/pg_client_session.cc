@@ -42,6 +42,7 @@
 #include "yb/tserver/pg_response_cache.h"
 #include "yb/tserver/pg_sequence_cache.h"
 #include "yb/tserver/pg_table_cache.h"
+#include "yb/tserver/pg_write_coalescer.h"
 #include "yb/tserver/xcluster_safe_time_map.h"
 
 #include "yb/util/backoff_waiter.h"
@@ -295,6 +296,7 @@ Status GetTable(const TableId& table_id, PgTableCache* cache, client::YBTablePtr
   return Status::OK();
 }
 
+// When session is null, operations are created but not applied to any session.
 Result<PgClientSessionOperations> PrepareOperations(
     PgPerformRequestPB* req, client::YBSession* session, rpc::Sidecars* sidecars,
     PgTableCache* table_cache) {
@@ -304,7 +306,7 @@ Result<PgClientSessionOperations> PrepareOperations(
   client::YBTablePtr table;
   bool finished = false;
   auto se = ScopeExit([&finished, session] {
-    if (!finished) {
+    if (!finished && session) {
       session->Abort();
     }
   });
@@ -318,7 +320,9 @@ Result<PgClientSessionOperations> PrepareOperations(
         read_op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
       }
       ops.push_back(read_op);
-      session->Apply(std::move(read_op));
+      if (session) {
+        session->Apply(std::move(read_op));
+      }
     } else {
       auto& write = *op.mutable_write();
       RETURN_NOT_OK(GetTable(write.table_id(), table_cache, &table));
@@ -328,7 +332,9 @@ Result<PgClientSessionOperations> PrepareOperations(
         write_time = HybridTime::kInvalid;
       }
       ops.push_back(write_op);
-      session->Apply(std::move(write_op));
+      if (session) {
+        session->Apply(std::move(write_op));
+      }
     }
   }
   finished = true;
@@ -507,6 +513,22 @@ struct SharedExchangeQuery : public SharedExchangeQueryParams, public PerformDat
   }
 };
 
+// Writes could be coalesced with writes from other sessions only when they don't depend on the
+// session state, i.e. single shard non transactional writes without explicit read or write time.
+bool IsCoalescableWrite(
+    const PgPerformRequestPB& req, const client::YBSession& session,
+    const client::YBTransactionPtr& transaction) {
+  if (!PgWriteCoalescer::IsEnabled() || transaction || req.write_time() ||
+      req.ops().size() != 1 || !req.ops(0).has_write() || req.ops(0).write().is_backfill()) {
+    return false;
+  }
+  const auto& options = req.options();
+  return static_cast<IsolationLevel>(options.isolation()) == IsolationLevel::NON_TRANSACTIONAL &&
+         !options.ddl_mode() && !options.use_catalog_session() && !options.has_read_time() &&
+         !options.defer_read_point() && !options.trace_requested() &&
+         !session.read_point()->GetReadTime();
+}
+
 client::YBSessionPtr CreateSession(
     client::YBClient* client, const scoped_refptr<ClockBase>& clock) {
   auto result = std::make_shared<client::YBSession>(client, clock);
@@ -530,7 +552,7 @@ PgClientSession::PgClientSession(
     std::reference_wrapper<const TransactionPoolProvider> transaction_pool_provider,
     PgTableCache* table_cache, const std::optional<XClusterContext>& xcluster_context,
     PgMutationCounter* pg_node_level_mutation_counter, PgResponseCache* response_cache,
-    PgSequenceCache* sequence_cache)
+    PgSequenceCache* sequence_cache, PgWriteCoalescer* write_coalescer)
     : id_(id),
       client_(*client),
       clock_(clock),
@@ -539,7 +561,8 @@ PgClientSession::PgClientSession(
       xcluster_context_(xcluster_context),
       pg_node_level_mutation_counter_(pg_node_level_mutation_counter),
       response_cache_(*response_cache),
-      sequence_cache_(*sequence_cache) {}
+      sequence_cache_(*sequence_cache),
+      write_coalescer_(*write_coalescer) {}
 
 uint64_t PgClientSession::id() const {
   return id_;
@@ -927,7 +950,7 @@ Status PgClientSession::DoPerform(const DataPtr& data, CoarseTimePoint deadline,
   }
   if (options.has_caching_info()) {
     data->cache_setter = VERIFY_RESULT(response_cache_.Get(
-        options.mutable_caching_info(), &data->resp, &data->sidecars, deadline));
+        &options, &data->resp, &data->sidecars, deadline));
     if (!data->cache_setter) {
       data->SendResponse();
       return Status::OK();
@@ -954,6 +977,8 @@ Status PgClientSession::DoPerform(const DataPtr& data, CoarseTimePoint deadline,
     ADOPT_TRACE(context->trace());
   }
 
+  const auto coalesce_writes = IsCoalescableWrite(data->req, *session, transaction);
+
   data->used_read_time = session_info.second;
   data->used_in_txn_limit = in_txn_limit;
   data->transaction = std::move(transaction);
@@ -961,7 +986,19 @@ Status PgClientSession::DoPerform(const DataPtr& data, CoarseTimePoint deadline,
   data->subtxn_id = options.active_sub_transaction_id();
 
   data->ops = VERIFY_RESULT(PrepareOperations(
-      &data->req, session, &data->sidecars, &table_cache_));
+      &data->req, coalesce_writes ? nullptr : session, &data->sidecars, &table_cache_));
+
+  if (coalesce_writes) {
+    if (write_coalescer_.Submit(data->ops, deadline, [data](client::FlushStatus* flush_status) {
+          data->FlushDone(flush_status);
+        })) {
+      VLOG_WITH_PREFIX(2) << "Coalesced write of " << data->ops.size() << " ops";
+      return Status::OK();
+    }
+    for (const auto& op : data->ops) {
+      session->Apply(op);
+    }
+  }
 
   session->FlushAsync([this, data](client::FlushStatus* flush_status) {
     data->FlushDone(flush_status);
@@ -100,7 +100,7 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
       std::reference_wrapper<const TransactionPoolProvider> transaction_pool_provider,
       PgTableCache* table_cache, const std::optional<XClusterContext>& xcluster_context,
       PgMutationCounter* pg_node_level_mutation_counter, PgResponseCache* response_cache,
-      PgSequenceCache* sequence_cache);
+      PgSequenceCache* sequence_cache, PgWriteCoalescer* write_coalescer);
 
   uint64_t id() const;
 
@@ -180,6 +180,7 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
   PgMutationCounter* pg_node_level_mutation_counter_;
   PgResponseCache& response_cache_;
   PgSequenceCache& sequence_cache_;
+  PgWriteCoalescer& write_coalescer_;
 
   std::array<SessionData, kPgClientSessionKindMapSize> sessions_;
   uint64_t txn_serial_no_ = 0;
@@ -0,0 +1,114 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/sidecars.h"
+
+#include "yb/tserver/pg_client.pb.h"
+#include "yb/tserver/pg_response_cache.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/result.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+METRIC_DECLARE_entity(server);
+METRIC_DECLARE_counter(pg_response_cache_catalog_version_evictions);
+METRIC_DECLARE_counter(pg_response_cache_obsolete_catalog_version);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+const std::string kNamespaceId = "namespace";
+const std::string kOtherNamespaceId = "other_namespace";
+
+} // namespace
+
+class PgResponseCacheTest : public YBTest {
+ protected:
+  PgResponseCacheTest()
+      : metric_entity_(METRIC_ENTITY_server.Instantiate(&metric_registry_, "test")),
+        cache_(metric_entity_.get()) {}
+
+  // Returns true if the response was taken from the cache, otherwise loads it.
+  Result<bool> Get(
+      const std::string& key, uint64_t catalog_version,
+      const std::string& namespace_id = kNamespaceId) {
+    PgPerformOptionsPB options;
+    options.set_namespace_id(namespace_id);
+    auto& caching_info = *options.mutable_caching_info();
+    caching_info.set_key(key);
+    caching_info.set_catalog_version(catalog_version);
+    PgPerformResponsePB response;
+    rpc::Sidecars sidecars;
+    auto setter = VERIFY_RESULT(
+        cache_.Get(&options, &response, &sidecars, CoarseMonoClock::Now() + 10s));
+    if (!setter) {
+      return true;
+    }
+    setter(PgResponseCache::Response(true, PgPerformResponsePB(), {}));
+    return false;
+  }
+
+  int64_t CounterValue(const CounterPrototype& prototype) {
+    return prototype.Instantiate(metric_entity_)->value();
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  PgResponseCache cache_;
+};
+
+TEST_F(PgResponseCacheTest, EvictOnCatalogVersionBump) {
+  ASSERT_FALSE(ASSERT_RESULT(Get("a", 1)));
+  ASSERT_FALSE(ASSERT_RESULT(Get("b", 1)));
+  ASSERT_FALSE(ASSERT_RESULT(Get("unversioned", 0)));
+  ASSERT_FALSE(ASSERT_RESULT(Get("a", 1, kOtherNamespaceId)));
+  ASSERT_TRUE(ASSERT_RESULT(Get("a", 1)));
+
+  // Entries of older versions in the same namespace are evicted by a newer version.
+  ASSERT_FALSE(ASSERT_RESULT(Get("c", 2)));
+  ASSERT_EQ(CounterValue(METRIC_pg_response_cache_catalog_version_evictions), 2);
+  ASSERT_TRUE(ASSERT_RESULT(Get("c", 2)));
+  ASSERT_TRUE(ASSERT_RESULT(Get("unversioned", 0)));
+  ASSERT_TRUE(ASSERT_RESULT(Get("a", 1, kOtherNamespaceId)));
+
+  // Same version does not evict anything.
+  ASSERT_FALSE(ASSERT_RESULT(Get("d", 2)));
+  ASSERT_TRUE(ASSERT_RESULT(Get("c", 2)));
+  ASSERT_EQ(CounterValue(METRIC_pg_response_cache_catalog_version_evictions), 2);
+}
+
+TEST_F(PgResponseCacheTest, ObsoleteCatalogVersionNotCached) {
+  ASSERT_FALSE(ASSERT_RESULT(Get("a", 1)));
+  ASSERT_FALSE(ASSERT_RESULT(Get("b", 2)));
+
+  // A lagging backend with the older version gets its response loaded, but does not put it back
+  // in the cache.
+  ASSERT_FALSE(ASSERT_RESULT(Get("a", 1)));
+  ASSERT_FALSE(ASSERT_RESULT(Get("a", 1)));
+  ASSERT_EQ(CounterValue(METRIC_pg_response_cache_obsolete_catalog_version), 2);
+  ASSERT_EQ(CounterValue(METRIC_pg_response_cache_catalog_version_evictions), 1);
+
+  ASSERT_TRUE(ASSERT_RESULT(Get("b", 2)));
+}
+
+} // namespace tserver
+} // namespace yb
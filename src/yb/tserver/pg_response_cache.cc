@@ -15,6 +15,7 @@
 
 #include <future>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include <boost/multi_index/member.hpp>
@@ -54,6 +55,16 @@ METRIC_DEFINE_counter(server, pg_response_cache_renew_hard,
                       "PgClientService Response Cache Renewed Hard",
                       yb::MetricUnit::kCacheQueries,
                       "Total number of PgClientService response cache entries renewed hard");
+METRIC_DEFINE_counter(server, pg_response_cache_catalog_version_evictions,
+                      "PgClientService Response Cache Catalog Version Evictions",
+                      yb::MetricUnit::kEntries,
+                      "Total number of PgClientService response cache entries removed because "
+                      "a newer catalog version was observed");
+METRIC_DEFINE_counter(server, pg_response_cache_obsolete_catalog_version,
+                      "PgClientService Response Cache Obsolete Catalog Version",
+                      yb::MetricUnit::kCacheQueries,
+                      "Total number of PgClientService response cache queries that were not "
+                      "cached because a newer catalog version was already observed");
 
 DEFINE_NON_RUNTIME_uint64(
     pg_response_cache_capacity, 1024, "PgClientService response cache capacity.");
@@ -122,10 +133,12 @@ class Data {
 };
 
 struct Entry {
-  explicit Entry(std::string&& key_)
-      : key(std::move(key_)) {}
+  Entry(std::string&& key_, const std::string& namespace_id_, uint64_t catalog_version_)
+      : key(std::move(key_)), namespace_id(namespace_id_), catalog_version(catalog_version_) {}
 
   std::string key;
+  std::string namespace_id;
+  uint64_t catalog_version;
   std::shared_ptr<Data> data;
 };
 
@@ -148,11 +161,20 @@ void FillResponse(PgPerformResponsePB* response,
 } // namespace
 
 class PgResponseCache::Impl {
-  [[nodiscard]] auto DoGetEntry(
-      PgPerformOptionsPB::CachingInfoPB* cache_info, const CoarseTimePoint& deadline) {
+  [[nodiscard]] auto DoGetEntry(PgPerformOptionsPB* options, const CoarseTimePoint& deadline) {
     auto now = CoarseMonoClock::Now();
+    auto* cache_info = options->mutable_caching_info();
+    const auto catalog_version = cache_info->catalog_version();
     std::lock_guard lock(mutex_);
-    const auto& data = entries_.emplace(std::move(*cache_info->mutable_key()))->data;
+    if (!EvictObsoleteEntries(options->namespace_id(), catalog_version)) {
+      // Response for a backend that has not observed the latest catalog version yet is loaded but
+      // not cached. Backends with the latest version would never use it, and it could not be
+      // evicted by catalog version anymore.
+      IncrementCounter(obsolete_catalog_version_);
+      return std::make_pair(std::make_shared<Data>(now, deadline), true);
+    }
+    const auto& data = entries_.emplace(
+        std::move(*cache_info->mutable_key()), options->namespace_id(), catalog_version)->data;
     bool loading_required = false;
     if (!data ||
         !data->IsValid(now) ||
@@ -164,13 +186,42 @@ class PgResponseCache::Impl {
     return std::make_pair(data, loading_required);
   }
 
+  // Responses are built for the particular catalog version (it is the part of the key), so they
+  // become useless as soon as any backend observes a newer catalog version in the same namespace.
+  // Returns false if the specified catalog version is older than the latest observed one.
+  [[nodiscard]] bool EvictObsoleteEntries(const std::string& namespace_id, uint64_t catalog_version)
+      REQUIRES(mutex_) {
+    if (!catalog_version) {
+      return true;
+    }
+    auto& latest_version = latest_catalog_versions_[namespace_id];
+    if (catalog_version <= latest_version) {
+      return catalog_version == latest_version;
+    }
+    latest_version = catalog_version;
+    const auto evicted = entries_.EraseIf([&namespace_id, catalog_version](const Entry& entry) {
+      return entry.catalog_version && entry.catalog_version < catalog_version &&
+             entry.namespace_id == namespace_id;
+    });
+    if (evicted) {
+      VLOG(1) << "Evicted " << evicted << " entries older than catalog version "
+              << catalog_version << " for namespace '" << namespace_id << "'";
+      IncrementCounterBy(catalog_version_evictions_, evicted);
+    }
+    return true;
+  }
+
  public:
   explicit Impl(MetricEntity* metric_entity)
       : entries_(FLAGS_pg_response_cache_capacity),
         queries_(METRIC_pg_response_cache_queries.Instantiate(metric_entity)),
         hits_(METRIC_pg_response_cache_hits.Instantiate(metric_entity)),
         renew_soft_(METRIC_pg_response_cache_renew_soft.Instantiate(metric_entity)),
-        renew_hard_(METRIC_pg_response_cache_renew_hard.Instantiate(metric_entity)) {
+        renew_hard_(METRIC_pg_response_cache_renew_hard.Instantiate(metric_entity)),
+        catalog_version_evictions_(
+            METRIC_pg_response_cache_catalog_version_evictions.Instantiate(metric_entity)),
+        obsolete_catalog_version_(
+            METRIC_pg_response_cache_obsolete_catalog_version.Instantiate(metric_entity)) {
   }
 
   [[nodiscard]] bool RenewRequired(
@@ -188,9 +239,9 @@ class PgResponseCache::Impl {
   }
 
   Result<PgResponseCache::Setter> Get(
-      PgPerformOptionsPB::CachingInfoPB* cache_info, PgPerformResponsePB* response,
+      PgPerformOptionsPB* options, PgPerformResponsePB* response,
       rpc::Sidecars* sidecars, CoarseTimePoint deadline) {
-    auto [data, loading_required] = DoGetEntry(cache_info, deadline);
+    auto [data, loading_required] = DoGetEntry(options, deadline);
     IncrementCounter(queries_);
     if (!loading_required) {
       IncrementCounter(hits_);
@@ -208,10 +259,13 @@ class PgResponseCache::Impl {
       Entry,
       boost::multi_index::member<Entry, std::string, &Entry::key>
   > entries_ GUARDED_BY(mutex_);
+  std::unordered_map<std::string, uint64_t> latest_catalog_versions_ GUARDED_BY(mutex_);
   scoped_refptr<Counter> queries_;
   scoped_refptr<Counter> hits_;
   scoped_refptr<Counter> renew_soft_;
   scoped_refptr<Counter> renew_hard_;
+  scoped_refptr<Counter> catalog_version_evictions_;
+  scoped_refptr<Counter> obsolete_catalog_version_;
 };
 
 PgResponseCache::PgResponseCache(MetricEntity* metric_entity)
@@ -221,10 +275,10 @@ PgResponseCache::PgResponseCache(MetricEntity* metric_entity)
 PgResponseCache::~PgResponseCache() = default;
 
 Result<PgResponseCache::Setter> PgResponseCache::Get(
-    PgPerformOptionsPB::CachingInfoPB* cache_info,
+    PgPerformOptionsPB* options,
     PgPerformResponsePB* response, rpc::Sidecars* sidecars,
     CoarseTimePoint deadline) {
-  return impl_->Get(cache_info, response, sidecars, deadline);
+  return impl_->Get(options, response, sidecars, deadline);
 }
 
 } // namespace tserver
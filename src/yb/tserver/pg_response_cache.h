@@ -57,8 +57,11 @@ class PgResponseCache {
 
   using Setter = std::function<void(Response&&)>;
 
+  // Looks up the response for the caching info of the options. Cached responses built for
+  // catalog versions older than the one in the caching info are dropped for the same namespace.
+  // Responses for catalog versions that are older than the latest observed one are not cached.
   Result<Setter> Get(
-      PgPerformOptionsPB::CachingInfoPB* cache_info,
+      PgPerformOptionsPB* options,
       PgPerformResponsePB* response, rpc::Sidecars* sidecars,
              CoarseTimePoint deadline);
 
@@ -0,0 +1,306 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tserver/pg_write_coalescer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "yb/client/error.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+using namespace std::literals;
+
+METRIC_DEFINE_counter(server, pg_write_coalescer_batches,
+                      "PgClientService Coalesced Write Batches",
+                      yb::MetricUnit::kRequests,
+                      "Total number of coalesced write batches flushed by PgClientService");
+METRIC_DEFINE_counter(server, pg_write_coalescer_requests,
+                      "PgClientService Coalesced Write Requests",
+                      yb::MetricUnit::kRequests,
+                      "Total number of Perform requests whose writes were coalesced");
+METRIC_DEFINE_counter(server, pg_write_coalescer_ops,
+                      "PgClientService Coalesced Write Operations",
+                      yb::MetricUnit::kOperations,
+                      "Total number of write operations flushed in coalesced batches");
+METRIC_DEFINE_counter(server, pg_write_coalescer_key_conflicts,
+                      "PgClientService Coalesced Write Key Conflicts",
+                      yb::MetricUnit::kRequests,
+                      "Total number of Perform requests that started a new coalesced batch because "
+                      "the pending one already had a write to the same row");
+
+DEFINE_RUNTIME_bool(ysql_coalesce_single_shard_writes, false,
+                    "If set, single shard non transactional writes that concurrently arrive from "
+                    "different YSQL sessions are coalesced by PgClientService, so writes to the "
+                    "same tablet are sent in one write RPC and replicated in one Raft round.");
+
+DEFINE_RUNTIME_uint32(ysql_coalesce_writes_max_batch_ops, 1024,
+                      "Maximal number of operations in a single coalesced write batch.");
+
+DEFINE_RUNTIME_uint32(ysql_coalesce_writes_max_in_flight_batches, 4,
+                      "Maximal number of coalesced write batches flushed concurrently.");
+
+DEFINE_RUNTIME_uint32(ysql_coalesce_writes_max_deadline_skew_ms, 100,
+                      "A write joins a pending coalesced batch only if its deadline is at most this "
+                      "much later than the deadline of the batch, that is the earliest deadline of "
+                      "its writes.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Identifies the row written by the operation, the same way as RowIdentifier in PgOperationBuffer.
+std::string RowKey(const client::YBPgsqlWriteOp& op) {
+  const auto& request = op.request();
+  std::string result = op.table()->id();
+  result.push_back('\0');
+  if (request.has_ybctid_column_value()) {
+    result += request.ybctid_column_value().value().binary_value();
+    return result;
+  }
+  // Equal primary key values are serialized to equal strings.
+  for (const auto& value : request.partition_column_values()) {
+    value.AppendToString(&result);
+  }
+  for (const auto& value : request.range_column_values()) {
+    value.AppendToString(&result);
+  }
+  return result;
+}
+
+} // namespace
+
+class PgWriteCoalescer::Impl {
+ public:
+  Impl(std::shared_future<client::YBClient*> client_future, const scoped_refptr<ClockBase>& clock,
+       MetricEntity* metric_entity)
+      : client_future_(std::move(client_future)),
+        clock_(clock),
+        batches_(METRIC_pg_write_coalescer_batches.Instantiate(metric_entity)),
+        requests_(METRIC_pg_write_coalescer_requests.Instantiate(metric_entity)),
+        ops_(METRIC_pg_write_coalescer_ops.Instantiate(metric_entity)),
+        key_conflicts_(METRIC_pg_write_coalescer_key_conflicts.Instantiate(metric_entity)) {
+  }
+
+  ~Impl() {
+    Shutdown();
+  }
+
+  bool Submit(const Operations& ops, CoarseTimePoint deadline, Callback callback) {
+    if (ops.empty()) {
+      return false;
+    }
+    std::vector<std::string> keys;
+    keys.reserve(ops.size());
+    for (const auto& op : ops) {
+      if (op->type() != client::YBOperation::PGSQL_WRITE) {
+        return false;
+      }
+      keys.push_back(RowKey(down_cast<const client::YBPgsqlWriteOp&>(*op)));
+    }
+    BatchPtr batch_to_flush;
+    {
+      std::lock_guard lock(mutex_);
+      if (shutting_down_) {
+        return false;
+      }
+      auto& batch = BatchForOps(keys, deadline);
+      const auto waiter_idx = batch.callbacks.size();
+      for (const auto& op : ops) {
+        batch.session->Apply(op);
+        batch.op_to_waiter.emplace(op.get(), waiter_idx);
+      }
+      for (auto& key : keys) {
+        batch.keys.insert(std::move(key));
+      }
+      batch.callbacks.push_back(std::move(callback));
+      batch.num_ops += ops.size();
+      batch.deadline = std::min(batch.deadline, deadline);
+      if (in_flight_batches_ >=
+              std::max<size_t>(FLAGS_ysql_coalesce_writes_max_in_flight_batches, 1)) {
+        return true;
+      }
+      ++in_flight_batches_;
+      batch_to_flush = PopBatch();
+    }
+    Flush(std::move(batch_to_flush));
+    return true;
+  }
+
+  void Shutdown() {
+    std::unique_lock lock(mutex_);
+    shutting_down_ = true;
+    flush_done_cond_.wait(lock, [this] { return in_flight_batches_ == 0; });
+  }
+
+ private:
+  struct Batch {
+    client::YBSessionPtr session;
+    // Earliest deadline of the requests in this batch.
+    CoarseTimePoint deadline = CoarseTimePoint::max();
+    size_t num_ops = 0;
+    std::vector<Callback> callbacks;
+    // Maps operation to the index of the callback that should receive its error.
+    std::unordered_map<const client::YBOperation*, size_t> op_to_waiter;
+    // Rows written by the operations in this batch.
+    std::unordered_set<std::string> keys;
+  };
+
+  using BatchPtr = std::shared_ptr<Batch>;
+
+  // Returns the last pending batch if the request could join it, otherwise starts a new one.
+  Batch& BatchForOps(const std::vector<std::string>& keys, CoarseTimePoint deadline)
+      REQUIRES(mutex_) {
+    if (!pending_.empty() && CanJoin(*pending_.back(), keys, deadline)) {
+      return *pending_.back();
+    }
+    auto batch = std::make_shared<Batch>();
+    batch->session = std::make_shared<client::YBSession>(client_future_.get(), clock_);
+    batch->session->set_allow_local_calls_in_curr_thread(false);
+    pending_.push_back(std::move(batch));
+    return *pending_.back();
+  }
+
+  bool CanJoin(
+      const Batch& batch, const std::vector<std::string>& keys, CoarseTimePoint deadline) {
+    if (batch.num_ops + keys.size() > FLAGS_ysql_coalesce_writes_max_batch_ops) {
+      return false;
+    }
+    // Joining must not shorten the deadline of requests that are already in the batch, and the
+    // deadline of the joining request is shortened by no more than the allowed skew.
+    if (deadline < batch.deadline ||
+        deadline > batch.deadline + FLAGS_ysql_coalesce_writes_max_deadline_skew_ms * 1ms) {
+      return false;
+    }
+    // Multiple operations on the same row in one write RPC don't see the results of each other on
+    // DocDB side, so a duplicate key or a conflict between them would not be detected.
+    for (const auto& key : keys) {
+      if (batch.keys.count(key)) {
+        IncrementCounter(key_conflicts_);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  BatchPtr PopBatch() REQUIRES(mutex_) {
+    auto result = std::move(pending_.front());
+    pending_.pop_front();
+    return result;
+  }
+
+  void Flush(BatchPtr batch) {
+    VLOG(3) << "Flushing coalesced batch of " << batch->num_ops << " ops from "
+            << batch->callbacks.size() << " requests";
+    IncrementCounter(batches_);
+    IncrementCounterBy(requests_, batch->callbacks.size());
+    IncrementCounterBy(ops_, batch->num_ops);
+    auto* session = batch->session.get();
+    session->SetDeadline(batch->deadline);
+    session->FlushAsync([this, batch = std::move(batch)](client::FlushStatus* flush_status) {
+      FlushDone(*batch, flush_status);
+    });
+  }
+
+  void FlushDone(const Batch& batch, client::FlushStatus* flush_status) {
+    // If flush failed without per op errors, all requests are failed with the same status.
+    const auto fail_all = !flush_status->status.ok() && flush_status->errors.empty();
+    std::vector<client::FlushStatus> statuses(batch.callbacks.size());
+    for (auto& error : flush_status->errors) {
+      auto it = batch.op_to_waiter.find(&error->failed_op());
+      if (it == batch.op_to_waiter.end()) {
+        LOG(DFATAL) << "Error for unknown op in coalesced batch: " << error->status();
+        continue;
+      }
+      statuses[it->second].errors.push_back(std::move(error));
+    }
+    // Requests without failed ops are reported as successful. The remaining ones get the original
+    // flush status, so it is combined with the per op errors the same way as for a regular flush.
+    for (auto& status : statuses) {
+      if (fail_all || !status.errors.empty()) {
+        status.status = flush_status->status;
+      }
+    }
+
+    BatchPtr next_batch;
+    bool all_done = false;
+    {
+      std::lock_guard lock(mutex_);
+      if (pending_.empty()) {
+        all_done = --in_flight_batches_ == 0;
+      } else {
+        next_batch = PopBatch();
+      }
+    }
+    if (next_batch) {
+      Flush(std::move(next_batch));
+    } else if (all_done) {
+      flush_done_cond_.notify_all();
+    }
+
+    for (size_t i = 0; i != statuses.size(); ++i) {
+      batch.callbacks[i](&statuses[i]);
+    }
+  }
+
+  const std::shared_future<client::YBClient*> client_future_;
+  const scoped_refptr<ClockBase> clock_;
+
+  std::mutex mutex_;
+  std::condition_variable flush_done_cond_;
+  bool shutting_down_ GUARDED_BY(mutex_) = false;
+  size_t in_flight_batches_ GUARDED_BY(mutex_) = 0;
+  std::deque<BatchPtr> pending_ GUARDED_BY(mutex_);
+
+  scoped_refptr<Counter> batches_;
+  scoped_refptr<Counter> requests_;
+  scoped_refptr<Counter> ops_;
+  scoped_refptr<Counter> key_conflicts_;
+};
+
+PgWriteCoalescer::PgWriteCoalescer(
+    std::shared_future<client::YBClient*> client_future, const scoped_refptr<ClockBase>& clock,
+    MetricEntity* metric_entity)
+    : impl_(new Impl(std::move(client_future), clock, metric_entity)) {
+}
+
+PgWriteCoalescer::~PgWriteCoalescer() = default;
+
+bool PgWriteCoalescer::IsEnabled() {
+  return GetAtomicFlag(&FLAGS_ysql_coalesce_single_shard_writes);
+}
+
+bool PgWriteCoalescer::Submit(const Operations& ops, CoarseTimePoint deadline, Callback callback) {
+  return impl_->Submit(ops, deadline, std::move(callback));
+}
+
+void PgWriteCoalescer::Shutdown() {
+  impl_->Shutdown();
+}
+
+} // namespace tserver
+} // namespace yb
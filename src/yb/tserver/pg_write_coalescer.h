@@ -0,0 +1,77 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/common_fwd.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/tserver/tserver_fwd.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+class MetricEntity;
+
+namespace tserver {
+
+// Coalesces single shard non transactional writes that arrive concurrently from different
+// PG client sessions into a shared YBSession. Writes to the same tablet are then sent in one write
+// RPC and replicated in one Raft round.
+//
+// Up to ysql_coalesce_writes_max_in_flight_batches batches are flushed concurrently, writes that
+// arrive while this limit is reached are accumulated into pending batches, that are flushed in FIFO
+// order. Same as PgOperationBuffer, a batch never contains two writes to the same row, so each of
+// them is checked for duplicate keys and conflicts on its own. A write for a row that is already
+// in the pending batch starts a new one.
+//
+// A batch is flushed with the earliest deadline of its writes, and a write joins a pending batch
+// only when its own deadline is at most ysql_coalesce_writes_max_deadline_skew_ms later than that.
+// So no caller waits past its own deadline, and a slow caller does not extend the deadline of the
+// others.
+class PgWriteCoalescer {
+ public:
+  using Operations = std::vector<std::shared_ptr<client::YBPgsqlOp>>;
+  using Callback = std::function<void(client::FlushStatus*)>;
+
+  PgWriteCoalescer(
+      std::shared_future<client::YBClient*> client_future, const scoped_refptr<ClockBase>& clock,
+      MetricEntity* metric_entity);
+  ~PgWriteCoalescer();
+
+  // Whether write coalescing is enabled.
+  static bool IsEnabled();
+
+  // Adds ops to the pending batch. The callback is invoked once the batch is flushed, flush status
+  // passed to it contains only errors related to the submitted ops.
+  // Returns false if the ops were not accepted, in this case caller should flush them on its own.
+  bool Submit(const Operations& ops, CoarseTimePoint deadline, Callback callback);
+
+  void Shutdown();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tserver
+} // namespace yb
@@ -329,7 +329,15 @@ Status ReadQuery::DoPerform() {
   read_time_ = ReadHybridTime::FromReadTimePB(*req_);
 
   allow_retry_ = !read_time_;
-  require_lease_ = tablet::RequireLease(req_->consistency_level() == YBConsistencyLevel::STRONG);
+  const bool strong_read = req_->consistency_level() == YBConsistencyLevel::STRONG;
+  // Strong read at a follower is allowed only under a read lease granted by the leader, and only
+  // for non transactional reads, since intents are resolved by the leader.
+  if (strong_read && reading_from_non_leader_ &&
+      (req_->has_transaction() || !tablet_peer->CanServeStrongReadAsFollower())) {
+    RETURN_NOT_OK(CheckPeerIsLeader(*tablet_peer));
+    reading_from_non_leader_ = false;
+  }
+  require_lease_ = tablet::RequireLease(strong_read && !reading_from_non_leader_);
   // TODO: should check all the tables referenced by the requests to decide if it is transactional.
   const bool transactional = this->transactional();
   // Should not pick read time for serializable isolation, since it is picked after read intents
@@ -14,6 +14,8 @@
 #include "yb/tserver/remote_bootstrap_file_downloader.h"
 
 #include <iomanip>
+#include <unordered_set>
+#include <vector>
 
 #include "yb/common/wire_protocol.h"
 
@@ -29,9 +31,11 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/thread.h"
 
 using namespace yb::size_literals;
 
@@ -51,6 +55,28 @@ DEFINE_UNKNOWN_int32(bytes_remote_bootstrap_durable_write_mb, 1024,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
 
+DEFINE_RUNTIME_uint32(remote_bootstrap_max_concurrent_file_downloads, 1,
+             "Max number of RocksDB files downloaded at the same time by a single remote "
+             "bootstrap session. The receive rate limit of the session is split between them. "
+             "Values above 1 require the source to serve concurrent fetches of the same session.");
+
+DEFINE_RUNTIME_uint32(remote_bootstrap_fetch_data_max_attempts, 5,
+             "Max number of attempts to fetch a single chunk during remote bootstrap. Fetches that "
+             "failed because of network errors or timeouts are retried at the same offset, so "
+             "the file download continues instead of failing the whole remote bootstrap.");
+
+DEFINE_RUNTIME_uint32(remote_bootstrap_fetch_data_retry_delay_ms, 500,
+             "Delay before retrying a failed chunk fetch during remote bootstrap, multiplied by "
+             "the number of the attempt.");
+
+DEFINE_RUNTIME_bool(remote_bootstrap_link_local_files, false,
+             "When the remote bootstrap source is on the same host and file system, RocksDB files "
+             "are hard linked or reflinked from its checkpoint instead of being downloaded.");
+
+DEFINE_test_flag(uint32, fail_remote_bootstrap_fetch_data_attempts, 0,
+                 "Number of first attempts to fetch each chunk during remote bootstrap that fail "
+                 "with a network error instead of sending the request.");
+
 // RETURN_NOT_OK_PREPEND() with a remote-error unwinding step.
 #define RETURN_NOT_OK_UNWIND_PREPEND(status, controller, msg) \
   RETURN_NOT_OK_PREPEND(UnwindRemoteError(status, controller), msg)
@@ -102,16 +128,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string linked_file;
+    {
+      std::lock_guard lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        linked_file = it->second;
+      }
+    }
+    if (!linked_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << linked_file;
+      auto link_status = env().LinkFile(linked_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << linked_file
                              << ": " << link_status;
     }
   }
@@ -120,22 +153,146 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     LOG(INFO) << file_path << " already exists and will be replaced";
     RETURN_NOT_OK(env().DeleteFile(file_path));
   }
-  std::unique_ptr<WritableFile> file;
-  RETURN_NOT_OK(env().NewWritableFile(file_path, &file));
 
-  data_id->set_file_name(file_pb.name());
-  RETURN_NOT_OK_PREPEND(DownloadFile(*data_id, file.get()),
-                        Format("Unable to download $0 file $1",
-                               DataIdPB::IdType_Name(data_id->type()), file_path));
-  VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
+  if (data_id->type() == DataIdPB::ROCKSDB_FILE && CopyLocalFile(file_pb, file_path)) {
+    num_local_files_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    std::unique_ptr<WritableFile> file;
+    RETURN_NOT_OK(env().NewWritableFile(file_path, &file));
+
+    data_id->set_file_name(file_pb.name());
+    RETURN_NOT_OK_PREPEND(DownloadFile(*data_id, file.get()),
+                          Format("Unable to download $0 file $1",
+                                 DataIdPB::IdType_Name(data_id->type()), file_path));
+    VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
+  }
 
   if (file_pb.inode() != 0) {
+    std::lock_guard lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
   return Status::OK();
 }
 
+bool RemoteBootstrapFileDownloader::CopyLocalFile(
+    const tablet::FilePB& file_pb, const std::string& file_path) {
+  if (source_checkpoint_dir_.empty() || file_pb.inode() == 0 ||
+      !FLAGS_remote_bootstrap_link_local_files) {
+    return false;
+  }
+  // The checkpoint path is unique per session, and the same device, inode and size make sure that
+  // it is the very file the source is going to send, not a file that happens to have the same path.
+  const auto source_path = JoinPathSegments(source_checkpoint_dir_, file_pb.name());
+  auto device_id = env().GetFileDeviceId(source_path);
+  if (!device_id.ok() || *device_id != source_checkpoint_device_id_) {
+    return false;
+  }
+  auto inode = env().GetFileINode(source_path);
+  if (!inode.ok() || *inode != file_pb.inode()) {
+    return false;
+  }
+  auto size = env().GetFileSize(source_path);
+  if (!size.ok() || *size != file_pb.size_bytes()) {
+    return false;
+  }
+
+  // SST files are immutable, so sharing the data with the source is safe.
+  auto status = env().LinkFile(source_path, file_path);
+  if (status.ok()) {
+    VLOG_WITH_PREFIX(2) << "Linked local file " << source_path << " => " << file_path;
+    return true;
+  }
+  VLOG_WITH_PREFIX(1) << "Failed to link local file " << source_path << ": " << status;
+  status = env().CloneFile(source_path, file_path);
+  if (status.ok()) {
+    VLOG_WITH_PREFIX(2) << "Cloned local file " << source_path << " => " << file_path;
+    return true;
+  }
+  VLOG_WITH_PREFIX(1) << "Failed to clone local file " << source_path << ": " << status;
+  return false;
+}
+
+Status RemoteBootstrapFileDownloader::DownloadFiles(
+    const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+    DataIdPB::IdType type) {
+  // Files sharing an inode are postponed, so they are linked to the downloaded copy later.
+  std::vector<const tablet::FilePB*> files_to_download;
+  std::vector<const tablet::FilePB*> postponed_files;
+  std::unordered_set<uint64_t> inodes;
+  for (const auto& file_pb : files) {
+    if (file_pb.inode() == 0 || inodes.insert(file_pb.inode()).second) {
+      files_to_download.push_back(&file_pb);
+    } else {
+      postponed_files.push_back(&file_pb);
+    }
+  }
+
+  std::atomic<size_t> next_file_idx{0};
+  std::mutex status_mutex;
+  Status status;
+  auto download_files = [this, &files_to_download, &next_file_idx, &status_mutex, &status, &dir,
+                         type] {
+    DataIdPB data_id;
+    data_id.set_type(type);
+    for (;;) {
+      const auto idx = next_file_idx.fetch_add(1, std::memory_order_acq_rel);
+      if (idx >= files_to_download.size()) {
+        return;
+      }
+      const auto& file_pb = *files_to_download[idx];
+      const auto start = MonoTime::Now();
+      auto file_status = DownloadFile(file_pb, dir, &data_id);
+      if (!file_status.ok()) {
+        // Let other workers stop after their current file.
+        next_file_idx.store(files_to_download.size(), std::memory_order_release);
+        std::lock_guard lock(status_mutex);
+        if (status.ok()) {
+          status = std::move(file_status);
+        }
+        return;
+      }
+      LOG_WITH_PREFIX(INFO)
+          << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
+          << " in " << (MonoTime::Now() - start).ToSeconds() << " seconds";
+    }
+  };
+
+  const auto num_threads = std::min<size_t>(
+      std::max<uint32_t>(FLAGS_remote_bootstrap_max_concurrent_file_downloads, 1),
+      files_to_download.size());
+  std::vector<scoped_refptr<Thread>> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    scoped_refptr<Thread> thread;
+    auto create_status = Thread::Create(
+        "remote_bootstrap", "rbs-download", download_files, &thread);
+    if (!create_status.ok()) {
+      // Files are still downloaded by already started threads and by the current one.
+      LOG_WITH_PREFIX(WARNING) << "Failed to start download thread: " << create_status;
+      break;
+    }
+    threads.push_back(std::move(thread));
+  }
+  download_files();
+  for (auto& thread : threads) {
+    CHECK_OK(ThreadJoiner(thread.get()).Join());
+  }
+  RETURN_NOT_OK(status);
+
+  DataIdPB data_id;
+  data_id.set_type(type);
+  for (const auto* file_pb : postponed_files) {
+    RETURN_NOT_OK(DownloadFile(*file_pb, dir, &data_id));
+  }
+
+  const auto num_local_files = num_local_files_.exchange(0, std::memory_order_relaxed);
+  if (num_local_files) {
+    LOG_WITH_PREFIX(INFO) << "Linked " << num_local_files << " of " << files.size()
+                          << " files from local checkpoint " << source_checkpoint_dir_;
+  }
+  return Status::OK();
+}
+
 template<class Appendable>
 Status RemoteBootstrapFileDownloader::DownloadFile(
     const DataIdPB& data_id, Appendable* appendable) {
@@ -149,8 +306,13 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
 
   std::unique_ptr<RateLimiter> rate_limiter;
 
+  active_downloads_.fetch_add(1, std::memory_order_acq_rel);
+  auto se = ScopeExit([this] {
+    active_downloads_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
+    auto rate_updater = [this]() {
       auto remote_bootstrap_clients_started =
           remote_bootstrap_clients_started_.load(std::memory_order_acquire);
       if (remote_bootstrap_clients_started < 1) {
@@ -158,8 +320,11 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
                                    << remote_bootstrap_clients_started;
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
+      // Concurrent downloads of the same session share its part of the rate.
+      const auto active_downloads = std::max(active_downloads_.load(std::memory_order_acquire), 1);
       return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started /
+          active_downloads);
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -168,8 +333,6 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     rate_limiter = std::make_unique<RateLimiter>();
   }
 
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
   FetchDataRequestPB req;
   Stopwatch verify_data_timer;
   Stopwatch append_data_timer;
@@ -180,7 +343,6 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
 
   bool done = false;
   while (!done) {
-    controller.Reset();
     req.set_session_id(session_id_);
     req.mutable_data_id()->CopyFrom(data_id);
     req.set_offset(offset);
@@ -194,10 +356,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     req.set_max_length(max_length);
 
     FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
+    RETURN_NOT_OK(FetchChunk(req, &resp, rate_limiter.get()));
     DCHECK_LE(resp.chunk().data().size(), max_length);
     iterations++;
 
@@ -254,6 +413,36 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   return Status::OK();
 }
 
+Status RemoteBootstrapFileDownloader::FetchChunk(
+    const FetchDataRequestPB& req, FetchDataResponsePB* resp, RateLimiter* rate_limiter) {
+  rpc::RpcController controller;
+  for (uint32_t attempt = 1;; ++attempt) {
+    controller.Reset();
+    controller.set_timeout(session_idle_timeout_);
+    resp->Clear();
+    auto status = rate_limiter->SendOrReceiveData([this, &req, resp, &controller, attempt]() {
+      if (PREDICT_FALSE(attempt <= FLAGS_TEST_fail_remote_bootstrap_fetch_data_attempts)) {
+        return STATUS_FORMAT(NetworkError, "Injected fetch data failure, attempt $0", attempt);
+      }
+      return proxy_->FetchData(req, resp, &controller);
+    }, [resp]() { return resp->ByteSize(); });
+    if (status.ok()) {
+      return Status::OK();
+    }
+    // Errors reported by the remote service, like unknown session, would not go away on retry.
+    const auto retriable =
+        status.IsNetworkError() || status.IsTimedOut() || status.IsServiceUnavailable();
+    if (!retriable || attempt >= FLAGS_remote_bootstrap_fetch_data_max_attempts) {
+      RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
+    }
+    LOG_WITH_PREFIX(WARNING)
+        << "Failed to fetch " << req.data_id().ShortDebugString() << " at offset "
+        << req.offset() << ", attempt " << attempt << ": " << status;
+    SleepFor(MonoDelta::FromMilliseconds(
+        FLAGS_remote_bootstrap_fetch_data_retry_delay_ms * attempt));
+  }
+}
+
 Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
@@ -13,10 +13,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/metadata.pb.h"
@@ -31,6 +35,7 @@ namespace yb {
 class Env;
 class FsManager;
 class MonoDelta;
+class RateLimiter;
 
 namespace tserver {
 
@@ -44,9 +49,24 @@ class RemoteBootstrapFileDownloader {
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
       MonoDelta session_idle_timeout);
 
+  // Directory the source serves RocksDB files from and the id of its device. When it is accessible
+  // on the local file system, RocksDB files are hard linked or reflinked from it instead of being
+  // downloaded.
+  void SetSourceCheckpointDir(std::string dir, uint64_t device_id) {
+    source_checkpoint_dir_ = std::move(dir);
+    source_checkpoint_device_id_ = device_id;
+  }
+
   Status DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
+  // Downloads the specified files to dir, fetching up to
+  // remote_bootstrap_max_concurrent_file_downloads files at the same time.
+  // Files that share an inode on the source are downloaded once and hard linked.
+  Status DownloadFiles(
+      const google::protobuf::RepeatedPtrField<tablet::FilePB>& files, const std::string& dir,
+      DataIdPB::IdType type);
+
   // Download a single remote file. The block and WAL implementations delegate
   // to this method when downloading files.
   //
@@ -68,6 +88,14 @@ class RemoteBootstrapFileDownloader {
  private:
   Status VerifyData(uint64_t offset, const DataChunkPB& resp);
 
+  // Tries to create file_path as a hard link or reflink of the same RocksDB file in the source
+  // checkpoint directory. Returns false if the source file is not accessible locally.
+  bool CopyLocalFile(const tablet::FilePB& file_pb, const std::string& file_path);
+
+  // Fetches a single chunk, retrying transient failures of the same request.
+  Status FetchChunk(
+      const FetchDataRequestPB& req, FetchDataResponsePB* resp, RateLimiter* rate_limiter);
+
   const std::string& LogPrefix() const {
     return log_prefix_;
   }
@@ -80,7 +108,15 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  std::string source_checkpoint_dir_;
+  uint64_t source_checkpoint_device_id_ = 0;
+  std::atomic<size_t> num_local_files_{0};
+
+  // Number of files currently being downloaded, the receive rate is split between them.
+  std::atomic<int> active_downloads_{0};
+
+  std::mutex inode2file_mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(inode2file_mutex_);
 };
 
 Status UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
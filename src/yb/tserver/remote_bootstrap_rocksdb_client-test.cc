@@ -19,6 +19,12 @@
 
 using std::vector;
 
+DECLARE_bool(remote_bootstrap_link_local_files);
+DECLARE_uint32(TEST_fail_remote_bootstrap_fetch_data_attempts);
+DECLARE_uint32(remote_bootstrap_fetch_data_max_attempts);
+DECLARE_uint32(remote_bootstrap_fetch_data_retry_delay_ms);
+DECLARE_uint32(remote_bootstrap_max_concurrent_file_downloads);
+
 namespace yb {
 namespace tserver {
 
@@ -27,6 +33,51 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  void TestDownloadRocksDBFiles(bool expect_links = false) {
+    TabletStatusListener listener(meta_);
+    ASSERT_OK(client_->FetchAll(&listener));
+    auto tablet_peer_checkpoint_dir =
+        tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
+
+    vector<std::string> rocksdb_files;
+    LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
+    ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
+
+    vector<std::string> tablet_peer_checkpoint_files;
+    ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(
+        tablet_peer_checkpoint_dir, &tablet_peer_checkpoint_files));
+
+    std::sort(rocksdb_files.begin(), rocksdb_files.end());
+    std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
+
+    ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
+        << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
+
+    // Verify that the client has the same files that the leader has.
+    for (size_t i = 0; i < rocksdb_files.size(); ++i) {
+      auto local_rocksdb_file = rocksdb_files[i];
+      auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
+      ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+
+      if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
+        continue;
+      }
+
+      auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
+      auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
+                                                            tablet_peer_rocksdb_file);
+
+      LOG(INFO) << "Comparing file " << local_rocksdb_file_path
+                << " and file " << tablet_peer_rocksdb_file_path;
+      ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
+      auto* env = fs_manager_->env();
+      auto local_inode = ASSERT_RESULT(env->GetFileINode(local_rocksdb_file_path));
+      auto tablet_peer_inode = ASSERT_RESULT(env->GetFileINode(tablet_peer_rocksdb_file_path));
+      ASSERT_EQ(expect_links, local_inode == tablet_peer_inode) << local_rocksdb_file;
+    }
+  }
 };
 
 // Basic begin / end remote bootstrap session.
@@ -38,43 +89,35 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
 
 // Basic RocksDB files download unit test.
 TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
-  TabletStatusListener listener(meta_);
-  ASSERT_OK(client_->FetchAll(&listener));
-  auto tablet_peer_checkpoint_dir =
-      tablet_peer_->tablet()->snapshots().TEST_LastRocksDBCheckpointDir();
-
-  vector<std::string> rocksdb_files;
-  LOG(INFO) << "RocksDB dir: " << meta_->rocksdb_dir();
-  ASSERT_OK(fs_manager_->ListDir(meta_->rocksdb_dir(), &rocksdb_files));
-
-  vector<std::string> tablet_peer_checkpoint_files;
-  ASSERT_OK(tablet_peer_->tablet_metadata()->fs_manager()->ListDir(tablet_peer_checkpoint_dir,
-                                                                   &tablet_peer_checkpoint_files));
-
-  std::sort(rocksdb_files.begin(), rocksdb_files.end());
-  std::sort(tablet_peer_checkpoint_files.begin(), tablet_peer_checkpoint_files.end());
-
-  ASSERT_EQ(rocksdb_files.size(), tablet_peer_checkpoint_files.size())
-      << AsString(rocksdb_files) << " vs " << AsString(tablet_peer_checkpoint_files);
+  TestDownloadRocksDBFiles();
+}
 
-  // Verify that the client has the same files that the leader has.
-  for (size_t i = 0; i < rocksdb_files.size(); ++i) {
-    auto local_rocksdb_file = rocksdb_files[i];
-    auto tablet_peer_rocksdb_file = tablet_peer_checkpoint_files[i];
-    ASSERT_EQ(local_rocksdb_file, tablet_peer_rocksdb_file);
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesConcurrently) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_remote_bootstrap_max_concurrent_file_downloads) = 4;
+  TestDownloadRocksDBFiles();
+}
 
-    if (local_rocksdb_file == "." || local_rocksdb_file == "..") {
-      continue;
-    }
+// Failed chunk fetches are retried at the same offset.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestRetryFetchData) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_remote_bootstrap_fetch_data_retry_delay_ms) = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_fail_remote_bootstrap_fetch_data_attempts) =
+      FLAGS_remote_bootstrap_fetch_data_max_attempts - 1;
+  TestDownloadRocksDBFiles();
+}
 
-    auto local_rocksdb_file_path = JoinPathSegments(meta_->rocksdb_dir(), local_rocksdb_file);
-    auto tablet_peer_rocksdb_file_path = JoinPathSegments(tablet_peer_checkpoint_dir,
-                                                          tablet_peer_rocksdb_file);
+TEST_F(RemoteBootstrapRocksDBClientTest, TestRetryFetchDataExhausted) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_remote_bootstrap_fetch_data_retry_delay_ms) = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_fail_remote_bootstrap_fetch_data_attempts) =
+      FLAGS_remote_bootstrap_fetch_data_max_attempts;
+  TabletStatusListener listener(meta_);
+  auto status = client_->FetchAll(&listener);
+  ASSERT_TRUE(status.IsNetworkError()) << status;
+}
 
-    LOG(INFO) << "Comparing file " << local_rocksdb_file_path
-              << " and file " << tablet_peer_rocksdb_file_path;
-    ASSERT_OK(CompareFileContents(local_rocksdb_file_path, tablet_peer_rocksdb_file_path));
-  }
+// Source and destination share the file system, so files are hard linked from the checkpoint.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestLinkLocalRocksDBFiles) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_remote_bootstrap_link_local_files) = true;
+  TestDownloadRocksDBFiles(/* expect_links= */ true);
 }
 
 } // namespace tserver
@@ -50,6 +50,7 @@
 
 #include "yb/rpc/rpc_context.h"
 
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/tablet_peer_lookup.h"
@@ -194,6 +195,14 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   RPC_RETURN_NOT_OK(tablet_peer->CheckRunning(),
                     RemoteBootstrapErrorPB::TABLET_NOT_FOUND,
                     Substitute("Tablet is not running yet: $0", tablet_id));
+  // Witness does not apply operations to RocksDB, so it could not be a remote bootstrap source.
+  auto tablet = tablet_peer->shared_tablet();
+  if (tablet && tablet->witness()) {
+    RPC_RETURN_APP_ERROR(
+        RemoteBootstrapErrorPB::INVALID_REMOTE_BOOTSTRAP_REQUEST,
+        Substitute("Tablet replica is a witness: $0", tablet_id),
+        STATUS(IllegalState, "Witness replica could not be a remote bootstrap source"));
+  }
 
   scoped_refptr<RemoteBootstrapSession> session;
   {
@@ -230,6 +239,13 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   resp->set_session_idle_timeout_millis(FLAGS_remote_bootstrap_idle_timeout_ms);
   resp->mutable_superblock()->CopyFrom(session->tablet_superblock());
   resp->mutable_initial_committed_cstate()->CopyFrom(session->initial_committed_cstate());
+  if (!session->checkpoint_dir().empty()) {
+    auto device_id = fs_manager_->env()->GetFileDeviceId(session->checkpoint_dir());
+    if (device_id.ok()) {
+      resp->set_checkpoint_dir(session->checkpoint_dir());
+      resp->set_checkpoint_dir_device_id(*device_id);
+    }
+  }
 
   auto const& log_segments = session->log_segments();
   resp->mutable_deprecated_wal_segment_seqnos()->Reserve(narrow_cast<int>(log_segments.size()));
@@ -287,11 +303,15 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
     session = it->second.session;
   }
 
-  session->EnsureRateLimiterIsInitialized();
+  int64_t rate_limit;
+  {
+    std::lock_guard lock(session->fetch_mutex());
+    session->EnsureRateLimiterIsInitialized();
+    rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  }
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
@@ -304,15 +324,24 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(ValidateFetchRequestDataId(data_id, &info.error_code, session),
                     info.error_code, "Invalid DataId");
 
-  session->data_read_timer().resume();
+  auto start = MonoTime::Now();
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
-  session->data_read_timer().stop();
+  auto data_read_time = MonoTime::Now() - start;
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
-  session->crc_compute_timer().resume();
+  MonoDelta rate_limiter_sleep_time;
+  {
+    std::lock_guard lock(session->fetch_mutex());
+    rate_limiter_sleep_time = session->rate_limiter().UpdateDataSize(info.data.size());
+  }
+  // Sleep outside of the lock, so concurrent fetches of the same session are not serialized.
+  SleepFor(rate_limiter_sleep_time);
+  start = MonoTime::Now();
   uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
-  session->crc_compute_timer().stop();
+  {
+    std::lock_guard lock(session->fetch_mutex());
+    session->AddFetchTimes(data_read_time, MonoTime::Now() - start);
+  }
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
   *data_chunk->mutable_data() = std::move(info.data);
@@ -448,17 +477,21 @@ Status RemoteBootstrapServiceImpl::DoEndRemoteBootstrapSession(
     if(!session->Succeeded()) {
       session->SetSuccess();
 
+      std::lock_guard lock(session->fetch_mutex());
       const auto total_bytes = session->rate_limiter().total_bytes();
+      const auto data_read_ms = std::max<int64_t>(session->data_read_time().ToMilliseconds(), 1);
+      const auto crc_compute_ms =
+          std::max<int64_t>(session->crc_compute_time().ToMilliseconds(), 1);
       LOG(INFO) << std::fixed << std::setprecision(3) << "Remote bootstrap session with id "
         << session_id << " completed. Stats: Transmission rate: "
         << session->rate_limiter().GetRate() << ", RateLimiter total time slept: "
         << session->rate_limiter().total_time_slept() << ", Total bytes: "
         << total_bytes << ", Read rate "
-        << (total_bytes / session->data_read_timer().elapsed().wall_millis())
-        << " bytes/msec (Total ms: " << session->data_read_timer().elapsed().wall_millis()
+        << (total_bytes / data_read_ms)
+        << " bytes/msec (Total ms: " << data_read_ms
         << "), CRC computation rate: "
-        << (total_bytes / session->crc_compute_timer().elapsed().wall_millis()) << " bytes/msec"
-        << "(Total ms: " << session->crc_compute_timer().elapsed().wall_millis() << ")";
+        << (total_bytes / crc_compute_ms) << " bytes/msec"
+        << "(Total ms: " << crc_compute_ms << ")";
     }
 
     if (PREDICT_FALSE(FLAGS_TEST_inject_latency_before_change_role_secs)) {
@@ -127,6 +127,8 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   const log::SegmentSequence& log_segments() const { return log_segments_; }
 
+  const std::string& checkpoint_dir() const { return checkpoint_dir_; }
+
   void SetSuccess();
 
   bool Succeeded();
@@ -138,10 +140,19 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   void EnsureRateLimiterIsInitialized();
 
+  // Should be held while using rate_limiter() or updating fetch stats, since a client could fetch
+  // several files of the session concurrently.
+  std::mutex& fetch_mutex() { return fetch_mutex_; }
+
   RateLimiter& rate_limiter() { return rate_limiter_; }
 
-  Stopwatch& crc_compute_timer() { return crc_compute_timer_; }
-  Stopwatch& data_read_timer() { return data_read_timer_; }
+  void AddFetchTimes(MonoDelta data_read_time, MonoDelta crc_compute_time) {
+    data_read_time_ += data_read_time;
+    crc_compute_time_ += crc_compute_time;
+  }
+
+  MonoDelta crc_compute_time() { return crc_compute_time_; }
+  MonoDelta data_read_time() { return data_read_time_; }
 
   static const std::string kCheckpointsDir;
 
@@ -229,9 +240,12 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
-  // Stopwatch to capture the latency of different operations
-  Stopwatch crc_compute_timer_;
-  Stopwatch data_read_timer_;
+  // Protects fetch stats and rate_limiter_.
+  std::mutex fetch_mutex_;
+
+  // Total latency of different operations.
+  MonoDelta crc_compute_time_ = MonoDelta::kZero;
+  MonoDelta data_read_time_ = MonoDelta::kZero;
 
   // Used to limit the transmission rate.
   RateLimiter rate_limiter_;
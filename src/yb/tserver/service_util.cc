@@ -62,6 +62,12 @@ DEFINE_RUNTIME_uint64(min_rejection_delay_ms, 100,
 DEFINE_RUNTIME_uint64(max_rejection_delay_ms, 5000,
     "Maximal delay for rejected write to be retried in milliseconds.");
 
+DEFINE_RUNTIME_AUTO_bool(send_leader_hint_on_not_the_leader, kLocalVolatile, false, true,
+    "When a request that requires the leader is rejected by a follower, include the uuid of the "
+    "leader known to the follower, so the client could update its tablet locations cache and "
+    "retry on the leader right away. Clients that predate the leader hint error code do not "
+    "understand it, so it is only sent once all processes in the universe are upgraded.");
+
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
 namespace yb {
@@ -69,6 +75,17 @@ namespace tserver {
 
 namespace {
 
+Status AddLeaderHint(const consensus::Consensus& consensus, const Status& status) {
+  if (!GetAtomicFlag(&FLAGS_send_leader_hint_on_not_the_leader)) {
+    return status;
+  }
+  auto cstate = consensus.ConsensusState(consensus::CONSENSUS_CONFIG_ACTIVE);
+  if (cstate.leader_uuid().empty() || cstate.leader_uuid() == consensus.peer_uuid()) {
+    return status;
+  }
+  return status.CloneAndAddErrorCode(TabletServerLeaderHint(cstate.leader_uuid()));
+}
+
 template <class PB>
 void DoSetupErrorAndRespond(PB* error,
                             const Status& s,
@@ -165,7 +182,10 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     typedef consensus::LeaderStatus LeaderStatus;
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
-      case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
+      case LeaderStatus::NOT_LEADER:
+        return AddLeaderHint(
+            *consensus,
+            status.CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::NOT_THE_LEADER)));
       case LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE:
         // We are returning a NotTheLeader as opposed to LeaderNotReady, because there is a chance
         // that we're a partitioned-away leader, and the client needs to do another leader lookup.
@@ -334,13 +354,21 @@ Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
                     "consistency level is invalid: YBConsistencyLevel::STRONG";
     }
 
-    RETURN_NOT_OK(CheckPeerIsLeader(*tablet_peer));
+    auto s = CheckPeerIsLeader(*tablet_peer);
+    // A follower holding a read lease granted by the leader is allowed to serve strong reads.
+    if (!s.ok() && !tablet_peer->CanServeStrongReadAsFollower()) {
+      return s;
+    }
   } else {
     auto s = CheckPeerIsLeader(*tablet_peer.get());
 
     // Peer is not the leader, so check that the time since it last heard from the leader is less
     // than FLAGS_max_stale_read_bound_time_ms.
     if (PREDICT_FALSE(!s.ok())) {
+      if (tablet_ptr && tablet_ptr->witness()) {
+        return STATUS(IllegalState, "Witness replica does not serve reads",
+                      TabletServerError(TabletServerErrorPB::STALE_FOLLOWER));
+      }
       if (FLAGS_max_stale_read_bound_time_ms > 0) {
         auto consensus = tablet_peer->shared_consensus();
         // TODO(hector): This safe time could be reused by the read operation.
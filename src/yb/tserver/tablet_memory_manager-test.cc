@@ -0,0 +1,105 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tserver/tablet_memory_manager.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/test_util.h"
+
+DECLARE_bool(enable_memory_arbiter);
+DECLARE_uint32(memory_arbiter_step_percentage);
+DECLARE_uint32(memory_arbiter_min_share_percentage);
+DECLARE_uint64(memory_arbiter_min_block_cache_lookups);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+constexpr size_t kBlockCacheSize = 1000;
+constexpr size_t kMemstoreSize = 1000;
+const MemoryArbiterSizes kConfigured { .block_cache = kBlockCacheSize, .memstore = kMemstoreSize };
+
+// Full block cache with 50% miss ratio.
+MemoryArbiterStats BlockCachePressure(const MemoryArbiterSizes& sizes) {
+  return MemoryArbiterStats {
+    .block_cache_usage = sizes.block_cache,
+    .block_cache_hits = 1000,
+    .block_cache_misses = 1000,
+  };
+}
+
+MemoryArbiterStats MemstorePressure() {
+  return MemoryArbiterStats { .memstore_limit_flushes = 1 };
+}
+
+} // namespace
+
+class MemoryArbiterTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_memory_arbiter) = true;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_memory_arbiter_step_percentage) = 10;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_memory_arbiter_min_share_percentage) = 50;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_memory_arbiter_min_block_cache_lookups) = 100;
+  }
+};
+
+TEST_F(MemoryArbiterTest, MemstorePressure) {
+  auto sizes = kConfigured;
+  sizes = RebalanceMemoryArbiterSizes(kConfigured, sizes, MemstorePressure());
+  ASSERT_EQ(sizes, (MemoryArbiterSizes { .block_cache = 800, .memstore = 1200 }));
+
+  // The block cache is not shrunk below its min share.
+  for (int i = 0; i != 5; ++i) {
+    sizes = RebalanceMemoryArbiterSizes(kConfigured, sizes, MemstorePressure());
+  }
+  ASSERT_EQ(sizes, (MemoryArbiterSizes { .block_cache = 500, .memstore = 1500 }));
+}
+
+TEST_F(MemoryArbiterTest, BlockCachePressure) {
+  auto sizes = kConfigured;
+  sizes = RebalanceMemoryArbiterSizes(kConfigured, sizes, BlockCachePressure(sizes));
+  ASSERT_EQ(sizes, (MemoryArbiterSizes { .block_cache = 1200, .memstore = 800 }));
+
+  // Block cache that is not full, or has too few lookups, is not under pressure.
+  auto stats = BlockCachePressure(sizes);
+  stats.block_cache_usage = sizes.block_cache / 2;
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, sizes, stats), sizes);
+  stats = BlockCachePressure(sizes);
+  stats.block_cache_hits = stats.block_cache_misses = 10;
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, sizes, stats), sizes);
+  stats = BlockCachePressure(sizes);
+  stats.block_cache_misses = 0;
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, sizes, stats), sizes);
+}
+
+TEST_F(MemoryArbiterTest, BothUnderPressure) {
+  auto stats = BlockCachePressure(kConfigured);
+  stats.memstore_limit_flushes = 1;
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, kConfigured, stats), kConfigured);
+}
+
+TEST_F(MemoryArbiterTest, Disabled) {
+  const MemoryArbiterSizes current { .block_cache = 600, .memstore = 1400 };
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, current, MemstorePressure()),
+            (MemoryArbiterSizes { .block_cache = 500, .memstore = 1500 }));
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_memory_arbiter) = false;
+  ASSERT_EQ(RebalanceMemoryArbiterSizes(kConfigured, current, MemstorePressure()), kConfigured);
+}
+
+} // namespace tserver
+} // namespace yb
@@ -13,6 +13,8 @@
 
 #include "yb/tserver/tablet_memory_manager.h"
 
+#include <utility>
+
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/raft_consensus.h"
 
@@ -30,6 +32,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
@@ -79,6 +82,47 @@ TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
+DEFINE_RUNTIME_bool(enable_memory_arbiter, false,
+                    "If set, memory is periodically moved between the block cache and the global "
+                    "memstore, depending on which of them is under pressure. The sum of block cache "
+                    "size and global memstore size stays the same. When turned off, the configured "
+                    "sizes are restored.");
+
+DEFINE_NON_RUNTIME_uint32(memory_arbiter_interval_ms, 30000,
+                          "Interval between memory arbiter rebalancing rounds.");
+
+DEFINE_RUNTIME_uint32(memory_arbiter_step_percentage, 5,
+                      "Percentage of the combined block cache and global memstore size moved "
+                      "between them by the memory arbiter in a single round.");
+
+DEFINE_RUNTIME_uint32(memory_arbiter_min_share_percentage, 50,
+                      "The memory arbiter never shrinks the block cache or the global memstore "
+                      "below this percentage of its configured size.");
+
+DEFINE_RUNTIME_double(memory_arbiter_block_cache_miss_ratio_threshold, 0.05,
+                      "Block cache is considered under pressure by the memory arbiter when it is "
+                      "full and its miss ratio since the previous round is above this value.");
+
+DEFINE_RUNTIME_uint64(memory_arbiter_min_block_cache_lookups, 1000,
+                      "Min number of block cache lookups since the previous round required to "
+                      "evaluate block cache miss ratio.");
+
+METRIC_DECLARE_counter(block_cache_hits);
+METRIC_DECLARE_counter(block_cache_misses);
+
+METRIC_DEFINE_counter(server, memstore_limit_flushes,
+                      "Global Memstore Limit Flushes",
+                      yb::MetricUnit::kRequests,
+                      "Number of tablet flushes forced by reaching the global memstore limit.");
+METRIC_DEFINE_gauge_uint64(server, memory_arbiter_block_cache_capacity,
+                           "Memory Arbiter Block Cache Capacity",
+                           yb::MetricUnit::kBytes,
+                           "Block cache capacity assigned by the memory arbiter.");
+METRIC_DEFINE_gauge_uint64(server, memory_arbiter_memstore_limit,
+                           "Memory Arbiter Global Memstore Limit",
+                           yb::MetricUnit::kBytes,
+                           "Global memstore limit assigned by the memory arbiter.");
+
 namespace yb {
 namespace tserver {
 
@@ -165,16 +209,23 @@ TabletMemoryManager::TabletMemoryManager(
   InitLogCacheGC();
   // Assign background_task_ if necessary.
   ConfigureBackgroundTask(options);
+  InitMemoryArbiter(metrics, options);
 }
 
 Status TabletMemoryManager::Init() {
   if (background_task_) {
     RETURN_NOT_OK(background_task_->Init());
   }
+  if (arbiter_task_) {
+    RETURN_NOT_OK(arbiter_task_->Init());
+  }
   return Status::OK();
 }
 
 void TabletMemoryManager::Shutdown() {
+  if (arbiter_task_) {
+    arbiter_task_->Shutdown();
+  }
   if (background_task_) {
     background_task_->Shutdown();
   }
@@ -241,6 +292,112 @@ void TabletMemoryManager::ConfigureBackgroundTask(tablet::TabletOptions* options
   memory_monitor_ = options->memory_monitor;
 }
 
+void TabletMemoryManager::InitMemoryArbiter(
+    const scoped_refptr<MetricEntity>& metrics, tablet::TabletOptions* options) {
+  memstore_limit_flushes_ = METRIC_memstore_limit_flushes.Instantiate(metrics);
+  if (!options->block_cache) {
+    return;
+  }
+  block_cache_ = options->block_cache;
+  configured_sizes_ = MemoryArbiterSizes {
+    .block_cache = block_cache_->GetCapacity(),
+    .memstore = memory_monitor_->limit(),
+  };
+  block_cache_hits_ = METRIC_block_cache_hits.Instantiate(metrics);
+  block_cache_misses_ = METRIC_block_cache_misses.Instantiate(metrics);
+  block_cache_capacity_ = METRIC_memory_arbiter_block_cache_capacity.Instantiate(
+      metrics, configured_sizes_.block_cache);
+  memstore_limit_ = METRIC_memory_arbiter_memstore_limit.Instantiate(
+      metrics, configured_sizes_.memstore);
+  arbiter_task_ = std::make_unique<BackgroundTask>(
+      std::function<void()>([this]() { RebalanceMemory(); }),
+      "tablet manager",
+      "memory arbiter bgtask",
+      std::chrono::milliseconds(FLAGS_memory_arbiter_interval_ms));
+}
+
+void TabletMemoryManager::RebalanceMemory() {
+  if (!block_cache_) {
+    return;
+  }
+  const auto hits = block_cache_hits_->value();
+  const auto misses = block_cache_misses_->value();
+  const auto limit_flushes = memstore_limit_flushes_->value();
+  const MemoryArbiterStats stats {
+    .block_cache_usage = block_cache_->GetUsage(),
+    .block_cache_hits = hits - std::exchange(last_block_cache_hits_, hits),
+    .block_cache_misses = misses - std::exchange(last_block_cache_misses_, misses),
+    .memstore_limit_flushes =
+        limit_flushes - std::exchange(last_memstore_limit_flushes_, limit_flushes),
+  };
+  const MemoryArbiterSizes current {
+    .block_cache = block_cache_->GetCapacity(),
+    .memstore = memory_monitor_->limit(),
+  };
+  const auto sizes = RebalanceMemoryArbiterSizes(configured_sizes_, current, stats);
+  if (sizes == current) {
+    return;
+  }
+  LOG(INFO) << "Memory arbiter: " << current.ToString() << " => " << sizes.ToString();
+  // Shrink first, so the total does not exceed the budget during the change. The BlockBasedTable
+  // MemTracker limit follows the block cache capacity, so its GC keeps the cache within budget.
+  auto set_block_cache_size = [this, &sizes] {
+    block_cache_->SetCapacity(sizes.block_cache);
+    block_based_table_mem_tracker_->SetLimit(static_cast<int64_t>(sizes.block_cache));
+  };
+  if (sizes.block_cache < current.block_cache) {
+    set_block_cache_size();
+    memory_monitor_->SetLimit(sizes.memstore);
+  } else {
+    memory_monitor_->SetLimit(sizes.memstore);
+    set_block_cache_size();
+  }
+  block_cache_capacity_->set_value(sizes.block_cache);
+  memstore_limit_->set_value(sizes.memstore);
+}
+
+std::string MemoryArbiterSizes::ToString() const {
+  return Format(
+      "{ block_cache: $0 memstore: $1 }", HumanReadableNumBytes::ToString(block_cache),
+      HumanReadableNumBytes::ToString(memstore));
+}
+
+MemoryArbiterSizes RebalanceMemoryArbiterSizes(
+    const MemoryArbiterSizes& configured, const MemoryArbiterSizes& current,
+    const MemoryArbiterStats& stats) {
+  if (!GetAtomicFlag(&FLAGS_enable_memory_arbiter)) {
+    return configured;
+  }
+  const auto total = configured.block_cache + configured.memstore;
+  const auto step = total * FLAGS_memory_arbiter_step_percentage / 100;
+  const auto min_share = std::min<uint32_t>(FLAGS_memory_arbiter_min_share_percentage, 100);
+  const auto min_block_cache_size = configured.block_cache * min_share / 100;
+  const auto min_memstore_size = configured.memstore * min_share / 100;
+
+  const auto lookups = static_cast<uint64_t>(stats.block_cache_hits + stats.block_cache_misses);
+  // A block cache that is not full would not benefit from more memory.
+  const auto block_cache_full = stats.block_cache_usage >= current.block_cache * 9 / 10;
+  const auto block_cache_pressure =
+      block_cache_full && lookups >= FLAGS_memory_arbiter_min_block_cache_lookups &&
+      stats.block_cache_misses > lookups * FLAGS_memory_arbiter_block_cache_miss_ratio_threshold;
+  const auto memstore_pressure = stats.memstore_limit_flushes > 0;
+  VLOG(2) << "Memory arbiter round, block cache lookups: " << lookups
+          << ", misses: " << stats.block_cache_misses << ", full: " << block_cache_full
+          << ", memstore limit flushes: " << stats.memstore_limit_flushes;
+
+  auto result = current;
+  if (memstore_pressure && !block_cache_pressure && result.block_cache > min_block_cache_size) {
+    const auto delta = std::min(step, result.block_cache - min_block_cache_size);
+    result.block_cache -= delta;
+    result.memstore += delta;
+  } else if (block_cache_pressure && !memstore_pressure && result.memstore > min_memstore_size) {
+    const auto delta = std::min(step, result.memstore - min_memstore_size);
+    result.memstore -= delta;
+    result.block_cache += delta;
+  }
+  return result;
+}
+
 void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict) {
   if (!FLAGS_enable_log_cache_gc) {
     return;
@@ -304,6 +461,7 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
             tablet_to_flush->Flush(
                 tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs, flush_tick),
             Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
+        IncrementCounter(memstore_limit_flushes_);
         for (auto listener : TEST_listeners) {
           listener->StartedFlush(peer_to_flush->tablet_id());
         }
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <boost/optional.hpp>
 
@@ -21,6 +22,7 @@
 
 #include "yb/util/background_task.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics_fwd.h"
 
 namespace yb {
 namespace tserver {
@@ -31,10 +33,37 @@ class TabletMemoryManagerListenerIf {
   virtual void StartedFlush(const TabletId& tablet_id) {}
 };
 
+// Block cache capacity and global memstore limit distributed by the memory arbiter.
+struct MemoryArbiterSizes {
+  size_t block_cache = 0;
+  size_t memstore = 0;
+
+  bool operator==(const MemoryArbiterSizes& rhs) const {
+    return block_cache == rhs.block_cache && memstore == rhs.memstore;
+  }
+
+  std::string ToString() const;
+};
+
+// Activity observed by the memory arbiter since its previous round.
+struct MemoryArbiterStats {
+  size_t block_cache_usage = 0;
+  int64_t block_cache_hits = 0;
+  int64_t block_cache_misses = 0;
+  int64_t memstore_limit_flushes = 0;
+};
+
+// Returns sizes for the next memory arbiter round. Memory is moved towards the consumer that is
+// under pressure, and the configured sizes are returned when the arbiter is disabled.
+MemoryArbiterSizes RebalanceMemoryArbiterSizes(
+    const MemoryArbiterSizes& configured, const MemoryArbiterSizes& current,
+    const MemoryArbiterStats& stats);
+
 // TabletMemoryManager keeps track of memory management for a tablet, including:
 // - Block cache initialization and tracking
 // - Log cache garbage collection
 // - Memory flushing once the global memstore limit is reached
+// - Rebalancing memory between the block cache and the global memstore (memory arbiter)
 class TabletMemoryManager {
  public:
   // 'default_block_cache_size_percentage' indicates what percentage of tablet memory will be
@@ -61,6 +90,11 @@ class TabletMemoryManager {
   // Flushing function for the memstore.
   void FlushTabletIfLimitExceeded();
 
+  // Moves memory between the block cache and the global memstore, based on the block cache miss
+  // ratio and the number of flushes forced by the global memstore limit since the previous call.
+  // The sum of block cache capacity and memstore limit is kept unchanged.
+  void RebalanceMemory();
+
   std::vector<std::shared_ptr<TabletMemoryManagerListenerIf>> TEST_listeners;
 
  private:
@@ -79,6 +113,9 @@ class TabletMemoryManager {
   // shared memstore limit.
   void ConfigureBackgroundTask(tablet::TabletOptions* options);
 
+  // Initializes the background task that periodically calls RebalanceMemory.
+  void InitMemoryArbiter(const scoped_refptr<MetricEntity>& metrics, tablet::TabletOptions* options);
+
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
@@ -103,6 +140,19 @@ class TabletMemoryManager {
   std::unique_ptr<BackgroundTask> background_task_;
 
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor_;
+
+  // Memory arbiter state.
+  std::shared_ptr<rocksdb::Cache> block_cache_;
+  MemoryArbiterSizes configured_sizes_;
+  int64_t last_block_cache_hits_ = 0;
+  int64_t last_block_cache_misses_ = 0;
+  int64_t last_memstore_limit_flushes_ = 0;
+  std::unique_ptr<BackgroundTask> arbiter_task_;
+  scoped_refptr<Counter> block_cache_hits_;
+  scoped_refptr<Counter> block_cache_misses_;
+  scoped_refptr<Counter> memstore_limit_flushes_;
+  scoped_refptr<AtomicGauge<uint64_t>> block_cache_capacity_;
+  scoped_refptr<AtomicGauge<uint64_t>> memstore_limit_;
 };
 
 }  // namespace tserver
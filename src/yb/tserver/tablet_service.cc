@@ -172,6 +172,9 @@ DEFINE_test_flag(double, respond_write_failed_probability, 0.0,
 
 DEFINE_test_flag(bool, rpc_delete_tablet_fail, false, "Should delete tablet RPC fail.");
 
+DEFINE_test_flag(bool, fail_multi_raft_request_consensus_vote, false,
+                 "Fail MultiRaftRequestConsensusVote RPCs as a whole.");
+
 DECLARE_bool(disable_alter_vs_write_mutual_exclusion);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_min_running_check_interval_ms);
@@ -2178,6 +2181,48 @@ void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftRequestConsensusVote(
+    const consensus::MultiRaftVoteRequestPB* req,
+    consensus::MultiRaftVoteResponsePB* resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batch Consensus Request Vote RPC: " << req->ShortDebugString();
+  if (PREDICT_FALSE(FLAGS_TEST_fail_multi_raft_request_consensus_vote)) {
+    context.RespondFailure(STATUS(ServiceUnavailable, "Injected batched vote failure"));
+    return;
+  }
+  // Effectively performs ConsensusServiceImpl::RequestConsensusVote for each VoteRequestPB in the
+  // batch but does not fail the entire batch if a single request fails.
+  for (const auto& vote_req : req->vote_request()) {
+    auto* vote_resp = resp->add_vote_response();
+
+    auto uuid_match_res = CheckUuidMatch(tablet_manager_, "RequestConsensusVote", &vote_req,
+                                         context.requestor_string());
+    if (!uuid_match_res.ok()) {
+      SetupError(vote_resp->mutable_error(), uuid_match_res.status());
+      continue;
+    }
+
+    auto peer_tablet_res = LookupTabletPeer(tablet_manager_, vote_req.tablet_id());
+    if (!peer_tablet_res.ok()) {
+      SetupError(vote_resp->mutable_error(), peer_tablet_res.status());
+      continue;
+    }
+
+    auto consensus_res = GetConsensus(peer_tablet_res->tablet_peer);
+    if (!consensus_res.ok()) {
+      SetupError(vote_resp->mutable_error(), consensus_res.status());
+      continue;
+    }
+
+    Status s = (**consensus_res).RequestVote(&vote_req, vote_resp);
+    if (PREDICT_FALSE(!s.ok())) {
+      vote_resp->Clear();
+      SetupError(vote_resp->mutable_error(), s);
+    }
+  }
+  context.RespondSuccess();
+}
+
 void ConsensusServiceImpl::ChangeConfig(const ChangeConfigRequestPB* req,
                                         ChangeConfigResponsePB* resp,
                                         RpcContext context) {
@@ -319,6 +319,10 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
                             consensus::VoteResponsePB* resp,
                             rpc::RpcContext context) override;
 
+  void MultiRaftRequestConsensusVote(const consensus::MultiRaftVoteRequestPB* req,
+                                     consensus::MultiRaftVoteResponsePB* resp,
+                                     rpc::RpcContext context) override;
+
   void ChangeConfig(const consensus::ChangeConfigRequestPB* req,
                     consensus::ChangeConfigResponsePB* resp,
                     rpc::RpcContext context) override;
@@ -61,6 +61,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 
+#include "yb/tserver/compaction_io_controller.h"
 #include "yb/tserver/full_compaction_manager.h"
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_memory_manager.h"
@@ -68,6 +69,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
 #include "yb/util/test_util.h"
 
 using std::string;
@@ -82,6 +84,11 @@ DECLARE_bool(TEST_pretend_memory_exceeded_enforce_flush);
 DECLARE_bool(TEST_tserver_disable_heartbeat);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
+DECLARE_bool(enable_adaptive_compaction_rate_limit);
+DECLARE_uint32(adaptive_compaction_rate_limit_interval_ms);
+DECLARE_uint32(adaptive_compaction_min_rate_percentage);
+DECLARE_uint64(adaptive_compaction_read_latency_p99_target_us);
+DECLARE_uint64(adaptive_compaction_min_read_samples);
 DECLARE_bool(disable_auto_flags_management);
 DECLARE_int32(scheduled_full_compaction_frequency_hours);
 DECLARE_int32(scheduled_full_compaction_jitter_factor_percentage);
@@ -697,6 +704,52 @@ TEST_F(TsTabletManagerTest, RateLimiterSharing) {
   peers_num = peers.size();
 }
 
+TEST_F(TsTabletManagerTest, AdaptiveCompactionRateLimit) {
+  constexpr int64_t kBPS = 100_MB;
+  constexpr uint64_t kLatencyTargetUs = 1000;
+  constexpr int kMaxRounds = 20;
+  SetRateLimiterSharingMode(RateLimiterSharingMode::TSERVER);
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec) = kBPS;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_adaptive_compaction_rate_limit) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_adaptive_compaction_rate_limit_interval_ms) = 3600 * 1000;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_adaptive_compaction_read_latency_p99_target_us) =
+      kLatencyTargetUs;
+  ASSERT_NO_FATAL_FAILURE(Reload());
+
+  auto* controller = tablet_manager_->compaction_io_controller();
+  ASSERT_NE(controller, nullptr);
+  // Stop the background task, so rounds are only run by the test and don't race with it.
+  controller->Shutdown();
+  ASSERT_EQ(controller->budget(), kBPS);
+  auto& histogram = *controller->read_latency_histogram();
+  auto add_reads = [&histogram](size_t num_reads, uint64_t latency_us) {
+    for (size_t i = 0; i != num_reads; ++i) {
+      histogram.Increment(latency_us);
+    }
+  };
+
+  // Slow reads lower the budget down to its min.
+  const int64_t min_budget = kBPS * FLAGS_adaptive_compaction_min_rate_percentage / 100;
+  for (int i = 0; i != kMaxRounds; ++i) {
+    add_reads(FLAGS_adaptive_compaction_min_read_samples, kLatencyTargetUs * 10);
+    controller->AdjustBudget();
+    ASSERT_LT(controller->budget(), kBPS);
+  }
+  ASSERT_EQ(controller->budget(), min_budget);
+
+  // Too few slow reads are ignored.
+  add_reads(FLAGS_adaptive_compaction_min_read_samples - 1, kLatencyTargetUs * 10);
+  controller->AdjustBudget();
+  ASSERT_GT(controller->budget(), min_budget);
+
+  // Fast reads let the budget grow back to the configured limit.
+  for (int i = 0; i != kMaxRounds; ++i) {
+    add_reads(FLAGS_adaptive_compaction_min_read_samples, kLatencyTargetUs / 10);
+    controller->AdjustBudget();
+  }
+  ASSERT_EQ(controller->budget(), kBPS);
+}
+
 TEST_F(TsTabletManagerTest, DataAndWalFilesLocations) {
   std::string wal;
   std::string data;
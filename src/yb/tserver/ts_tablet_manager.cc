@@ -87,7 +87,9 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/tablet/transaction_status_batcher.h"
 
+#include "yb/tserver/compaction_io_controller.h"
 #include "yb/tserver/full_compaction_manager.h"
 #include "yb/tserver/heartbeater.h"
 #include "yb/tserver/remote_bootstrap_client.h"
@@ -493,6 +495,15 @@ Status TSTabletManager::Init() {
   if (docdb::GetRocksDBRateLimiterSharingMode() == docdb::RateLimiterSharingMode::TSERVER) {
     tablet_options_.rate_limiter = docdb::CreateRocksDBRateLimiter();
   }
+  if (tablet_options_.rate_limiter && CompactionIoController::IsEnabled()) {
+    compaction_io_controller_ = std::make_unique<CompactionIoController>(
+        tablet_options_.rate_limiter, server_->metric_entity(),
+        [this]() { return GetTabletPeers(); });
+    tablet_options_.read_latency_histogram = compaction_io_controller_->read_latency_histogram();
+  }
+  tablet_options_.transaction_status_batcher = std::make_shared<tablet::TransactionStatusBatcher>(
+      server_->client_future(), scoped_refptr<server::Clock>(server_->clock()),
+      server_->metric_entity().get());
 
   // Start the threadpool we'll use to open tablets.
   // This has to be done in Init() instead of the constructor, since the
@@ -606,6 +617,9 @@ Status TSTabletManager::Init() {
   }
 
   RETURN_NOT_OK(mem_manager_->Init());
+  if (compaction_io_controller_) {
+    RETURN_NOT_OK(compaction_io_controller_->Init());
+  }
 
   tablets_cleaner_ = std::make_unique<rpc::Poller>(
       LogPrefix(), std::bind(&TSTabletManager::CleanupSplitTablets, this));
@@ -1732,6 +1746,10 @@ void TSTabletManager::StartShutdown() {
 
   mem_manager_->Shutdown();
 
+  if (compaction_io_controller_) {
+    compaction_io_controller_->Shutdown();
+  }
+
   // Wait for all RBS operations to finish.
   const MonoDelta kSingleWait = 10ms;
   const MonoDelta kReportInterval = 5s;
@@ -1789,6 +1807,10 @@ void TSTabletManager::CompleteShutdown() {
     peer->CompleteShutdown(tablet::DisableFlushOnShutdown::kFalse);
   }
 
+  if (tablet_options_.transaction_status_batcher) {
+    tablet_options_.transaction_status_batcher->Shutdown();
+  }
+
   // Shut down the apply pool.
   apply_pool_->Shutdown();
 
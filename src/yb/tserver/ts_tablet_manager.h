@@ -96,6 +96,7 @@ class RaftConfigPB;
 
 namespace tserver {
 class TabletServer;
+class CompactionIoController;
 class FullCompactionManager;
 
 using rocksdb::MemoryMonitor;
@@ -352,6 +353,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   FullCompactionManager* full_compaction_manager() { return full_compaction_manager_.get(); }
 
+  // Null unless the compaction I/O budget is adjusted adaptively.
+  CompactionIoController* compaction_io_controller() { return compaction_io_controller_.get(); }
+
   Status UpdateSnapshotsInfo(const master::TSSnapshotsInfoPB& info);
 
   // Background task that verifies the data on each tablet for consistency.
@@ -679,6 +683,8 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unique_ptr<FullCompactionManager> full_compaction_manager_;
 
+  std::unique_ptr<CompactionIoController> compaction_io_controller_;
+
   std::shared_mutex service_registration_mutex_;
   std::unordered_map<StatefulServiceKind, ConsensusChangeCallback> service_consensus_change_cb_;
 
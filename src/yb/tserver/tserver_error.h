@@ -65,5 +65,18 @@ struct TabletServerDelayTag : IntegralBackedErrorTag<MonoDeltaTraits> {
 
 typedef StatusErrorCodeImpl<TabletServerDelayTag> TabletServerDelay;
 
+// UUID of the tablet leader known to the tablet server that rejected a request because it is not
+// the leader.
+struct TabletServerLeaderHintTag : StringBackedErrorTag {
+  // This category id is part of the wire protocol and should not be changed once released.
+  static constexpr uint8_t kCategory = 24;
+
+  static std::string ToMessage(const Value& value) {
+    return "Leader: " + value;
+  }
+};
+
+typedef StatusErrorCodeImpl<TabletServerLeaderHintTag> TabletServerLeaderHint;
+
 } // namespace tserver
 } // namespace yb
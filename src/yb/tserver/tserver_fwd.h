@@ -38,6 +38,7 @@ class MetricsSnapshotter;
 class PgTableCache;
 class PgResponseCache;
 class PgSequenceCache;
+class PgWriteCoalescer;
 class TSTabletManager;
 class TableMutationCountSender;
 class TabletPeerLookupIf;
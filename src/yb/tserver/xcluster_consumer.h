@@ -103,6 +103,14 @@ class XClusterConsumer {
     return TEST_num_successful_write_rpcs.load(std::memory_order_acquire);
   }
 
+  void IncrementNumAbortedWriteRpcs(uint32_t count) {
+    TEST_num_aborted_write_rpcs += count;
+  }
+
+  uint32_t GetNumAbortedWriteRpcs() {
+    return TEST_num_aborted_write_rpcs.load(std::memory_order_acquire);
+  }
+
   Status ReloadCertificates();
 
   Status PublishXClusterSafeTime();
@@ -224,6 +232,7 @@ class XClusterConsumer {
   std::atomic<int32_t> last_polled_at_cluster_config_version_  = {-1};
 
   std::atomic<uint32_t> TEST_num_successful_write_rpcs {0};
+  std::atomic<uint32_t> TEST_num_aborted_write_rpcs {0};
 
   std::mutex safe_time_update_mutex_;
   MonoTime last_safe_time_published_at_ GUARDED_BY(safe_time_update_mutex_);
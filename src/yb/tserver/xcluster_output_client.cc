@@ -12,6 +12,7 @@
 
 #include "yb/tserver/xcluster_output_client.h"
 
+#include <algorithm>
 #include <shared_mutex>
 
 #include "yb/cdc/cdc_util.h"
@@ -30,6 +31,7 @@
 #include "yb/dockv/doc_key.h"
 #include "yb/docdb/docdb.h"
 
+#include "yb/gutil/casts.h"
 #include "yb/gutil/strings/join.h"
 
 #include "yb/master/master_replication.pb.h"
@@ -51,6 +53,11 @@ DECLARE_int32(cdc_write_rpc_timeout_ms);
 DEFINE_RUNTIME_bool(cdc_force_remote_tserver, false,
     "Avoid local tserver apply optimization for CDC and force remote RPCs.");
 
+DEFINE_RUNTIME_uint32(xcluster_max_parallel_write_rpcs, 8,
+    "Max number of write RPCs an xCluster output client sends to target tablets in parallel "
+    "while applying a batch of changes. Each target tablet gets a single write per batch, so "
+    "writes to different tablets do not depend on each other.");
+
 DEFINE_RUNTIME_bool(xcluster_enable_packed_rows_support, true,
     "Enables rewriting of packed rows with xcluster consumer schema version");
 TAG_FLAG(xcluster_enable_packed_rows_support, advanced);
@@ -62,6 +69,10 @@ DEFINE_test_flag(bool, xcluster_consumer_fail_after_process_split_op, false,
 
 DEFINE_test_flag(bool, xcluster_disable_replication_transaction_status_table, false,
                  "Whether or not to disable replication of txn status table.");
+
+DEFINE_test_flag(string, xcluster_fail_write_to_tablet, "",
+                 "If set, xCluster writes to the consumer tablet with this id fail without being "
+                 "sent.");
 using namespace std::placeholders;
 
 namespace yb {
@@ -111,14 +122,19 @@ class XClusterOutputClient : public XClusterOutputClientIf {
     DCHECK(!shutdown_);
     shutdown_ = true;
 
-    rpc::RpcCommandPtr rpc_to_abort;
+    std::vector<rpc::RpcCommandPtr> rpcs_to_abort;
     {
       std::lock_guard<decltype(lock_)> l(lock_);
       if (write_handle_ != rpcs_->InvalidHandle()) {
-        rpc_to_abort = *write_handle_;
+        rpcs_to_abort.push_back(*write_handle_);
       }
+      for (const auto& handle : write_handles_) {
+        rpcs_to_abort.push_back(*handle);
+      }
+      xcluster_consumer_->IncrementNumAbortedWriteRpcs(
+          narrow_cast<uint32_t>(write_handles_.size()));
     }
-    if (rpc_to_abort) {
+    for (const auto& rpc_to_abort : rpcs_to_abort) {
       rpc_to_abort->Abort();
     }
   }
@@ -188,7 +204,8 @@ class XClusterOutputClient : public XClusterOutputClientIf {
   void SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request);
   void UpdateSchemaVersionMapping(tserver::GetCompatibleSchemaVersionRequestPB* req);
 
-  void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
+  void WriteCDCRecordDone(
+      rpc::Rpcs::Handle handle, const Status& status, const WriteResponsePB& response);
   void DoWriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
 
   void SchemaVersionCheckDone(
@@ -222,6 +239,8 @@ class XClusterOutputClient : public XClusterOutputClientIf {
   ThreadPool* thread_pool_;  // Use threadpool so that callbacks aren't run on reactor threads.
   rpc::Rpcs* rpcs_;
   rpc::Rpcs::Handle write_handle_ GUARDED_BY(lock_);
+  // Handles of user table write RPCs in flight.
+  std::vector<rpc::Rpcs::Handle> write_handles_ GUARDED_BY(lock_);
   // Retain COMMIT rpcs in-flight as these need to be cleaned up on shutdown
   std::vector<std::shared_ptr<client::ExternalTransaction>> external_transactions_;
   std::function<void(const XClusterOutputClientResponse& response)> apply_changes_clbk_;
@@ -241,6 +260,11 @@ class XClusterOutputClient : public XClusterOutputClientIf {
   uint32_t processed_record_count_ GUARDED_BY(lock_) = 0;
   uint32_t record_count_ GUARDED_BY(lock_) = 0;
 
+  // Number of user table writes that were sent but not completed yet.
+  size_t pending_writes_ GUARDED_BY(lock_) = 0;
+  // First error of the user table writes of the current round.
+  Status write_status_ GUARDED_BY(lock_);
+
   SchemaVersion last_compatible_consumer_schema_version_ GUARDED_BY(lock_) = 0;
   SchemaVersion producer_schema_version_ GUARDED_BY(lock_) = 0;
   ColocationId colocation_id_  GUARDED_BY(lock_) = 0;
@@ -329,6 +353,8 @@ Status XClusterOutputClient::ApplyChanges(const cdc::GetChangesResponsePB* polle
     wait_for_version_ = 0;
     processed_record_count_ = 0;
     record_count_ = poller_resp->records_size();
+    pending_writes_ = 0;
+    write_status_ = Status::OK();
     ResetWriteInterface(&write_strategy_);
   }
 
@@ -515,17 +541,30 @@ Status XClusterOutputClient::SendTransactionUpdates() {
 }
 
 Status XClusterOutputClient::SendUserTableWrites() {
-  // Send out the buffered writes.
-  std::unique_ptr<WriteRequestPB> write_request;
+  // Send out the buffered writes. There is at most one write per target tablet, so up to
+  // xcluster_max_parallel_write_rpcs of them are sent at once. The rest are sent as the previous
+  // ones complete, see DoWriteCDCRecordDone.
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->FetchNextRequest();
+    const auto max_parallel_writes =
+        std::max<uint32_t>(GetAtomicFlag(&FLAGS_xcluster_max_parallel_write_rpcs), 1);
+    while (write_requests.size() < max_parallel_writes) {
+      auto write_request = write_strategy_->FetchNextRequest();
+      if (!write_request) {
+        break;
+      }
+      write_requests.push_back(std::move(write_request));
+    }
+    pending_writes_ += write_requests.size();
   }
-  if (!write_request) {
+  if (write_requests.empty()) {
     LOG(WARNING) << "Expected to find a write_request but were unable to";
     return STATUS(IllegalState, "Could not find a write request to send");
   }
-  SendNextCDCWriteToTablet(std::move(write_request));
+  for (auto& write_request : write_requests) {
+    SendNextCDCWriteToTablet(std::move(write_request));
+  }
   return Status::OK();
 }
 
@@ -772,23 +811,34 @@ Result<bool> XClusterOutputClient::ProcessMetaOp(const cdc::CDCRecordPB& record)
 }
 
 void XClusterOutputClient::SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request) {
-  // TODO: This should be parallelized for better performance with M:N setups.
+  if (PREDICT_FALSE(!FLAGS_TEST_xcluster_fail_write_to_tablet.empty()) &&
+      write_request->tablet_id() == FLAGS_TEST_xcluster_fail_write_to_tablet) {
+    WARN_NOT_OK(
+        thread_pool_->SubmitFunc(std::bind(
+            &XClusterOutputClient::DoWriteCDCRecordDone, SharedFromThis(),
+            STATUS(InternalError, "Fail due to FLAGS_TEST_xcluster_fail_write_to_tablet"),
+            WriteResponsePB())),
+        "Could not submit DoWriteCDCRecordDone to thread pool");
+    return;
+  }
+
   auto deadline =
       CoarseMonoClock::Now() + MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
 
   std::lock_guard<decltype(lock_)> l(lock_);
-  write_handle_ = rpcs_->Prepare();
-  if (write_handle_ != rpcs_->InvalidHandle()) {
+  auto handle = rpcs_->Prepare();
+  if (handle != rpcs_->InvalidHandle()) {
+    write_handles_.push_back(handle);
     // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write request.
-    *write_handle_ = cdc::CreateCDCWriteRpc(
+    *handle = cdc::CreateCDCWriteRpc(
         deadline,
         nullptr /* RemoteTablet */,
         table_,
         local_client_->client.get(),
         write_request.get(),
-        std::bind(&XClusterOutputClient::WriteCDCRecordDone, SharedFromThis(), _1, _2),
+        std::bind(&XClusterOutputClient::WriteCDCRecordDone, SharedFromThis(), handle, _1, _2),
         UseLocalTserver());
-    (**write_handle_).SendRpc();
+    (**handle).SendRpc();
   } else {
     LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
   }
@@ -930,11 +980,16 @@ void XClusterOutputClient::DoSchemaVersionCheckDone(
 }
 
 void XClusterOutputClient::WriteCDCRecordDone(
-    const Status& status, const WriteResponsePB& response) {
+    rpc::Rpcs::Handle handle, const Status& status, const WriteResponsePB& response) {
   rpc::RpcCommandPtr retained;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    retained = rpcs_->Unregister(&write_handle_);
+    auto it = std::find(write_handles_.begin(), write_handles_.end(), handle);
+    DCHECK(it != write_handles_.end());
+    if (it != write_handles_.end()) {
+      write_handles_.erase(it);
+    }
+    retained = rpcs_->Unregister(&handle);
   }
   RETURN_WHEN_OFFLINE();
 
@@ -949,24 +1004,41 @@ void XClusterOutputClient::DoWriteCDCRecordDone(
     const Status& status, const WriteResponsePB& response) {
   RETURN_WHEN_OFFLINE();
 
-  if (!status.ok()) {
-    HandleError(status);
-    return;
-  } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()));
-    return;
+  auto write_status = status;
+  if (write_status.ok() && response.has_error()) {
+    write_status = StatusFromPB(response.error().status());
+  }
+  if (write_status.ok()) {
+    xcluster_consumer_->IncrementNumSuccessfulWriteRpcs();
   }
-  xcluster_consumer_->IncrementNumSuccessfulWriteRpcs();
 
-  // See if we need to handle any more writes.
+  // See if we need to handle any more writes. Once a write failed no new writes are sent, and the
+  // error is reported after the writes in flight complete.
   std::unique_ptr<WriteRequestPB> write_request;
+  bool last_pending_write;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->FetchNextRequest();
+    --pending_writes_;
+    if (!write_status.ok() && write_status_.ok()) {
+      write_status_ = write_status;
+    }
+    if (write_status_.ok()) {
+      write_request = write_strategy_->FetchNextRequest();
+      if (write_request) {
+        ++pending_writes_;
+      }
+    }
+    last_pending_write = pending_writes_ == 0;
+    write_status = write_status_;
   }
 
   if (write_request) {
     SendNextCDCWriteToTablet(std::move(write_request));
+  } else if (!last_pending_write) {
+    // Other writes of this round are still in flight, the last of them continues processing.
+    return;
+  } else if (!write_status.ok()) {
+    HandleError(write_status);
   } else {
     // We may still have more records to process (in case of ddls/master requests).
     int next_record = 0;
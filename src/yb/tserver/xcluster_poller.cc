@@ -43,6 +43,13 @@ DEFINE_RUNTIME_int32(async_replication_max_idle_wait, 3,
     "Maximum number of consecutive empty GetChanges until the poller "
     "backs off to the idle interval, rather than immediately retrying.");
 
+DEFINE_RUNTIME_int32(async_replication_long_poll_wait_ms, 0,
+    "If positive, the producer is asked to hold GetChanges up to this long until new changes are "
+    "committed, and the poller does not back off to async_replication_idle_delay_ms when idle. "
+    "New changes are then shipped as soon as they are committed. Safe time of idle tablets is "
+    "updated once per wait, so the value should be comparable to "
+    "async_replication_idle_delay_ms.");
+
 DEFINE_RUNTIME_int32(replication_failure_delay_exponent, 16 /* ~ 2^16/1000 ~= 65 sec */,
     "Max number of failures (N) to use when calculating exponential backoff (2^N-1).");
 
@@ -257,7 +264,9 @@ void XClusterPoller::DoPoll() {
 
   // determine if we should delay our upcoming poll
   int64_t delay = GetAtomicFlag(&FLAGS_async_replication_polling_delay_ms);  // normal throttling.
-  if (idle_polls_ >= GetAtomicFlag(&FLAGS_async_replication_max_idle_wait)) {
+  const auto long_poll_wait_ms = GetAtomicFlag(&FLAGS_async_replication_long_poll_wait_ms);
+  if (long_poll_wait_ms <= 0 &&
+      idle_polls_ >= GetAtomicFlag(&FLAGS_async_replication_max_idle_wait)) {
     delay = std::max(
         delay, (int64_t)GetAtomicFlag(&FLAGS_async_replication_idle_delay_ms));  // idle backoff.
   }
@@ -295,6 +304,9 @@ void XClusterPoller::DoPoll() {
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
   req.set_serve_as_proxy(GetAtomicFlag(&FLAGS_cdc_consumer_use_proxy_forwarding));
+  if (long_poll_wait_ms > 0) {
+    req.set_wait_for_changes_ms(long_poll_wait_ms);
+  }
 
   cdc::CDCCheckpointPB checkpoint;
   *checkpoint.mutable_op_id() = op_id_;
@@ -34,6 +34,7 @@
 #include <fcntl.h>
 
 #include <algorithm>
+#include <atomic>
 
 #include <glog/logging.h>
 
@@ -98,9 +99,16 @@ class CowObject {
     std::swap(state_, *dirty_state_);
     dirty_state_.reset();
     is_dirty_ = false;
+    version_.fetch_add(1, std::memory_order_acq_rel);
     lock_.CommitUnlock();
   }
 
+  // Number of committed mutations. Allows to check without taking the lock whether data derived
+  // from the state, while the lock was held, is still up to date.
+  uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
   // Return the current state, not reflecting any in-progress mutations.
   State& state() {
     DCHECK(lock_.HasReaders() || lock_.HasWriteLock());
@@ -142,6 +150,8 @@ class CowObject {
   // Set only when mutable_dirty() method is called. Unset whenever dirty_state_ is reset().
   bool is_dirty_ = false;
 
+  std::atomic<uint64_t> version_{0};
+
   DISALLOW_COPY_AND_ASSIGN(CowObject);
 };
 
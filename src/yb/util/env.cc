@@ -308,6 +308,10 @@ Result<uint64_t> EnvWrapper::GetFileINode(const std::string& f) {
   return target_->GetFileINode(f);
 }
 
+Result<uint64_t> EnvWrapper::GetFileDeviceId(const std::string& f) {
+  return target_->GetFileDeviceId(f);
+}
+
 Result<uint64_t> EnvWrapper::GetFileSizeOnDisk(const std::string& f) {
   return target_->GetFileSizeOnDisk(f);
 }
@@ -324,6 +328,10 @@ Status EnvWrapper::LinkFile(const std::string& s, const std::string& t) {
   return target_->LinkFile(s, t);
 }
 
+Status EnvWrapper::CloneFile(const std::string& s, const std::string& t) {
+  return target_->CloneFile(s, t);
+}
+
 Result<std::string> EnvWrapper::ReadLink(const std::string& s) {
   return target_->ReadLink(s);
 }
@@ -301,9 +301,16 @@ class Env {
 
   virtual Result<uint64_t> GetFileINode(const std::string& fname) = 0;
 
+  // Returns the id of the device the file resides on.
+  virtual Result<uint64_t> GetFileDeviceId(const std::string& fname) = 0;
+
   virtual Status LinkFile(const std::string& src,
                                   const std::string& target) = 0;
 
+  // Creates target as a copy-on-write clone (reflink) of src. Returns NotSupported when the file
+  // system or platform can't do it, e.g. when src and target are on different file systems.
+  virtual Status CloneFile(const std::string& src, const std::string& target) = 0;
+
   // Read link's actual target
   virtual Result<std::string> ReadLink(const std::string& link) = 0;
 
@@ -712,10 +719,12 @@ class EnvWrapper : public Env {
   Status DeleteRecursively(const std::string& d) override;
   Result<uint64_t> GetFileSize(const std::string& f) override;
   Result<uint64_t> GetFileINode(const std::string& f) override;
+  Result<uint64_t> GetFileDeviceId(const std::string& f) override;
   Result<uint64_t> GetFileSizeOnDisk(const std::string& f) override;
   Result<uint64_t> GetBlockSize(const std::string& f) override;
   Result<FilesystemStats> GetFilesystemStatsBytes(const std::string& f) override;
   Status LinkFile(const std::string& s, const std::string& t) override;
+  Status CloneFile(const std::string& s, const std::string& t) override;
   Result<std::string> ReadLink(const std::string& s) override;
   Status RenameFile(const std::string& s, const std::string& t) override;
   Status LockFile(const std::string& f, FileLock** l, bool r) override;
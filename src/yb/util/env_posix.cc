@@ -39,6 +39,8 @@
 #include <sys/sysctl.h>
 #else
 #include <linux/falloc.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
 #include <sys/sysinfo.h>
 #endif  // defined(__APPLE__)
 #include <sys/resource.h>
@@ -1125,6 +1127,11 @@ class PosixEnv : public Env {
         fname, "PosixEnv::GetFileINode", [](const struct stat& sbuf) { return sbuf.st_ino; });
   }
 
+  Result<uint64_t> GetFileDeviceId(const std::string& fname) override {
+    return GetFileStat(
+        fname, "PosixEnv::GetFileDeviceId", [](const struct stat& sbuf) { return sbuf.st_dev; });
+  }
+
   Result<uint64_t> GetFileSizeOnDisk(const std::string& fname) override {
     return GetFileStat(
         fname, "PosixEnv::GetFileSizeOnDisk", [](const struct stat& sbuf) {
@@ -1153,6 +1160,39 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status CloneFile(const std::string& src, const std::string& target) override {
+#if defined(FICLONE)
+    int src_fd = open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd < 0) {
+      return STATUS_IO_ERROR(src, errno);
+    }
+    int target_fd = open(target.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (target_fd < 0) {
+      auto status = STATUS_IO_ERROR(target, errno);
+      close(src_fd);
+      return status;
+    }
+    auto clone_result = ioctl(target_fd, FICLONE, src_fd);
+    auto clone_errno = errno;
+    close(src_fd);
+    if (close(target_fd) != 0 && clone_result == 0) {
+      clone_result = -1;
+      clone_errno = errno;
+    }
+    if (clone_result == 0) {
+      return Status::OK();
+    }
+    unlink(target.c_str());
+    if (clone_errno == EXDEV || clone_errno == EOPNOTSUPP || clone_errno == EINVAL ||
+        clone_errno == ENOTTY) {
+      return STATUS_FORMAT(NotSupported, "Reflinks are not supported for $0 => $1", src, target);
+    }
+    return STATUS_IO_ERROR(target, clone_errno);
+#else
+    return STATUS(NotSupported, "Reflinks are not supported on this platform");
+#endif
+  }
+
   Result<std::string> ReadLink(const std::string& link) override {
     char buf[PATH_MAX];
     const auto len = readlink(link.c_str(), buf, sizeof(buf));
@@ -29,4 +29,16 @@ TEST(LRUCacheTest, Simple) {
   ASSERT_EQ(AsString(cache), "[2]");
 }
 
+TEST(LRUCacheTest, EraseIf) {
+  LRUCache<int> cache(4);
+  for (int i = 1; i <= 4; ++i) {
+    cache.insert(i);
+  }
+  ASSERT_EQ(2, cache.EraseIf([](int value) { return value % 2 == 0; }));
+  ASSERT_EQ(AsString(cache), "[3, 1]");
+  ASSERT_EQ(0, cache.EraseIf([](int value) { return value > 3; }));
+  cache.insert(5);
+  ASSERT_EQ(AsString(cache), "[5, 3, 1]");
+}
+
 } // namespace yb
@@ -73,6 +73,21 @@ class LRUCache {
     return erase(key);
   }
 
+  // Erase all entries that satisfy the predicate. Returns number of removed entries.
+  template <class Predicate>
+  size_t EraseIf(const Predicate& predicate) {
+    size_t result = 0;
+    for (auto it = impl_.begin(); it != impl_.end();) {
+      if (predicate(*it)) {
+        it = impl_.erase(it);
+        ++result;
+      } else {
+        ++it;
+      }
+    }
+    return result;
+  }
+
   const_iterator begin() const {
     return impl_.begin();
   }
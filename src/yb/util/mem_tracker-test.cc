@@ -85,6 +85,30 @@ TEST(MemTrackerTest, SingleTrackerWithLimit) {
   t->Release(5);
 }
 
+TEST(MemTrackerTest, SetLimit) {
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(100, "p");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker(-1, "c", p);
+  c->Consume(50);
+  EXPECT_FALSE(p->LimitExceeded());
+  EXPECT_TRUE(c->TryConsume(20));
+
+  // Shrinking below the current consumption makes the limit exceeded, and the new limit is
+  // checked when the child consumes.
+  p->SetLimit(60);
+  EXPECT_EQ(p->limit(), 60);
+  EXPECT_TRUE(p->LimitExceeded());
+  EXPECT_FALSE(c->TryConsume(1));
+  c->Release(20);
+  EXPECT_FALSE(p->LimitExceeded());
+  EXPECT_TRUE(c->TryConsume(10));
+  EXPECT_FALSE(c->TryConsume(1));
+
+  p->SetLimit(200);
+  EXPECT_TRUE(c->TryConsume(100));
+  EXPECT_FALSE(p->LimitExceeded());
+  c->Release(160);
+}
+
 TEST(MemTrackerTest, TrackerHierarchy) {
   shared_ptr<MemTracker> p = MemTracker::CreateTracker(100, "p");
   shared_ptr<MemTracker> c1 = MemTracker::CreateTracker(80, "c1", p);
@@ -284,6 +284,10 @@ void RegisterTCMallocHooks() {
 #endif // defined(YB_GPERFTOOLS_TCMALLOC)
 #endif // YB_TCMALLOC_ENABLED
 
+int64_t SoftLimit(int64_t limit) {
+  return limit == -1 ? -1 : (limit * FLAGS_memory_limit_soft_percentage) / 100;
+}
+
 } // namespace
 
 class MemTracker::TrackerMetrics {
@@ -434,7 +438,7 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
                        ConsumptionFunctor consumption_functor, std::shared_ptr<MemTracker> parent,
                        AddToParent add_to_parent, CreateMetrics create_metrics)
     : limit_(byte_limit),
-      soft_limit_(limit_ == -1 ? -1 : (limit_ * FLAGS_memory_limit_soft_percentage) / 100),
+      soft_limit_(SoftLimit(byte_limit)),
       id_(id),
       consumption_functor_(std::move(consumption_functor)),
       descr_(Substitute("memory consumption for $0", id)),
@@ -631,15 +635,16 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   // won't accommodate the change.
   for (i = all_trackers_.size() - 1; i >= 0; --i) {
     MemTracker *tracker = all_trackers_[i];
-    if (tracker->limit_ < 0) {
+    const auto limit = tracker->limit();
+    if (limit < 0) {
       IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
     } else {
-      if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
+      if (!TryIncrementBy(bytes, limit, &tracker->consumption_, tracker->metrics_)) {
         // One of the trackers failed, attempt to GC memory or expand our limit. If that
         // succeeds, TryUpdate() again. Bail if either fails.
-        if (!tracker->GcMemory(tracker->limit_ - bytes) ||
+        if (!tracker->GcMemory(limit - bytes) ||
             tracker->ExpandLimit(bytes)) {
-          if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
+          if (!TryIncrementBy(bytes, limit, &tracker->consumption_, tracker->metrics_)) {
             break;
           }
         } else {
@@ -720,9 +725,19 @@ bool MemTracker::AnyLimitExceeded() {
   return false;
 }
 
+void MemTracker::SetLimit(int64_t byte_limit) {
+  // Trackers with limits are collected by their descendants on creation, so a tracker could not
+  // get or lose its limit afterwards.
+  CHECK(has_limit() && byte_limit >= 0)
+      << "Only non negative limit could be set for tracker with limit: " << ToString();
+  VLOG(1) << "Changing limit of " << ToString() << " to " << byte_limit;
+  limit_.store(byte_limit, std::memory_order_relaxed);
+  soft_limit_.store(SoftLimit(byte_limit), std::memory_order_relaxed);
+}
+
 bool MemTracker::LimitExceeded() {
   if (PREDICT_FALSE(CheckLimitExceeded())) {
-    return GcMemory(limit_);
+    return GcMemory(limit());
   }
   return false;
 }
@@ -734,13 +749,15 @@ SoftLimitExceededResult MemTracker::SoftLimitExceeded(double* score) {
   }
 
   // No soft limit defined.
-  if (!has_limit() || limit_ == soft_limit_) {
+  const auto limit = this->limit();
+  const auto soft_limit = soft_limit_.load(std::memory_order_relaxed);
+  if (limit < 0 || limit == soft_limit) {
     return SoftLimitExceededResult::NotExceeded();
   }
 
   // Are we under the soft limit threshold?
   int64_t usage = consumption();
-  if (usage < soft_limit_) {
+  if (usage < soft_limit) {
     return SoftLimitExceededResult::NotExceeded();
   }
 
@@ -748,8 +765,8 @@ SoftLimitExceededResult MemTracker::SoftLimitExceeded(double* score) {
   if (*score == 0.0) {
     *score = RandomUniformReal<double>();
   }
-  if (usage + (limit_ - soft_limit_) * *score > limit_ && GcMemory(soft_limit_)) {
-    return {ToString(), true, usage * 100.0 / limit()};
+  if (usage + (limit - soft_limit) * *score > limit && GcMemory(soft_limit)) {
+    return {ToString(), true, usage * 100.0 / limit};
   }
   return SoftLimitExceededResult::NotExceeded();
 }
@@ -881,8 +898,9 @@ string MemTracker::LogUsage(const string& prefix, int64_t usage_threshold, int i
   if (CheckLimitExceeded()) {
     ss << " memory limit exceeded.";
   }
-  if (limit_ > 0) {
-    ss << " Limit=" << HumanReadableNumBytes::ToString(limit_);
+  const auto limit = this->limit();
+  if (limit > 0) {
+    ss << " Limit=" << HumanReadableNumBytes::ToString(limit);
   }
   ss << " Consumption=" << HumanReadableNumBytes::ToString(consumption());
 
@@ -902,15 +920,16 @@ string MemTracker::LogUsage(const string& prefix, int64_t usage_threshold, int i
 
 void MemTracker::LogMemoryLimits() const {
   LOG(INFO) << StringPrintf("MemTracker: hard memory limit is %.6f GB",
-                            (static_cast<float>(limit_) / (1024.0 * 1024.0 * 1024.0)));
+                            (static_cast<float>(limit()) / (1024.0 * 1024.0 * 1024.0)));
   LOG(INFO) << StringPrintf("MemTracker: soft memory limit is %.6f GB",
-                            (static_cast<float>(soft_limit_) / (1024.0 * 1024.0 * 1024.0)));
+                            (static_cast<float>(soft_limit_.load(std::memory_order_relaxed)) /
+                             (1024.0 * 1024.0 * 1024.0)));
 }
 
 void MemTracker::LogUpdate(bool is_consume, int64_t bytes) const {
   stringstream ss;
   ss << this << " " << (is_consume ? "Consume: " : "Release: ") << bytes
-     << " Consumption: " << consumption() << " Limit: " << limit_;
+     << " Consumption: " << consumption() << " Limit: " << limit();
   if (log_stack_) {
     ss << std::endl << GetStackTrace();
   }
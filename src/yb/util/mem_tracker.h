@@ -33,6 +33,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -356,8 +357,13 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   int64_t SpareCapacity() const;
 
 
-  int64_t limit() const { return limit_; }
-  bool has_limit() const { return limit_ >= 0; }
+  int64_t limit() const { return limit_.load(std::memory_order_relaxed); }
+  bool has_limit() const { return limit() >= 0; }
+
+  // Changes the limit of a tracker that has a limit, the soft limit is updated accordingly.
+  // Consumption that already exceeds the new limit is freed by the next limit check.
+  void SetLimit(int64_t byte_limit);
+
   const std::string& id() const { return id_; }
 
   // Returns the memory consumed in bytes.
@@ -418,7 +424,8 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
  private:
   bool CheckLimitExceeded() const {
-    return limit_ >= 0 && limit_ < consumption();
+    const auto limit = this->limit();
+    return limit >= 0 && limit < consumption();
   }
 
   // If consumption is higher than max_consumption, attempts to free memory by calling any
@@ -454,8 +461,8 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Creates the root tracker.
   static void CreateRootTracker();
 
-  const int64_t limit_;
-  const int64_t soft_limit_;
+  std::atomic<int64_t> limit_;
+  std::atomic<int64_t> soft_limit_;
   const std::string id_;
   const ConsumptionFunctor consumption_functor_;
 
@@ -350,6 +350,10 @@ class InMemoryEnv : public EnvWrapper {
     return 0;
   }
 
+  Result<uint64_t> GetFileDeviceId(const std::string& fname) override {
+    return 0;
+  }
+
   Result<uint64_t> GetFileSizeOnDisk(const std::string& fname) override {
     return GetFileSize(fname);
   }
@@ -80,6 +80,22 @@ TEST(RateLimiter, TestUpdateDataSize) {
   ASSERT_LE(diff, max_allowed_rate_diff);
 }
 
+TEST(RateLimiter, TestUpdateDataSizeWithoutSleep) {
+  RateLimiter rate_limiter([]() { return kRate; });
+  rate_limiter.Init();
+  auto start = MonoTime::Now();
+  // Sleep time is returned to the caller, and the next transmission waits for it as well.
+  auto first_sleep_time = rate_limiter.UpdateDataSize(kRate);
+  auto second_sleep_time = rate_limiter.UpdateDataSize(kRate);
+  ASSERT_LE(MonoTime::Now().GetDeltaSince(start).ToMilliseconds(), 100);
+  ASSERT_LE(GetDifference(first_sleep_time.ToMilliseconds(), MonoTime::kMillisecondsPerSecond),
+            100);
+  ASSERT_LE(GetDifference(second_sleep_time.ToMilliseconds(),
+                          2 * MonoTime::kMillisecondsPerSecond),
+            100);
+  ASSERT_EQ(rate_limiter.total_time_slept(), first_sleep_time + second_sleep_time);
+}
+
 TEST(RateLimiter, TestSendRequest) {
   MonoDelta local_sleep_time(3s);
   RateLimiter rate_limiter([]() { return kRate; });
@@ -60,37 +60,45 @@ uint64_t RateLimiter::GetRate() {
 }
 
 void RateLimiter::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  SleepFor(UpdateDataSize(data_size));
+}
+
+MonoDelta RateLimiter::UpdateDataSize(uint64_t data_size) {
   auto now = MonoTime::Now();
   auto elapsed = now.GetDeltaSince(end_time_);
   end_time_ = now;
   total_bytes_ += data_size;
   UpdateRate();
-  UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
+  return UpdateTimeSlotSize(data_size, elapsed);
 }
 
-void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed) {
+MonoDelta RateLimiter::UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed) {
   if (!active()) {
-    return;
+    return MonoDelta::kZero;
   }
 
+  // Elapsed time is negative when the sleep of the previous transmission has not finished yet,
+  // so this transmission should wait for it as well.
+  auto elapsed_ms = elapsed.ToMilliseconds();
+  auto transmission_ms =
+      static_cast<int64_t>(MonoTime::kMillisecondsPerSecond * data_size / target_rate_);
   // If the rate is greater than target_rate_, sleep until both rates are equal.
-  if (MonoTime::kMillisecondsPerSecond * data_size > target_rate_ * elapsed.ToMilliseconds()) {
-    auto sleep_time =
-        MonoTime::kMillisecondsPerSecond * data_size / target_rate_ - elapsed.ToMilliseconds();
+  if (transmission_ms > elapsed_ms) {
+    auto sleep_time = MonoDelta::FromMilliseconds(transmission_ms - elapsed_ms);
     VLOG(1) << " target_rate_=" << target_rate_
-            << " elapsed=" << elapsed.ToMilliseconds()
+            << " elapsed=" << elapsed_ms
             << " received size=" << data_size
             << " and sleeping for=" << sleep_time;
-    SleepFor(MonoDelta::FromMilliseconds(sleep_time));
-    total_time_slept_ += MonoDelta::FromMilliseconds(sleep_time);
-    end_time_ = MonoTime::Now();
+    total_time_slept_ += sleep_time;
+    end_time_ += sleep_time;
     // If we slept for more than 80% of time_slot_ms_, reduce the size of this time slot.
-    if (sleep_time > time_slot_ms_ * 80 / 100) {
+    if (static_cast<uint64_t>(sleep_time.ToMilliseconds()) > time_slot_ms_ * 80 / 100) {
       time_slot_ms_ = std::max(min_time_slot_, time_slot_ms_ / 2);
     }
-  } else {
-    time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+    return sleep_time;
   }
+  time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+  return MonoDelta::kZero;
 }
 
 void RateLimiter::UpdateRate() {
@@ -152,7 +160,7 @@ Status RateLimiter::SendOrReceiveData(std::function<Status()> send_rcv_func,
     auto data_size = reply_size_func();
     total_bytes_ += data_size;
     end_time_ = MonoTime::Now();
-    UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
+    SleepFor(UpdateTimeSlotSize(data_size, elapsed));
   }
   return status;
 }
@@ -60,6 +60,11 @@ class RateLimiter {
   // than the rate provided by target_rate_updater_.
   void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
+  // Same as UpdateDataSizeAndMaybeSleep, but instead of sleeping returns the time the caller should
+  // sleep for. Allows the caller to sleep outside of the lock protecting this object. The sleep
+  // time is accounted immediately, so the next transmission also waits for it.
+  MonoDelta UpdateDataSize(uint64_t data_size);
+
   void Init();
 
   // We can only have an active rate limiter if the user has provided a function to update the rate.
@@ -91,7 +96,7 @@ class RateLimiter {
 
  private:
   void UpdateRate();
-  void UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed);
+  MonoDelta UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed);
   uint64_t GetSizeForNextTimeSlot();
 
   bool init_ = false;
@@ -661,6 +661,7 @@ Result<PerformFuture> PgSession::Perform(BufferableOperations&& ops, PerformOpti
     auto& cache_options = *ops_options.cache_options;
     auto& caching_info = *options.mutable_caching_info();
     caching_info.set_key(std::move(cache_options.key));
+    caching_info.set_catalog_version(cache_options.catalog_version);
     if (cache_options.lifetime_threshold_ms) {
       caching_info.mutable_lifetime_threshold_ms()->set_value(*cache_options.lifetime_threshold_ms);
     }
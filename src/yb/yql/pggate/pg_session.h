@@ -259,6 +259,7 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   struct CacheOptions {
     std::string key;
     std::optional<uint32_t> lifetime_threshold_ms;
+    uint64_t catalog_version = 0;
   };
 
   Result<PerformFuture> RunAsync(const ReadOperationGenerator& generator, CacheOptions&& options);
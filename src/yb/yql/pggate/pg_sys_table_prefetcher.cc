@@ -311,7 +311,8 @@ uint8_t* WritePBWithSize(uint8_t* out, const PB* pb) {
   return {
       .key = BuildCacheKey(
           arena, catalog_read_time, ops, options.latest_known_ysql_catalog_version),
-      .lifetime_threshold_ms = threshold_ms
+      .lifetime_threshold_ms = threshold_ms,
+      .catalog_version = options.latest_known_ysql_catalog_version
   };
 }
 
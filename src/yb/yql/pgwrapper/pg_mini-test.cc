@@ -103,11 +103,16 @@ DECLARE_uint64(max_clock_skew_usec);
 DECLARE_string(time_source);
 
 DECLARE_bool(rocksdb_disable_compactions);
+DECLARE_bool(ysql_coalesce_single_shard_writes);
+DECLARE_uint32(ysql_coalesce_writes_max_in_flight_batches);
 DECLARE_uint64(pg_client_session_expiration_ms);
 DECLARE_uint64(pg_client_heartbeat_interval_ms);
 
 METRIC_DECLARE_entity(tablet);
 METRIC_DECLARE_gauge_uint64(aborted_transactions_pending_cleanup);
+METRIC_DECLARE_counter(pg_write_coalescer_batches);
+METRIC_DECLARE_counter(pg_write_coalescer_requests);
+METRIC_DECLARE_counter(pg_write_coalescer_key_conflicts);
 
 namespace yb {
 namespace pgwrapper {
@@ -895,6 +900,98 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ConcurrentSingleRowUpdate)) {
   ASSERT_EQ(thread_count * increment_per_thread, counter);
 }
 
+class PgMiniCoalescedWritesTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_coalesce_single_shard_writes) = true;
+    // Keep a single batch in flight, so concurrent writes are accumulated into pending batches.
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_coalesce_writes_max_in_flight_batches) = 1;
+    PgMiniTest::SetUp();
+  }
+
+  int64_t SumCounters(const CounterPrototype& prototype) {
+    int64_t result = 0;
+    for (const auto& mini_ts : cluster_->mini_tablet_servers()) {
+      result += prototype.Instantiate(mini_ts->server()->metric_entity())->value();
+    }
+    return result;
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(CoalescedSingleShardWrites),
+          PgMiniCoalescedWritesTest) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t(k INT PRIMARY KEY, v INT)"));
+  const size_t thread_count = 10;
+  const size_t rows_per_thread = 50;
+  const auto batches_before = SumCounters(METRIC_pg_write_coalescer_batches);
+  const auto requests_before = SumCounters(METRIC_pg_write_coalescer_requests);
+  {
+    CountDownLatch latch(thread_count);
+    TestThreadHolder thread_holder;
+    for (size_t i = 0; i < thread_count; ++i) {
+      thread_holder.AddThreadFunctor([this, i, &latch] {
+        auto thread_conn = ASSERT_RESULT(Connect());
+        latch.CountDown();
+        latch.Wait();
+        for (size_t j = 0; j < rows_per_thread; ++j) {
+          const auto key = i * rows_per_thread + j;
+          ASSERT_OK(thread_conn.ExecuteFormat("INSERT INTO t VALUES($0, $1)", key, i));
+          // Duplicate key error should be reported only to the session that caused it.
+          ASSERT_NOK(thread_conn.ExecuteFormat("INSERT INTO t VALUES($0, $1)", key, i));
+        }
+      });
+    }
+  }
+  auto count = ASSERT_RESULT(conn.FetchValue<PGUint64>("SELECT COUNT(*) FROM t"));
+  ASSERT_EQ(count, thread_count * rows_per_thread);
+
+  const auto batches = SumCounters(METRIC_pg_write_coalescer_batches) - batches_before;
+  const auto requests = SumCounters(METRIC_pg_write_coalescer_requests) - requests_before;
+  LOG(INFO) << "Coalesced " << requests << " requests into " << batches << " batches";
+  // Every insert, including the failed ones, goes through the coalescer.
+  ASSERT_GE(requests, static_cast<int64_t>(2 * thread_count * rows_per_thread));
+  ASSERT_GT(batches, 0);
+  ASSERT_LT(batches, requests);
+}
+
+// Writes to the same row from different sessions should never share a batch, otherwise they would
+// not see each other on DocDB side.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(CoalescedSameKeyWrites), PgMiniCoalescedWritesTest) {
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t(k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE counter(k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.Execute("INSERT INTO counter VALUES(1, 0)"));
+  constexpr size_t thread_count = 10;
+  constexpr size_t num_keys = 50;
+  const auto conflicts_before = SumCounters(METRIC_pg_write_coalescer_key_conflicts);
+  std::array<std::atomic<size_t>, num_keys> inserted = {};
+  {
+    CountDownLatch latch(thread_count);
+    TestThreadHolder thread_holder;
+    for (size_t i = 0; i < thread_count; ++i) {
+      thread_holder.AddThreadFunctor([this, &latch, &inserted] {
+        auto thread_conn = ASSERT_RESULT(Connect());
+        latch.CountDown();
+        latch.Wait();
+        for (size_t key = 0; key < num_keys; ++key) {
+          ASSERT_OK(thread_conn.Execute("UPDATE counter SET v = v + 1 WHERE k = 1"));
+          if (thread_conn.ExecuteFormat("INSERT INTO t VALUES($0, 0)", key).ok()) {
+            ++inserted[key];
+          }
+        }
+      });
+    }
+  }
+  // Exactly one session succeeds to insert each key, all others get a duplicate key error.
+  for (size_t key = 0; key < num_keys; ++key) {
+    ASSERT_EQ(inserted[key].load(), 1U) << "Key: " << key;
+  }
+  auto counter = ASSERT_RESULT(conn.FetchValue<int32_t>("SELECT v FROM counter WHERE k = 1"));
+  ASSERT_EQ(counter, static_cast<int32_t>(thread_count * num_keys));
+  ASSERT_GT(SumCounters(METRIC_pg_write_coalescer_key_conflicts), conflicts_before);
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DropDBUpdateSysTablet)) {
   const std::string kDatabaseName = "testdb";
   PGConn conn = ASSERT_RESULT(Connect());